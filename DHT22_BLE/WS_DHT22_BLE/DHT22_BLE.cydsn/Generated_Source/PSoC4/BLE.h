@@ -208,11 +208,11 @@
 #define CYBLE_GATT_MAX_ATTR_BUFF_COUNT       ((1 > 0u) ? (1 - 1u) : 0u)
 
 /* GATT MTU Size */
-#define CYBLE_GATT_MTU                      (0x0017u)
+#define CYBLE_GATT_MTU                      (0x0083u)
 #define CYBLE_GATT_MTU_PLUS_L2CAP_MEM_EXT   (CYBLE_ALIGN_TO_4(CYBLE_GATT_MTU + CYBLE_MEM_EXT_SZ + CYBLE_L2CAP_HDR_SZ))
 
 /* GATT Maximum attribute length */
-#define CYBLE_GATT_MAX_ATTR_LEN             ((0x000Fu == 0u) ? (1u) : (0x000Fu))
+#define CYBLE_GATT_MAX_ATTR_LEN             ((0x0016u == 0u) ? (1u) : (0x0016u))
 #define CYBLE_GATT_MAX_ATTR_LEN_PLUS_L2CAP_MEM_EXT \
                                     (CYBLE_ALIGN_TO_4(CYBLE_GATT_MAX_ATTR_LEN + CYBLE_MEM_EXT_SZ + CYBLE_L2CAP_HDR_SZ))
 
@@ -259,9 +259,9 @@
 
 #if(CYBLE_L2CAP_ENABLE != 0u)
     /* L2CAP MTU Size */
-    #define CYBLE_L2CAP_MTU                             (23u)
+    #define CYBLE_L2CAP_MTU                             (131u)
     /* L2CAP PMS Size */
-    #define CYBLE_L2CAP_MPS                             (23u)
+    #define CYBLE_L2CAP_MPS                             (131u)
     #define CYBLE_L2CAP_MTU_MPS                         (CYBLE_L2CAP_MTU / CYBLE_L2CAP_MPS)
     /* Number of L2CAP Logical channels */
     #define CYBLE_L2CAP_LOGICAL_CHANNEL_COUNT           (1u) 
@@ -0,0 +1,307 @@
+/***************************************************************************//**
+* \file CYBLE_custom.c
+* \version 3.66
+* 
+* \brief
+*  Contains the source code for the Custom Service.
+* 
+********************************************************************************
+* \copyright
+* Copyright 2014-2020, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+
+#include "BLE_eventHandler.h"
+
+#ifdef CYBLE_CUSTOM_SERVER
+
+const CYBLE_CUSTOMS_T cyBle_customs[0x06u] = {
+
+    /* Environmental Sensing service */
+    {
+        0x0013u, /* Handle of the Environmental Sensing service */
+        {
+
+            /* Temperature characteristic */
+            {
+                0x0015u, /* Handle of the Temperature characteristic */
+
+                /* Array of Descriptors handles */
+                {
+                    0x0016u, /* Handle of the Client Characteristic Configuration descriptor */ 
+                    0x0017u, /* Handle of the ES Trigger Setting descriptor */ 
+                }, 
+            },
+
+            /* Humidity characteristic */
+            {
+                0x0019u, /* Handle of the Humidity characteristic */
+
+                /* Array of Descriptors handles */
+                {
+                    0x001Au, /* Handle of the Client Characteristic Configuration descriptor */ 
+                    0x001Bu, /* Handle of the ES Trigger Setting descriptor */ 
+                }, 
+            },
+
+            /* Unused characteristic */
+            {
+                CYBLE_GATT_INVALID_ATTR_HANDLE_VALUE, /* Handle of the characteristic */
+
+                /* Array of Descriptors handles */
+                {
+                    CYBLE_GATT_INVALID_ATTR_HANDLE_VALUE,
+                    CYBLE_GATT_INVALID_ATTR_HANDLE_VALUE,
+                },
+            },
+        }, 
+    },
+
+    /* History Transfer service */
+    {
+        0x001Cu, /* Handle of the History Transfer service */
+        {
+
+            /* History Data characteristic */
+            {
+                0x001Eu, /* Handle of the History Data characteristic */
+
+                /* Array of Descriptors handles */
+                {
+                    0x001Fu, /* Handle of the Client Characteristic Configuration descriptor */ 
+                    CYBLE_GATT_INVALID_ATTR_HANDLE_VALUE, 
+                }, 
+            },
+
+            /* History Control characteristic */
+            {
+                0x0021u, /* Handle of the History Control characteristic */
+
+                /* Array of Descriptors handles */
+                {
+                    CYBLE_GATT_INVALID_ATTR_HANDLE_VALUE, 
+                    CYBLE_GATT_INVALID_ATTR_HANDLE_VALUE, 
+                }, 
+            },
+
+            /* Batch Data characteristic */
+            {
+                0x0023u, /* Handle of the Batch Data characteristic */
+
+                /* Array of Descriptors handles */
+                {
+                    0x0024u, /* Handle of the Client Characteristic Configuration descriptor */ 
+                    CYBLE_GATT_INVALID_ATTR_HANDLE_VALUE, 
+                }, 
+            },
+        }, 
+    },
+
+    /* Configuration Service service */
+    {
+        0x0025u, /* Handle of the Configuration Service service */
+        {
+
+            /* Configuration characteristic */
+            {
+                0x0027u, /* Handle of the Configuration characteristic */
+
+                /* Array of Descriptors handles */
+                {
+                    CYBLE_GATT_INVALID_ATTR_HANDLE_VALUE, 
+                    CYBLE_GATT_INVALID_ATTR_HANDLE_VALUE, 
+                }, 
+            },
+
+            /* Gateway RSSI characteristic */
+            {
+                0x0029u, /* Handle of the Gateway RSSI characteristic */
+
+                /* Array of Descriptors handles */
+                {
+                    CYBLE_GATT_INVALID_ATTR_HANDLE_VALUE, 
+                    CYBLE_GATT_INVALID_ATTR_HANDLE_VALUE, 
+                }, 
+            },
+
+            /* Unused characteristic */
+            {
+                CYBLE_GATT_INVALID_ATTR_HANDLE_VALUE, /* Handle of the characteristic */
+
+                /* Array of Descriptors handles */
+                {
+                    CYBLE_GATT_INVALID_ATTR_HANDLE_VALUE,
+                    CYBLE_GATT_INVALID_ATTR_HANDLE_VALUE,
+                },
+            },
+        }, 
+    },
+
+    /* Current Time service */
+    {
+        0x002Au, /* Handle of the Current Time service */
+        {
+
+            /* Current Time characteristic */
+            {
+                0x002Cu, /* Handle of the Current Time characteristic */
+
+                /* Array of Descriptors handles */
+                {
+                    0x002Du, /* Handle of the Client Characteristic Configuration descriptor */ 
+                    CYBLE_GATT_INVALID_ATTR_HANDLE_VALUE, 
+                }, 
+            },
+
+            /* Unused characteristic */
+            {
+                CYBLE_GATT_INVALID_ATTR_HANDLE_VALUE, /* Handle of the characteristic */
+
+                /* Array of Descriptors handles */
+                {
+                    CYBLE_GATT_INVALID_ATTR_HANDLE_VALUE,
+                    CYBLE_GATT_INVALID_ATTR_HANDLE_VALUE,
+                },
+            },
+
+            /* Unused characteristic */
+            {
+                CYBLE_GATT_INVALID_ATTR_HANDLE_VALUE, /* Handle of the characteristic */
+
+                /* Array of Descriptors handles */
+                {
+                    CYBLE_GATT_INVALID_ATTR_HANDLE_VALUE,
+                    CYBLE_GATT_INVALID_ATTR_HANDLE_VALUE,
+                },
+            },
+        }, 
+    },
+
+    /* Diagnostics Service service */
+    {
+        0x002Eu, /* Handle of the Diagnostics Service service */
+        {
+
+            /* Diagnostics characteristic */
+            {
+                0x0030u, /* Handle of the Diagnostics characteristic */
+
+                /* Array of Descriptors handles */
+                {
+                    CYBLE_GATT_INVALID_ATTR_HANDLE_VALUE, 
+                    CYBLE_GATT_INVALID_ATTR_HANDLE_VALUE, 
+                }, 
+            },
+
+            /* Energy characteristic */
+            {
+                0x0032u, /* Handle of the Energy characteristic */
+
+                /* Array of Descriptors handles */
+                {
+                    CYBLE_GATT_INVALID_ATTR_HANDLE_VALUE, 
+                    CYBLE_GATT_INVALID_ATTR_HANDLE_VALUE, 
+                }, 
+            },
+
+            /* Unused characteristic */
+            {
+                CYBLE_GATT_INVALID_ATTR_HANDLE_VALUE, /* Handle of the characteristic */
+
+                /* Array of Descriptors handles */
+                {
+                    CYBLE_GATT_INVALID_ATTR_HANDLE_VALUE,
+                    CYBLE_GATT_INVALID_ATTR_HANDLE_VALUE,
+                },
+            },
+        }, 
+    },
+
+    /* Status Service service */
+    {
+        0x0033u, /* Handle of the Status Service service */
+        {
+
+            /* Status characteristic */
+            {
+                0x0035u, /* Handle of the Status characteristic */
+
+                /* Array of Descriptors handles */
+                {
+                    CYBLE_GATT_INVALID_ATTR_HANDLE_VALUE, 
+                    CYBLE_GATT_INVALID_ATTR_HANDLE_VALUE, 
+                }, 
+            },
+
+            /* Unused characteristic */
+            {
+                CYBLE_GATT_INVALID_ATTR_HANDLE_VALUE, /* Handle of the characteristic */
+
+                /* Array of Descriptors handles */
+                {
+                    CYBLE_GATT_INVALID_ATTR_HANDLE_VALUE,
+                    CYBLE_GATT_INVALID_ATTR_HANDLE_VALUE,
+                },
+            },
+
+            /* Unused characteristic */
+            {
+                CYBLE_GATT_INVALID_ATTR_HANDLE_VALUE, /* Handle of the characteristic */
+
+                /* Array of Descriptors handles */
+                {
+                    CYBLE_GATT_INVALID_ATTR_HANDLE_VALUE,
+                    CYBLE_GATT_INVALID_ATTR_HANDLE_VALUE,
+                },
+            },
+        }, 
+    },
+};
+
+#endif /* (CYBLE_CUSTOM_SERVER) */
+
+#ifdef CYBLE_CUSTOM_CLIENT
+
+CYBLE_CUSTOMC_T cyBle_customc[CYBLE_CUSTOMC_SERVICE_COUNT];
+
+#endif /* (CYBLE_CUSTOM_CLIENT) */
+
+
+/******************************************************************************
+* Function Name: CyBle_CustomInit
+***************************************************************************//**
+* 
+*  This function initializes Custom Service.
+* 
+******************************************************************************/
+void CyBle_CustomInit(void)
+{
+
+#ifdef CYBLE_CUSTOM_CLIENT
+
+    uint32 servCnt;
+    uint32 charCnt;
+    uint32 descCnt;
+
+    for(servCnt = 0u; servCnt < (uint32) CYBLE_CUSTOMC_SERVICE_COUNT; servCnt++)
+    {
+        for(charCnt = 0u; charCnt < (uint32) cyBle_customc[servCnt].charCount; charCnt++)
+        {
+            for(descCnt = 0u; descCnt < (uint32) cyBle_customc[servCnt].customServChar[charCnt].descCount; descCnt++)
+            {
+                cyBle_customc[servCnt].customServChar[charCnt].customServCharDesc[descCnt].descHandle =
+                    CYBLE_GATT_INVALID_ATTR_HANDLE_VALUE;
+            }
+            cyBle_customc[servCnt].customServChar[charCnt].customServCharHandle = 0u;
+        }
+        cyBle_customc[servCnt].customServHandle = 0u;
+    }
+
+#endif /* (CYBLE_CUSTOM_CLIENT) */
+
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,253 @@
+/***************************************************************************//**
+* \file CYBLE_custom.h
+* \version 3.66
+* 
+* \brief
+*  Contains the function prototypes and constants for the Custom Service.
+* 
+********************************************************************************
+* \copyright
+* Copyright 2014-2020, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+
+#if !defined(CY_BLE_CYBLE_CUSTOM_H)
+#define CY_BLE_CYBLE_CUSTOM_H
+
+#include "BLE_gatt.h"
+
+
+/***************************************
+* Conditional Compilation Parameters
+***************************************/
+
+/* Maximum supported Custom Services */
+#define CYBLE_CUSTOMS_SERVICE_COUNT                  (0x06u)
+#define CYBLE_CUSTOMC_SERVICE_COUNT                  (0x00u)
+#define CYBLE_CUSTOM_SERVICE_CHAR_COUNT              (0x03u)
+#define CYBLE_CUSTOM_SERVICE_CHAR_DESCRIPTORS_COUNT  (0x02u)
+
+/* Below are the indexes and handles of the defined Custom Services and their characteristics */
+#define CYBLE_ENVIRONMENTAL_SENSING_SERVICE_INDEX   (0x00u) /* Index of Environmental Sensing service in the cyBle_customs array */
+#define CYBLE_ENVIRONMENTAL_SENSING_TEMPERATURE_CHAR_INDEX   (0x00u) /* Index of Temperature characteristic */
+#define CYBLE_ENVIRONMENTAL_SENSING_TEMPERATURE_CLIENT_CHARACTERISTIC_CONFIGURATION_DESC_INDEX   (0x00u) /* Index of Client Characteristic Configuration descriptor */
+#define CYBLE_ENVIRONMENTAL_SENSING_TEMPERATURE_ES_TRIGGER_SETTING_DESC_INDEX   (0x01u) /* Index of ES Trigger Setting descriptor */
+#define CYBLE_ENVIRONMENTAL_SENSING_HUMIDITY_CHAR_INDEX   (0x01u) /* Index of Humidity characteristic */
+#define CYBLE_ENVIRONMENTAL_SENSING_HUMIDITY_CLIENT_CHARACTERISTIC_CONFIGURATION_DESC_INDEX   (0x00u) /* Index of Client Characteristic Configuration descriptor */
+#define CYBLE_ENVIRONMENTAL_SENSING_HUMIDITY_ES_TRIGGER_SETTING_DESC_INDEX   (0x01u) /* Index of ES Trigger Setting descriptor */
+
+#define CYBLE_HISTORY_TRANSFER_SERVICE_INDEX   (0x01u) /* Index of History Transfer service in the cyBle_customs array */
+#define CYBLE_HISTORY_TRANSFER_HISTORY_DATA_CHAR_INDEX   (0x00u) /* Index of History Data characteristic */
+#define CYBLE_HISTORY_TRANSFER_HISTORY_DATA_CLIENT_CHARACTERISTIC_CONFIGURATION_DESC_INDEX   (0x00u) /* Index of Client Characteristic Configuration descriptor */
+#define CYBLE_HISTORY_TRANSFER_HISTORY_CONTROL_CHAR_INDEX   (0x01u) /* Index of History Control characteristic */
+#define CYBLE_HISTORY_TRANSFER_BATCH_DATA_CHAR_INDEX   (0x02u) /* Index of Batch Data characteristic */
+#define CYBLE_HISTORY_TRANSFER_BATCH_DATA_CLIENT_CHARACTERISTIC_CONFIGURATION_DESC_INDEX   (0x00u) /* Index of Client Characteristic Configuration descriptor */
+
+#define CYBLE_CONFIGURATION_SERVICE_SERVICE_INDEX   (0x02u) /* Index of Configuration Service service in the cyBle_customs array */
+#define CYBLE_CONFIGURATION_SERVICE_CONFIGURATION_CHAR_INDEX   (0x00u) /* Index of Configuration characteristic */
+#define CYBLE_CONFIGURATION_SERVICE_GATEWAY_RSSI_CHAR_INDEX   (0x01u) /* Index of Gateway RSSI characteristic */
+
+#define CYBLE_CURRENT_TIME_SERVICE_INDEX   (0x03u) /* Index of Current Time service in the cyBle_customs array */
+#define CYBLE_CURRENT_TIME_CURRENT_TIME_CHAR_INDEX   (0x00u) /* Index of Current Time characteristic */
+#define CYBLE_CURRENT_TIME_CURRENT_TIME_CLIENT_CHARACTERISTIC_CONFIGURATION_DESC_INDEX   (0x00u) /* Index of Client Characteristic Configuration descriptor */
+
+#define CYBLE_DIAGNOSTICS_SERVICE_SERVICE_INDEX   (0x04u) /* Index of Diagnostics Service service in the cyBle_customs array */
+#define CYBLE_DIAGNOSTICS_SERVICE_DIAGNOSTICS_CHAR_INDEX   (0x00u) /* Index of Diagnostics characteristic */
+#define CYBLE_DIAGNOSTICS_SERVICE_ENERGY_CHAR_INDEX   (0x01u) /* Index of Energy characteristic */
+
+#define CYBLE_STATUS_SERVICE_SERVICE_INDEX   (0x05u) /* Index of Status Service service in the cyBle_customs array */
+#define CYBLE_STATUS_SERVICE_STATUS_CHAR_INDEX   (0x00u) /* Index of Status characteristic */
+
+
+#define CYBLE_ENVIRONMENTAL_SENSING_SERVICE_HANDLE   (0x0013u) /* Handle of Environmental Sensing service */
+#define CYBLE_ENVIRONMENTAL_SENSING_TEMPERATURE_DECL_HANDLE   (0x0014u) /* Handle of Temperature characteristic declaration */
+#define CYBLE_ENVIRONMENTAL_SENSING_TEMPERATURE_CHAR_HANDLE   (0x0015u) /* Handle of Temperature characteristic */
+#define CYBLE_ENVIRONMENTAL_SENSING_TEMPERATURE_CLIENT_CHARACTERISTIC_CONFIGURATION_DESC_HANDLE   (0x0016u) /* Handle of Client Characteristic Configuration descriptor */
+#define CYBLE_ENVIRONMENTAL_SENSING_TEMPERATURE_ES_TRIGGER_SETTING_DESC_HANDLE   (0x0017u) /* Handle of ES Trigger Setting descriptor */
+#define CYBLE_ENVIRONMENTAL_SENSING_HUMIDITY_DECL_HANDLE   (0x0018u) /* Handle of Humidity characteristic declaration */
+#define CYBLE_ENVIRONMENTAL_SENSING_HUMIDITY_CHAR_HANDLE   (0x0019u) /* Handle of Humidity characteristic */
+#define CYBLE_ENVIRONMENTAL_SENSING_HUMIDITY_CLIENT_CHARACTERISTIC_CONFIGURATION_DESC_HANDLE   (0x001Au) /* Handle of Client Characteristic Configuration descriptor */
+#define CYBLE_ENVIRONMENTAL_SENSING_HUMIDITY_ES_TRIGGER_SETTING_DESC_HANDLE   (0x001Bu) /* Handle of ES Trigger Setting descriptor */
+
+#define CYBLE_HISTORY_TRANSFER_SERVICE_HANDLE   (0x001Cu) /* Handle of History Transfer service */
+#define CYBLE_HISTORY_TRANSFER_HISTORY_DATA_DECL_HANDLE   (0x001Du) /* Handle of History Data characteristic declaration */
+#define CYBLE_HISTORY_TRANSFER_HISTORY_DATA_CHAR_HANDLE   (0x001Eu) /* Handle of History Data characteristic */
+#define CYBLE_HISTORY_TRANSFER_HISTORY_DATA_CLIENT_CHARACTERISTIC_CONFIGURATION_DESC_HANDLE   (0x001Fu) /* Handle of Client Characteristic Configuration descriptor */
+#define CYBLE_HISTORY_TRANSFER_HISTORY_CONTROL_DECL_HANDLE   (0x0020u) /* Handle of History Control characteristic declaration */
+#define CYBLE_HISTORY_TRANSFER_HISTORY_CONTROL_CHAR_HANDLE   (0x0021u) /* Handle of History Control characteristic */
+#define CYBLE_HISTORY_TRANSFER_BATCH_DATA_DECL_HANDLE   (0x0022u) /* Handle of Batch Data characteristic declaration */
+#define CYBLE_HISTORY_TRANSFER_BATCH_DATA_CHAR_HANDLE   (0x0023u) /* Handle of Batch Data characteristic */
+#define CYBLE_HISTORY_TRANSFER_BATCH_DATA_CLIENT_CHARACTERISTIC_CONFIGURATION_DESC_HANDLE   (0x0024u) /* Handle of Client Characteristic Configuration descriptor */
+
+#define CYBLE_CONFIGURATION_SERVICE_SERVICE_HANDLE   (0x0025u) /* Handle of Configuration Service service */
+#define CYBLE_CONFIGURATION_SERVICE_CONFIGURATION_DECL_HANDLE   (0x0026u) /* Handle of Configuration characteristic declaration */
+#define CYBLE_CONFIGURATION_SERVICE_CONFIGURATION_CHAR_HANDLE   (0x0027u) /* Handle of Configuration characteristic */
+#define CYBLE_CONFIGURATION_SERVICE_GATEWAY_RSSI_DECL_HANDLE   (0x0028u) /* Handle of Gateway RSSI characteristic declaration */
+#define CYBLE_CONFIGURATION_SERVICE_GATEWAY_RSSI_CHAR_HANDLE   (0x0029u) /* Handle of Gateway RSSI characteristic */
+
+#define CYBLE_CURRENT_TIME_SERVICE_HANDLE   (0x002Au) /* Handle of Current Time service */
+#define CYBLE_CURRENT_TIME_CURRENT_TIME_DECL_HANDLE   (0x002Bu) /* Handle of Current Time characteristic declaration */
+#define CYBLE_CURRENT_TIME_CURRENT_TIME_CHAR_HANDLE   (0x002Cu) /* Handle of Current Time characteristic */
+#define CYBLE_CURRENT_TIME_CURRENT_TIME_CLIENT_CHARACTERISTIC_CONFIGURATION_DESC_HANDLE   (0x002Du) /* Handle of Client Characteristic Configuration descriptor */
+
+#define CYBLE_DIAGNOSTICS_SERVICE_SERVICE_HANDLE   (0x002Eu) /* Handle of Diagnostics Service service */
+#define CYBLE_DIAGNOSTICS_SERVICE_DIAGNOSTICS_DECL_HANDLE   (0x002Fu) /* Handle of Diagnostics characteristic declaration */
+#define CYBLE_DIAGNOSTICS_SERVICE_DIAGNOSTICS_CHAR_HANDLE   (0x0030u) /* Handle of Diagnostics characteristic */
+#define CYBLE_DIAGNOSTICS_SERVICE_ENERGY_DECL_HANDLE   (0x0031u) /* Handle of Energy characteristic declaration */
+#define CYBLE_DIAGNOSTICS_SERVICE_ENERGY_CHAR_HANDLE   (0x0032u) /* Handle of Energy characteristic */
+
+#define CYBLE_STATUS_SERVICE_SERVICE_HANDLE   (0x0033u) /* Handle of Status Service service */
+#define CYBLE_STATUS_SERVICE_STATUS_DECL_HANDLE   (0x0034u) /* Handle of Status characteristic declaration */
+#define CYBLE_STATUS_SERVICE_STATUS_CHAR_HANDLE   (0x0035u) /* Handle of Status characteristic */
+
+
+
+#if(CYBLE_CUSTOMS_SERVICE_COUNT != 0u)
+    #define CYBLE_CUSTOM_SERVER
+#endif /* (CYBLE_CUSTOMS_SERVICE_COUNT != 0u) */
+
+#if(CYBLE_CUSTOMC_SERVICE_COUNT != 0u)
+    #define CYBLE_CUSTOM_CLIENT
+#endif /* (CYBLE_CUSTOMC_SERVICE_COUNT != 0u) */
+
+/***************************************
+* Data Struct Definition
+***************************************/
+
+/**
+ \addtogroup group_service_api_custom
+ @{
+*/
+
+#ifdef CYBLE_CUSTOM_SERVER
+
+/** Contains information about Custom Characteristic structure */
+typedef struct
+{
+    /** Custom Characteristic handle */
+    CYBLE_GATT_DB_ATTR_HANDLE_T customServCharHandle;
+    /** Custom Characteristic Descriptors handles */
+    CYBLE_GATT_DB_ATTR_HANDLE_T customServCharDesc[     /* MDK doesn't allow array with zero length */
+        CYBLE_CUSTOM_SERVICE_CHAR_DESCRIPTORS_COUNT == 0u ? 1u : CYBLE_CUSTOM_SERVICE_CHAR_DESCRIPTORS_COUNT];
+} CYBLE_CUSTOMS_INFO_T;
+
+/** Structure with Custom Service attribute handles. */
+typedef struct
+{
+    /** Handle of a Custom Service */
+    CYBLE_GATT_DB_ATTR_HANDLE_T customServHandle;
+
+    /** Information about Custom Characteristics */
+    CYBLE_CUSTOMS_INFO_T customServInfo[                /* MDK doesn't allow array with zero length */
+        CYBLE_CUSTOM_SERVICE_CHAR_COUNT == 0u ? 1u : CYBLE_CUSTOM_SERVICE_CHAR_COUNT];
+} CYBLE_CUSTOMS_T;
+
+
+#endif /* (CYBLE_CUSTOM_SERVER) */
+
+/** @} */
+
+/* DOM-IGNORE-BEGIN */
+/* The custom Client functionality is not functional in current version of
+* the component.
+*/
+#ifdef CYBLE_CUSTOM_CLIENT
+
+typedef struct
+{
+    /** Custom Descriptor handle */
+    CYBLE_GATT_DB_ATTR_HANDLE_T descHandle;
+    /** Custom Descriptor 128 bit UUID */
+    const void *uuid;
+    /** UUID Format - 16-bit (0x01) or 128-bit (0x02) */
+    uint8 uuidFormat;
+
+} CYBLE_CUSTOMC_DESC_T;
+
+typedef struct
+{
+    /** Characteristic handle */
+    CYBLE_GATT_DB_ATTR_HANDLE_T customServCharHandle;
+    /** Characteristic end handle */
+    CYBLE_GATT_DB_ATTR_HANDLE_T customServCharEndHandle;
+    /** Custom Characteristic UUID */
+    const void *uuid;
+    /** UUID Format - 16-bit (0x01) or 128-bit (0x02) */
+    uint8 uuidFormat;
+    /** Properties for value field */
+    uint8  properties;
+    /** Number of descriptors */
+    uint8 descCount;
+    /** Characteristic Descriptors */
+    CYBLE_CUSTOMC_DESC_T * customServCharDesc;
+} CYBLE_CUSTOMC_CHAR_T;
+
+/** Structure with discovered attributes information of Custom Service */
+typedef struct
+{
+    /** Custom Service handle */
+    CYBLE_GATT_DB_ATTR_HANDLE_T customServHandle;
+    /** Custom Service UUID */
+    const void *uuid;
+    /** UUID Format - 16-bit (0x01) or 128-bit (0x02) */
+    uint8 uuidFormat;
+    /** Number of characteristics */
+    uint8 charCount;
+    /** Custom Service Characteristics */
+    CYBLE_CUSTOMC_CHAR_T * customServChar;
+} CYBLE_CUSTOMC_T;
+
+#endif /* (CYBLE_CUSTOM_CLIENT) */
+
+/* DOM-IGNORE-END */
+
+#ifdef CYBLE_CUSTOM_SERVER
+
+extern const CYBLE_CUSTOMS_T cyBle_customs[CYBLE_CUSTOMS_SERVICE_COUNT];
+
+#endif /* (CYBLE_CUSTOM_SERVER) */
+
+#ifdef CYBLE_CUSTOM_CLIENT
+
+extern CYBLE_CUSTOMC_T cyBle_customc[CYBLE_CUSTOMC_SERVICE_COUNT];
+
+#endif /* (CYBLE_CUSTOM_CLIENT) */
+
+
+/***************************************
+* Private Function Prototypes
+***************************************/
+
+/** \cond IGNORE */
+void CyBle_CustomInit(void);
+
+#ifdef CYBLE_CUSTOM_CLIENT
+
+void CyBle_CustomcDiscoverServiceEventHandler(const CYBLE_DISC_SRVC128_INFO_T *discServInfo);
+void CyBle_CustomcDiscoverCharacteristicsEventHandler(uint16 discoveryService, const CYBLE_DISC_CHAR_INFO_T *discCharInfo);
+CYBLE_GATT_ATTR_HANDLE_RANGE_T CyBle_CustomcGetCharRange(uint8 incrementIndex);
+void CyBle_CustomcDiscoverCharDescriptorsEventHandler(const CYBLE_DISC_DESCR_INFO_T *discDescrInfo);
+
+#endif /* (CYBLE_CUSTOM_CLIENT) */
+
+/** \endcond */
+
+
+/** \cond IGNORE */
+/***************************************
+* The following code is DEPRECATED and
+* should not be used in new projects.
+***************************************/
+#define customServiceCharHandle         customServCharHandle
+#define customServiceCharDescriptors    customServCharDesc
+#define customServiceHandle             customServHandle
+#define customServiceInfo               customServInfo
+/** \endcond */
+
+
+#endif /* CY_BLE_CYBLE_CUSTOM_H  */
+
+/* [] END OF FILE */
@@ -78,21 +78,21 @@ CYBLE_STATE_T cyBle_state;
         0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u,
         0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u }, 
         {{
-            0x00u, 0x00u,
+            0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u,
         },
         {
-            0x00u, 0x00u,
+            0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u,
         },
         {
-            0x00u, 0x00u,
+            0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u,
         },
         {
-            0x00u, 0x00u,
+            0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u,
         },
         {
-            0x00u, 0x00u,
+            0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u,
         }}, 
-        0x02u, /* CYBLE_GATT_DB_CCCD_COUNT */ 
+        0x0Cu, /* CYBLE_GATT_DB_CCCD_COUNT */ 
         0x05u, /* CYBLE_GAP_MAX_BONDED_DEVICE */ 
     };
 #endif /* (CYBLE_MODE_PROFILE) */
@@ -108,7 +108,7 @@ CYBLE_STATE_T cyBle_state;
     0x000Fu,    /* Handle of the Client Characteristic Configuration descriptor */
 };
     
-    static uint8 cyBle_attValues[0x20u] = {
+    static uint8 cyBle_attValues[0x92u] = {
     /* Device Name */
     (uint8)'D', (uint8)'H', (uint8)'T', (uint8)'2', (uint8)'2', (uint8)' ', (uint8)'x', (uint8)'x', (uint8)'.',
     (uint8)'x', (uint8)'C', (uint8)' ', (uint8)'x', (uint8)'x', (uint8)'%',
@@ -131,6 +131,75 @@ CYBLE_STATE_T cyBle_state;
     /* Alert Level */
     0x00u,
 
+    /* Temperature */
+    0x00u, 0x80u,
+
+    /* ES Trigger Setting */
+    0x03u, 0x14u, 0x00u,
+
+    /* Humidity */
+    0xFFu, 0xFFu,
+
+    /* ES Trigger Setting */
+    0x03u, 0x32u, 0x00u,
+
+    /* History Data */
+    0x00u, 0x00u, 0x00u, 0x00u,
+
+    /* History Control */
+    0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u,
+
+    /* Batch Data */
+    0x00u, 0x00u, 0x00u, 0x00u,
+
+    /* Configuration */
+    0x0Au, 0x00u, 0x40u, 0x06u, 0x00u, 0x20u, 0x00u, 0x00u, 0x2Cu, 0x01u, 0x14u, 0x00u, 0x32u, 0x00u, 0x3Cu, 0x00u,
+    0x00u, 0x01u, 0x07u, 0x07u, 0x01u,
+
+    /* Gateway RSSI */
+    0x00u,
+
+    /* Current Time */
+    0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u,
+
+    /* Diagnostics */
+    0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u,
+    0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u,
+
+    /* Energy */
+    0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u,
+    0x00u, 0x00u, 0x00u, 0x00u,
+
+    /* Status */
+    0x04u, 0x00u, 0x80u, 0xFFu, 0xFFu, 0xFFu, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x80u,
+
+};
+
+static const uint8 cyBle_attUuid128[][16u] = {
+    /* History Transfer */
+    { 0x10u, 0x9Fu, 0x4Eu, 0x7Cu, 0x2Au, 0x5Du, 0x3Eu, 0x8Fu, 0x9Du, 0x4Bu, 0x2Cu, 0x6Au, 0x01u, 0x00u, 0xE7u, 0xB1u },
+    /* History Data */
+    { 0x10u, 0x9Fu, 0x4Eu, 0x7Cu, 0x2Au, 0x5Du, 0x3Eu, 0x8Fu, 0x9Du, 0x4Bu, 0x2Cu, 0x6Au, 0x02u, 0x00u, 0xE7u, 0xB1u },
+    /* History Control */
+    { 0x10u, 0x9Fu, 0x4Eu, 0x7Cu, 0x2Au, 0x5Du, 0x3Eu, 0x8Fu, 0x9Du, 0x4Bu, 0x2Cu, 0x6Au, 0x03u, 0x00u, 0xE7u, 0xB1u },
+    /* Batch Data */
+    { 0x10u, 0x9Fu, 0x4Eu, 0x7Cu, 0x2Au, 0x5Du, 0x3Eu, 0x8Fu, 0x9Du, 0x4Bu, 0x2Cu, 0x6Au, 0x04u, 0x00u, 0xE7u, 0xB1u },
+    /* Configuration Service */
+    { 0x10u, 0x9Fu, 0x4Eu, 0x7Cu, 0x2Au, 0x5Du, 0x3Eu, 0x8Fu, 0x9Du, 0x4Bu, 0x2Cu, 0x6Au, 0x10u, 0x00u, 0xE7u, 0xB1u },
+    /* Configuration */
+    { 0x10u, 0x9Fu, 0x4Eu, 0x7Cu, 0x2Au, 0x5Du, 0x3Eu, 0x8Fu, 0x9Du, 0x4Bu, 0x2Cu, 0x6Au, 0x11u, 0x00u, 0xE7u, 0xB1u },
+    /* Gateway RSSI */
+    { 0x10u, 0x9Fu, 0x4Eu, 0x7Cu, 0x2Au, 0x5Du, 0x3Eu, 0x8Fu, 0x9Du, 0x4Bu, 0x2Cu, 0x6Au, 0x12u, 0x00u, 0xE7u, 0xB1u },
+    /* Diagnostics Service */
+    { 0x10u, 0x9Fu, 0x4Eu, 0x7Cu, 0x2Au, 0x5Du, 0x3Eu, 0x8Fu, 0x9Du, 0x4Bu, 0x2Cu, 0x6Au, 0x20u, 0x00u, 0xE7u, 0xB1u },
+    /* Diagnostics */
+    { 0x10u, 0x9Fu, 0x4Eu, 0x7Cu, 0x2Au, 0x5Du, 0x3Eu, 0x8Fu, 0x9Du, 0x4Bu, 0x2Cu, 0x6Au, 0x21u, 0x00u, 0xE7u, 0xB1u },
+    /* Energy */
+    { 0x10u, 0x9Fu, 0x4Eu, 0x7Cu, 0x2Au, 0x5Du, 0x3Eu, 0x8Fu, 0x9Du, 0x4Bu, 0x2Cu, 0x6Au, 0x22u, 0x00u, 0xE7u, 0xB1u },
+    /* Status Service */
+    { 0x10u, 0x9Fu, 0x4Eu, 0x7Cu, 0x2Au, 0x5Du, 0x3Eu, 0x8Fu, 0x9Du, 0x4Bu, 0x2Cu, 0x6Au, 0x30u, 0x00u, 0xE7u, 0xB1u },
+    /* Status */
+    { 0x10u, 0x9Fu, 0x4Eu, 0x7Cu, 0x2Au, 0x5Du, 0x3Eu, 0x8Fu, 0x9Du, 0x4Bu, 0x2Cu, 0x6Au, 0x31u, 0x00u, 0xE7u, 0xB1u },
 };
 #if(CYBLE_GATT_DB_CCCD_COUNT != 0u)
 uint8 cyBle_attValuesCCCD[CYBLE_GATT_DB_CCCD_COUNT];
@@ -145,9 +214,39 @@ CYBLE_GATTS_ATT_GEN_VAL_LEN_T cyBle_attValuesLen[CYBLE_GATT_DB_ATT_VAL_COUNT] =
     { 0x0004u, (void *)&cyBle_attValues[27] }, /* Service Changed */
     { 0x0002u, (void *)&cyBle_attValuesCCCD[0] }, /* Client Characteristic Configuration */
     { 0x0001u, (void *)&cyBle_attValues[31] }, /* Alert Level */
+    { 0x0002u, (void *)&cyBle_attValues[32] }, /* Temperature */
+    { 0x0002u, (void *)&cyBle_attValuesCCCD[2] }, /* Client Characteristic Configuration */
+    { 0x0003u, (void *)&cyBle_attValues[34] }, /* ES Trigger Setting */
+    { 0x0002u, (void *)&cyBle_attValues[37] }, /* Humidity */
+    { 0x0002u, (void *)&cyBle_attValuesCCCD[4] }, /* Client Characteristic Configuration */
+    { 0x0003u, (void *)&cyBle_attValues[39] }, /* ES Trigger Setting */
+    { 0x0010u, (void *)&cyBle_attUuid128[0][0] }, /* History Transfer UUID */
+    { 0x0010u, (void *)&cyBle_attUuid128[1][0] }, /* History Data UUID */
+    { 0x0004u, (void *)&cyBle_attValues[42] }, /* History Data */
+    { 0x0002u, (void *)&cyBle_attValuesCCCD[6] }, /* Client Characteristic Configuration */
+    { 0x0010u, (void *)&cyBle_attUuid128[2][0] }, /* History Control UUID */
+    { 0x0008u, (void *)&cyBle_attValues[46] }, /* History Control */
+    { 0x0010u, (void *)&cyBle_attUuid128[3][0] }, /* Batch Data UUID */
+    { 0x0004u, (void *)&cyBle_attValues[54] }, /* Batch Data */
+    { 0x0002u, (void *)&cyBle_attValuesCCCD[8] }, /* Client Characteristic Configuration */
+    { 0x0010u, (void *)&cyBle_attUuid128[4][0] }, /* Configuration Service UUID */
+    { 0x0010u, (void *)&cyBle_attUuid128[5][0] }, /* Configuration UUID */
+    { 0x0015u, (void *)&cyBle_attValues[58] }, /* Configuration */
+    { 0x0010u, (void *)&cyBle_attUuid128[6][0] }, /* Gateway RSSI UUID */
+    { 0x0001u, (void *)&cyBle_attValues[79] }, /* Gateway RSSI */
+    { 0x000Au, (void *)&cyBle_attValues[80] }, /* Current Time */
+    { 0x0002u, (void *)&cyBle_attValuesCCCD[10] }, /* Client Characteristic Configuration */
+    { 0x0010u, (void *)&cyBle_attUuid128[7][0] }, /* Diagnostics Service UUID */
+    { 0x0010u, (void *)&cyBle_attUuid128[8][0] }, /* Diagnostics UUID */
+    { 0x0016u, (void *)&cyBle_attValues[90] }, /* Diagnostics */
+    { 0x0010u, (void *)&cyBle_attUuid128[9][0] }, /* Energy UUID */
+    { 0x0014u, (void *)&cyBle_attValues[112] }, /* Energy */
+    { 0x0010u, (void *)&cyBle_attUuid128[10][0] }, /* Status Service UUID */
+    { 0x0010u, (void *)&cyBle_attUuid128[11][0] }, /* Status UUID */
+    { 0x000Eu, (void *)&cyBle_attValues[132] }, /* Status */
 };
 
-const CYBLE_GATTS_DB_T cyBle_gattDB[0x12u] = {
+const CYBLE_GATTS_DB_T cyBle_gattDB[0x35u] = {
     { 0x0001u, 0x2800u /* Primary service                     */, 0x00000001u /*       */, 0x000Bu, {{0x1800u, NULL}}                           },
     { 0x0002u, 0x2803u /* Characteristic                      */, 0x00020001u /* rd    */, 0x0003u, {{0x2A00u, NULL}}                           },
     { 0x0003u, 0x2A00u /* Device Name                         */, 0x01020001u /* rd    */, 0x0003u, {{0x000Fu, (void *)&cyBle_attValuesLen[0]}} },
@@ -166,6 +265,41 @@ const CYBLE_GATTS_DB_T cyBle_gattDB[0x12u] = {
     { 0x0010u, 0x2800u /* Primary service                     */, 0x00000001u /*       */, 0x0012u, {{0x1802u, NULL}}                           },
     { 0x0011u, 0x2803u /* Characteristic                      */, 0x00040001u /* wwr   */, 0x0012u, {{0x2A06u, NULL}}                           },
     { 0x0012u, 0x2A06u /* Alert Level                         */, 0x01040100u /* wwr   */, 0x0012u, {{0x0001u, (void *)&cyBle_attValuesLen[7]}} },
+    { 0x0013u, 0x2800u /* Primary service                     */, 0x00000001u /*       */, 0x001Bu, {{0x181Au, NULL}}                           },
+    { 0x0014u, 0x2803u /* Characteristic                      */, 0x00120001u /* rd,ntf */, 0x0017u, {{0x2A6Eu, NULL}}                           },
+    { 0x0015u, 0x2A6Eu /* Temperature                         */, 0x01120001u /* rd,ntf */, 0x0017u, {{0x0002u, (void *)&cyBle_attValuesLen[8]}} },
+    { 0x0016u, 0x2902u /* Client Characteristic Configuration */, 0x010A0101u /* rd,wr */, 0x0017u, {{0x0002u, (void *)&cyBle_attValuesLen[9]}} },
+    { 0x0017u, 0x290Du /* ES Trigger Setting                  */, 0x010A0101u /* rd,wr */, 0x0017u, {{0x0003u, (void *)&cyBle_attValuesLen[10]}} },
+    { 0x0018u, 0x2803u /* Characteristic                      */, 0x00120001u /* rd,ntf */, 0x001Bu, {{0x2A6Fu, NULL}}                           },
+    { 0x0019u, 0x2A6Fu /* Humidity                            */, 0x01120001u /* rd,ntf */, 0x001Bu, {{0x0002u, (void *)&cyBle_attValuesLen[11]}} },
+    { 0x001Au, 0x2902u /* Client Characteristic Configuration */, 0x010A0101u /* rd,wr */, 0x001Bu, {{0x0002u, (void *)&cyBle_attValuesLen[12]}} },
+    { 0x001Bu, 0x290Du /* ES Trigger Setting                  */, 0x010A0101u /* rd,wr */, 0x001Bu, {{0x0003u, (void *)&cyBle_attValuesLen[13]}} },
+    { 0x001Cu, 0x2800u /* Primary service                     */, 0x08000001u /*       */, 0x0024u, {{0x0010u, (void *)&cyBle_attValuesLen[14]}} },
+    { 0x001Du, 0x2803u /* Characteristic                      */, 0x00100001u /* ntf   */, 0x001Fu, {{0x0010u, (void *)&cyBle_attValuesLen[15]}} },
+    { 0x001Eu, 0x0002u /* History Data                        */, 0x09100000u /* ntf   */, 0x001Fu, {{0x0004u, (void *)&cyBle_attValuesLen[16]}} },
+    { 0x001Fu, 0x2902u /* Client Characteristic Configuration */, 0x010A0101u /* rd,wr */, 0x001Fu, {{0x0002u, (void *)&cyBle_attValuesLen[17]}} },
+    { 0x0020u, 0x2803u /* Characteristic                      */, 0x000A0001u /* rd,wr */, 0x0021u, {{0x0010u, (void *)&cyBle_attValuesLen[18]}} },
+    { 0x0021u, 0x0003u /* History Control                     */, 0x090A0101u /* rd,wr */, 0x0021u, {{0x0008u, (void *)&cyBle_attValuesLen[19]}} },
+    { 0x0022u, 0x2803u /* Characteristic                      */, 0x00100001u /* ntf   */, 0x0024u, {{0x0010u, (void *)&cyBle_attValuesLen[20]}} },
+    { 0x0023u, 0x0004u /* Batch Data                          */, 0x09100000u /* ntf   */, 0x0024u, {{0x0004u, (void *)&cyBle_attValuesLen[21]}} },
+    { 0x0024u, 0x2902u /* Client Characteristic Configuration */, 0x010A0101u /* rd,wr */, 0x0024u, {{0x0002u, (void *)&cyBle_attValuesLen[22]}} },
+    { 0x0025u, 0x2800u /* Primary service                     */, 0x08000001u /*       */, 0x0029u, {{0x0010u, (void *)&cyBle_attValuesLen[23]}} },
+    { 0x0026u, 0x2803u /* Characteristic                      */, 0x000A0001u /* rd,wr */, 0x0027u, {{0x0010u, (void *)&cyBle_attValuesLen[24]}} },
+    { 0x0027u, 0x0011u /* Configuration                       */, 0x090A0101u /* rd,wr */, 0x0027u, {{0x0015u, (void *)&cyBle_attValuesLen[25]}} },
+    { 0x0028u, 0x2803u /* Characteristic                      */, 0x00080001u /* wr    */, 0x0029u, {{0x0010u, (void *)&cyBle_attValuesLen[26]}} },
+    { 0x0029u, 0x0012u /* Gateway RSSI                        */, 0x09080100u /* wr    */, 0x0029u, {{0x0001u, (void *)&cyBle_attValuesLen[27]}} },
+    { 0x002Au, 0x2800u /* Primary service                     */, 0x00000001u /*       */, 0x002Du, {{0x1805u, NULL}}                           },
+    { 0x002Bu, 0x2803u /* Characteristic                      */, 0x001A0001u /* rd,wr,ntf */, 0x002Du, {{0x2A2Bu, NULL}}                           },
+    { 0x002Cu, 0x2A2Bu /* Current Time                        */, 0x011A0101u /* rd,wr,ntf */, 0x002Du, {{0x000Au, (void *)&cyBle_attValuesLen[28]}} },
+    { 0x002Du, 0x2902u /* Client Characteristic Configuration */, 0x010A0101u /* rd,wr */, 0x002Du, {{0x0002u, (void *)&cyBle_attValuesLen[29]}} },
+    { 0x002Eu, 0x2800u /* Primary service                     */, 0x08000001u /*       */, 0x0032u, {{0x0010u, (void *)&cyBle_attValuesLen[30]}} },
+    { 0x002Fu, 0x2803u /* Characteristic                      */, 0x00020001u /* rd    */, 0x0030u, {{0x0010u, (void *)&cyBle_attValuesLen[31]}} },
+    { 0x0030u, 0x0021u /* Diagnostics                         */, 0x09020001u /* rd    */, 0x0030u, {{0x0016u, (void *)&cyBle_attValuesLen[32]}} },
+    { 0x0031u, 0x2803u /* Characteristic                      */, 0x00020001u /* rd    */, 0x0032u, {{0x0010u, (void *)&cyBle_attValuesLen[33]}} },
+    { 0x0032u, 0x0022u /* Energy                              */, 0x09020001u /* rd    */, 0x0032u, {{0x0014u, (void *)&cyBle_attValuesLen[34]}} },
+    { 0x0033u, 0x2800u /* Primary service                     */, 0x08000001u /*       */, 0x0035u, {{0x0010u, (void *)&cyBle_attValuesLen[35]}} },
+    { 0x0034u, 0x2803u /* Characteristic                      */, 0x00020001u /* rd    */, 0x0035u, {{0x0010u, (void *)&cyBle_attValuesLen[36]}} },
+    { 0x0035u, 0x0031u /* Status                              */, 0x09020001u /* rd    */, 0x0035u, {{0x000Eu, (void *)&cyBle_attValuesLen[37]}} },
 };
 
 
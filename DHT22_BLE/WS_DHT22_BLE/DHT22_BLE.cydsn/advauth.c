@@ -0,0 +1,332 @@
+/* ========================================
+ * Filename:        advauth.c
+ * Description:     Authenticated ADV payload using the BLESS AES engine source file
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+
+#include "advauth.h"
+
+#if (ADVAUTH_ENABLED)
+
+#include "advfmt.h"
+#include <string.h>
+
+/***************************************
+*        API Constants
+***************************************/
+#define SYSTICK_MASK                                (0x00FFFFFFu)
+#define ADVAUTH_BLOCK_LEN                           (16u)
+
+/* RFC 3610 flags: Adata, M' = (M - 2) / 2, L' = L - 1 with a 2-byte length field */
+#define ADVAUTH_CCM_L                               (2u)
+#define ADVAUTH_B0_FLAGS                            ((uint8)(((ADVFMT_AUTH_AAD_LEN != 0u) ? 0x40u : 0x00u) | \
+                                                             (((ADVFMT_EXT_AUTH_LEN - 2u) / 2u) << 3u) | \
+                                                             (ADVAUTH_CCM_L - 1u)))
+#define ADVAUTH_A0_FLAGS                            ((uint8)(ADVAUTH_CCM_L - 1u))
+
+/* Byte order of the blocks CyBle_AesEncrypt() takes, found by AdvAuth_Start() */
+#define ADVAUTH_ORDER_NONE                          (0u)  /* Not checked yet or failed, nothing is signed */
+#define ADVAUTH_ORDER_FIPS                          (1u)  /* Byte 0 is the first byte in FIPS-197 */
+#define ADVAUTH_ORDER_REVERSED                      (2u)  /* Byte 0 is the last byte, as in HCI LE Encrypt */
+
+/* FIPS-197 appendix C.1 */
+static const uint8 advAuthKatKey[ADVAUTH_BLOCK_LEN] =
+{
+    0x00u, 0x01u, 0x02u, 0x03u, 0x04u, 0x05u, 0x06u, 0x07u, 0x08u, 0x09u, 0x0Au, 0x0Bu, 0x0Cu, 0x0Du, 0x0Eu, 0x0Fu
+};
+static const uint8 advAuthKatPlain[ADVAUTH_BLOCK_LEN] =
+{
+    0x00u, 0x11u, 0x22u, 0x33u, 0x44u, 0x55u, 0x66u, 0x77u, 0x88u, 0x99u, 0xAAu, 0xBBu, 0xCCu, 0xDDu, 0xEEu, 0xFFu
+};
+static const uint8 advAuthKatCipher[ADVAUTH_BLOCK_LEN] =
+{
+    0x69u, 0xC4u, 0xE0u, 0xD8u, 0x6Au, 0x7Bu, 0x04u, 0x30u, 0xD8u, 0xCDu, 0xB7u, 0x80u, 0x70u, 0xB4u, 0xC5u, 0x5Au
+};
+
+static const uint8 advAuthKeyFips[ADVAUTH_KEY_LEN] = ADVAUTH_KEY;
+static uint8 advAuthKey[ADVAUTH_KEY_LEN];           /* advAuthKeyFips in the engine's byte order */
+static uint8 advAuthNonce[ADVFMT_AUTH_NONCE_LEN];
+static uint8 advAuthOrder = ADVAUTH_ORDER_NONE;
+static uint8 advAuthEpochValid = 0u;                /* 1 = advAuthEpoch is held in flash */
+static uint16 advAuthEpoch = 0u;
+static uint32 advAuthLastCycles = 0u;
+static uint32 advAuthMaxCycles = 0u;
+
+/*******************************************************************************
+* Function Name: AdvAuth_Reverse
+********************************************************************************
+*
+* Summary:
+*  This routine reverses the byte order of a block in place.
+*
+* Parameters:
+*  uint8* block: ADVAUTH_BLOCK_LEN bytes
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void AdvAuth_Reverse(uint8* block)
+{
+    uint8 i;
+
+    for (i = 0u; i < (ADVAUTH_BLOCK_LEN / 2u); i++) {
+        uint8 byte = block[i];
+
+        block[i] = block[ADVAUTH_BLOCK_LEN - 1u - i];
+        block[ADVAUTH_BLOCK_LEN - 1u - i] = byte;
+    }
+}
+
+/*******************************************************************************
+* Function Name: AdvAuth_Encrypt
+********************************************************************************
+*
+* Summary:
+*  This routine encrypts one block in place on the BLESS AES engine. Blocks
+*  are in FIPS-197 byte order on both sides, the key is already in the
+*  engine's order.
+*
+* Parameters:
+*  uint8* block: ADVAUTH_BLOCK_LEN bytes
+*  uint8* key: ADVAUTH_KEY_LEN bytes key
+*  uint8 order: ADVAUTH_ORDER_FIPS or ADVAUTH_ORDER_REVERSED
+*
+* Return:
+*  uint8: 1 = the engine rejected the request, 0 = block encrypted
+*
+*******************************************************************************/
+static uint8 AdvAuth_Encrypt(uint8* block, uint8* key, uint8 order)
+{
+    uint8 plain[ADVAUTH_BLOCK_LEN];
+
+    (void)memcpy(plain, block, ADVAUTH_BLOCK_LEN);
+    if (order == ADVAUTH_ORDER_REVERSED) {
+        AdvAuth_Reverse(plain);
+    }
+    if (CyBle_AesEncrypt(plain, key, block) != CYBLE_ERROR_OK) {
+        return 1u;
+    }
+    if (order == ADVAUTH_ORDER_REVERSED) {
+        AdvAuth_Reverse(block);
+    }
+    return 0u;
+}
+
+/*******************************************************************************
+* Function Name: AdvAuth_Check
+********************************************************************************
+*
+* Summary:
+*  This routine runs the FIPS-197 known-answer test in one byte order.
+*
+* Parameters:
+*  uint8 order: ADVAUTH_ORDER_FIPS or ADVAUTH_ORDER_REVERSED
+*
+* Return:
+*  uint8: 1 = the engine gives the FIPS-197 cipher text in this order
+*
+*******************************************************************************/
+static uint8 AdvAuth_Check(uint8 order)
+{
+    uint8 key[ADVAUTH_BLOCK_LEN];
+    uint8 block[ADVAUTH_BLOCK_LEN];
+
+    (void)memcpy(key, advAuthKatKey, ADVAUTH_BLOCK_LEN);
+    (void)memcpy(block, advAuthKatPlain, ADVAUTH_BLOCK_LEN);
+    if (order == ADVAUTH_ORDER_REVERSED) {
+        AdvAuth_Reverse(key);
+    }
+
+    return ((AdvAuth_Encrypt(block, key, order) == 0u) &&
+            (memcmp(block, advAuthKatCipher, ADVAUTH_BLOCK_LEN) == 0)) ? 1u : 0u;
+}
+
+/*******************************************************************************
+* Function Name: AdvAuth_Init
+********************************************************************************
+*
+* Summary:
+*  This routine loads the device address into the fixed part of the nonce.
+*  Nothing is signed until AdvAuth_Start() and AdvAuth_SetEpoch() have run.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void AdvAuth_Init(void)
+{
+    const CYBLE_GAP_BD_ADDR_T* address = &cyBle_deviceAddress;
+
+    /* Same address selection as the stack does at CYBLE_EVT_STACK_ON */
+    if (CyBle_IsDeviceAddressValid(cyBle_sflashDeviceAddress) != 0u) {
+        address = cyBle_sflashDeviceAddress;
+    }
+
+    (void)memcpy(&advAuthNonce[ADVFMT_AUTH_NONCE_ADDR_OFFSET], address->bdAddr, CYBLE_GAP_BD_ADDR_SIZE);
+    advAuthNonce[ADVFMT_AUTH_NONCE_DOMAIN_OFFSET] = LO8(ADVFMT_COMPANY_ID);
+    advAuthNonce[ADVFMT_AUTH_NONCE_DOMAIN_OFFSET + 1u] = HI8(ADVFMT_COMPANY_ID);
+    advAuthNonce[ADVFMT_AUTH_NONCE_DOMAIN_OFFSET + 2u] = ADVFMT_VERSION;
+    advAuthOrder = ADVAUTH_ORDER_NONE;
+    advAuthEpochValid = 0u;
+}
+
+/*******************************************************************************
+* Function Name: AdvAuth_Start
+********************************************************************************
+*
+* Summary:
+*  This routine checks the AES engine once the stack is up, at
+*  CYBLE_EVT_STACK_ON. The byte order CyBle_AesEncrypt() expects is not
+*  documented, so it is found with the FIPS-197 known-answer test; if neither
+*  order passes nothing is ever signed.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint8: 1 = the engine is unusable, 0 = ready
+*
+*******************************************************************************/
+uint8_t AdvAuth_Start(void)
+{
+    (void)memcpy(advAuthKey, advAuthKeyFips, ADVAUTH_KEY_LEN);
+    
+    if (AdvAuth_Check(ADVAUTH_ORDER_FIPS) != 0u) {
+        advAuthOrder = ADVAUTH_ORDER_FIPS;
+    } else if (AdvAuth_Check(ADVAUTH_ORDER_REVERSED) != 0u) {
+        advAuthOrder = ADVAUTH_ORDER_REVERSED;
+        AdvAuth_Reverse(advAuthKey);
+    } else {
+        advAuthOrder = ADVAUTH_ORDER_NONE;
+        return 1u;
+    }
+    return 0u;
+}
+
+/*******************************************************************************
+* Function Name: AdvAuth_SetEpoch
+********************************************************************************
+*
+* Summary:
+*  This routine sets the boot count that is held in flash. The boot count is
+*  part of the nonce, and a reset before it is saved would reuse it, so only
+*  samples carrying this boot count are signed.
+*
+* Parameters:
+*  uint16 bootCount: Boot count just written to flash
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void AdvAuth_SetEpoch(uint16 bootCount)
+{
+    advAuthEpoch = bootCount;
+    advAuthEpochValid = 1u;
+}
+
+/*******************************************************************************
+* Function Name: AdvAuth_Sign
+********************************************************************************
+*
+* Summary:
+*  This routine computes the AES-CCM MIC over the signed part of the
+*  manufacturer data, as laid out in advfmt.h: CBC-MAC over B0, the
+*  additional data and the data, encrypted with counter block A0. The device
+*  address, boot count and sequence form the nonce, so a (boot count,
+*  sequence) pair must never repeat under one key. A sample is refused before
+*  AdvAuth_Start() succeeded or if its boot count is not the saved epoch.
+*
+* Parameters:
+*  const uint8* data: ADVFMT_AUTH_DATA_LEN bytes starting at the version byte
+*  uint16 bootCount: Boot count of the sample
+*  uint16 sequence: Sequence number of the sample
+*  uint8* mic: ADVFMT_EXT_AUTH_LEN bytes MIC
+*
+* Return:
+*  uint8_t error: 1 = not signed, 0 = MIC written
+*
+*******************************************************************************/
+uint8_t AdvAuth_Sign(const uint8* data, uint16 bootCount, uint16 sequence, uint8* mic)
+{
+    uint8 x[ADVAUTH_BLOCK_LEN];
+    uint8 a[ADVAUTH_BLOCK_LEN];
+    uint8 error = 0u;
+    uint8 i;
+    uint8 j;
+    uint32 start = CySysTickGetValue();
+
+    if ((advAuthOrder == ADVAUTH_ORDER_NONE) || (advAuthEpochValid == 0u) || (bootCount != advAuthEpoch)) {
+        return 1u;
+    }
+
+    advAuthNonce[ADVFMT_AUTH_NONCE_BOOT_OFFSET] = LO8(bootCount);
+    advAuthNonce[ADVFMT_AUTH_NONCE_BOOT_OFFSET + 1u] = HI8(bootCount);
+    advAuthNonce[ADVFMT_AUTH_NONCE_SEQUENCE_OFFSET] = LO8(sequence);
+    advAuthNonce[ADVFMT_AUTH_NONCE_SEQUENCE_OFFSET + 1u] = HI8(sequence);
+
+    /* B0: flags, nonce, data length */
+    x[0] = ADVAUTH_B0_FLAGS;
+    (void)memcpy(&x[1], advAuthNonce, ADVFMT_AUTH_NONCE_LEN);
+    x[ADVAUTH_BLOCK_LEN - 2u] = 0u;
+    x[ADVAUTH_BLOCK_LEN - 1u] = ADVFMT_AUTH_DATA_LEN;
+    error |= AdvAuth_Encrypt(x, advAuthKey, advAuthOrder);
+
+    /* With ADVFMT_AUTH_AAD_LEN at 0 there is no additional data block */
+    for (i = 0u; i < ADVFMT_AUTH_DATA_LEN; i += ADVAUTH_BLOCK_LEN) {
+        for (j = 0u; (j < ADVAUTH_BLOCK_LEN) && ((i + j) < ADVFMT_AUTH_DATA_LEN); j++) {
+            x[j] ^= data[i + j];
+        }
+        error |= AdvAuth_Encrypt(x, advAuthKey, advAuthOrder);
+    }
+
+    /* A0: flags, nonce, counter 0 */
+    (void)memset(a, 0, sizeof(a));
+    a[0] = ADVAUTH_A0_FLAGS;
+    (void)memcpy(&a[1], advAuthNonce, ADVFMT_AUTH_NONCE_LEN);
+    error |= AdvAuth_Encrypt(a, advAuthKey, advAuthOrder);
+
+    for (i = 0u; i < ADVFMT_EXT_AUTH_LEN; i++) {
+        mic[i] = x[i] ^ a[i];
+    }
+
+    /* SysTick counts down, see Energy_Init() */
+    advAuthLastCycles = (start - CySysTickGetValue()) & SYSTICK_MASK;
+    if (advAuthLastCycles > advAuthMaxCycles) {
+        advAuthMaxCycles = advAuthLastCycles;
+    }
+
+    return error;
+}
+
+/*******************************************************************************
+* Function Name: AdvAuth_GetCost
+********************************************************************************
+*
+* Summary:
+*  This routine returns the measured cost of AdvAuth_Sign() in SYSCLK cycles.
+*  Needs the free-running SysTick started by Energy_Init().
+*
+* Parameters:
+*  uint32* lastCycles: Cycles taken by the last call
+*  uint32* maxCycles: Most cycles taken by any call
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void AdvAuth_GetCost(uint32* lastCycles, uint32* maxCycles)
+{
+    *lastCycles = advAuthLastCycles;
+    *maxCycles = advAuthMaxCycles;
+}
+
+#endif /* (ADVAUTH_ENABLED) */
+
+/* [] END OF FILE */
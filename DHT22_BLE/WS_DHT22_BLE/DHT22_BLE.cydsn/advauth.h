@@ -0,0 +1,51 @@
+/* ========================================
+ * Filename:        advauth.h
+ * Description:     Authenticated ADV payload using the BLESS AES engine header file
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+#include <project.h>
+
+#ifndef __ADVAUTH_H
+#define __ADVAUTH_H
+
+/***************************************
+*        API Constants
+***************************************/
+#ifndef ADVAUTH_ENABLED
+    #define ADVAUTH_ENABLED                         (0u)  /* 1 = append a MIC to the manufacturer data */
+#endif /* ADVAUTH_ENABLED */
+
+#define ADVAUTH_KEY_LEN                             (16u)
+
+/* The per-deployment AES-128 key shared with the gateways is not part of the
+ * repository. Create advauth_key.h next to this file with
+ *  #define ADVAUTH_KEY { 16 comma-separated bytes }
+ * advauth_key.h is ignored by git. */
+#if (ADVAUTH_ENABLED)
+    #include "advauth_key.h"
+    #ifndef ADVAUTH_KEY
+        #error "advauth_key.h must define ADVAUTH_KEY"
+    #endif /* ADVAUTH_KEY */
+#endif /* (ADVAUTH_ENABLED) */
+
+/***************************************
+*        Function Prototypes
+***************************************/
+#if (ADVAUTH_ENABLED)
+    void    AdvAuth_Init(void);                                         // Read the device ID
+    uint8_t AdvAuth_Start(void);                                        // Check the AES engine at CYBLE_EVT_STACK_ON, 1 = unusable
+    void    AdvAuth_SetEpoch(uint16 bootCount);                         // Boot count now held in flash, only it is signed
+    uint8_t AdvAuth_Sign(const uint8* data, uint16 bootCount, uint16 sequence, uint8* mic);  // 1 = not signed
+    void    AdvAuth_GetCost(uint32* lastCycles, uint32* maxCycles);    // SYSCLK cycles per AdvAuth_Sign()
+#else
+    #define AdvAuth_Init()
+    #define AdvAuth_Start()                         (0u)
+    #define AdvAuth_SetEpoch(bootCount)
+#endif /* (ADVAUTH_ENABLED) */
+#endif
+
+
+
+/* [] END OF FILE */
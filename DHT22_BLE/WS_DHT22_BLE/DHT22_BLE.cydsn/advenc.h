@@ -0,0 +1,46 @@
+/* ========================================
+ * Filename:        advenc.h
+ * Description:     Advertising payload encoder interface header file
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+#include <project.h>
+#include "advfmt.h"
+
+#ifndef __ADVENC_H
+#define __ADVENC_H
+
+/***************************************
+*        API Constants
+***************************************/
+#define ADV_ENCODER_NAME                            (0u)  /* "DHT22 xx.xC xx%" in the local name */
+#define ADV_ENCODER_BTHOME                          (1u)  /* BTHome v2 service data */
+#define ADV_ENCODER_EDDYSTONE_TLM                   (2u)  /* Eddystone-TLM frame */
+#define ADV_ENCODER_MANUFACTURER                    (3u)  /* Versioned binary manufacturer data, see advfmt.h */
+
+/* Build-time encoder selection, only the selected encoder is compiled in */
+#define ADV_ENCODER                                 (ADV_ENCODER_MANUFACTURER)
+
+/* Reading handed to the encoder */
+typedef struct
+{
+    int16   temperatureX10;                         /* 0.1C */
+    uint16  humidityX10;                            /* 0.1%RH */
+    uint32  sampleCount;                            /* Readings since boot */
+    uint32  uptimeDs;                               /* 0.1s since boot */
+    uint32  advCount;                               /* ADV payload updates that went on air since boot */
+    uint8   status;                                 /* ADVFMT_FLAG_x */
+    uint16  bootCount;                              /* Boots since the NV record was created */
+} ADV_SAMPLE_T;
+
+/***************************************
+*        Function Prototypes
+***************************************/
+    void    AdvEnc_Init(CYBLE_GAPP_DISC_DATA_T* advData);                                // Load the encoder's ADV template
+    void    AdvEnc_Encode(CYBLE_GAPP_DISC_DATA_T* advData, const ADV_SAMPLE_T* sample);  // Write a reading into the ADV data
+#endif
+
+
+
+/* [] END OF FILE */
@@ -0,0 +1,123 @@
+/* ========================================
+ * Filename:        advenc_bthome.c
+ * Description:     BTHome v2 advertising payload encoder source file
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+
+#include "advenc.h"
+
+#if (ADV_ENCODER == ADV_ENCODER_BTHOME)
+
+#include <string.h>
+
+/***************************************
+*        API Constants
+***************************************/
+#define BTHOME_UUID                                 (0xFCD2u)
+#define BTHOME_DEVICE_INFO                          (0x40u)  /* Version 2, unencrypted, regular interval */
+#define BTHOME_ID_TEMPERATURE                       (0x02u)  /* sint16, 0.01C */
+#define BTHOME_ID_HUMIDITY                          (0x03u)  /* uint16, 0.01% */
+
+/* ADV payload data structure: flags, service data, short local name. The
+ * service data carries the objects only once there is a reading; BTHome has
+ * no no-data value, and a zero would be logged as a real 0.00C / 0%RH. */
+#define BTHOME_AD_OFFSET                            (3u)
+#define BTHOME_OBJECTS_OFFSET                       (BTHOME_AD_OFFSET + 5u)  /* After the UUID and device info */
+
+static const uint8 advTemplate[] =
+{
+    0x02u, 0x01u, 0x06u,                            /* Flags: LE General Discoverable, BR/EDR not supported */
+    0x04u, 0x16u,                                   /* Service data - 16-bit UUID, no objects */
+    LO8(BTHOME_UUID), HI8(BTHOME_UUID),
+    BTHOME_DEVICE_INFO
+};
+
+static const uint8 advName[] =
+{
+    0x06u, 0x08u, 'D', 'H', 'T', '2', '2'           /* Shortened local name */
+};
+
+/*******************************************************************************
+* Function Name: BTHome_Finish
+********************************************************************************
+*
+* Summary:
+*  This routine closes the service data after its last object and appends
+*  the local name.
+*
+* Parameters:
+*  CYBLE_GAPP_DISC_DATA_T* advData: ADV data to update
+*  uint8 len: Length of the ADV data up to the end of the service data
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void BTHome_Finish(CYBLE_GAPP_DISC_DATA_T* advData, uint8 len)
+{
+    advData->advData[BTHOME_AD_OFFSET] = (uint8)(len - BTHOME_AD_OFFSET - 1u);
+    (void)memcpy(&advData->advData[len], advName, sizeof(advName));
+    advData->advDataLen = len + sizeof(advName);
+}
+
+/*******************************************************************************
+* Function Name: AdvEnc_Init
+********************************************************************************
+*
+* Summary:
+*  This routine loads the BTHome v2 template, without objects, into the ADV
+*  data.
+*
+* Parameters:
+*  CYBLE_GAPP_DISC_DATA_T* advData: ADV data to initialize
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void AdvEnc_Init(CYBLE_GAPP_DISC_DATA_T* advData)
+{
+    (void)memcpy(advData->advData, advTemplate, sizeof(advTemplate));
+    BTHome_Finish(advData, sizeof(advTemplate));
+}
+
+/*******************************************************************************
+* Function Name: AdvEnc_Encode
+********************************************************************************
+*
+* Summary:
+*  This routine writes a reading as BTHome temperature and humidity objects
+*  (little endian, 0.01 resolution). Without a reading only the device info
+*  is sent.
+*
+* Parameters:
+*  CYBLE_GAPP_DISC_DATA_T* advData: ADV data to update
+*  const ADV_SAMPLE_T* sample: Reading to encode
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void AdvEnc_Encode(CYBLE_GAPP_DISC_DATA_T* advData, const ADV_SAMPLE_T* sample)
+{
+    uint16 temperature = (uint16)(sample->temperatureX10 * 10);
+    uint16 humidity = (uint16)(sample->humidityX10 * 10u);
+    uint8* data = advData->advData;
+    uint8 len = BTHOME_OBJECTS_OFFSET;
+    
+    if ((sample->status & ADVFMT_FLAG_NO_DATA) == 0u) {
+        data[len++] = BTHOME_ID_TEMPERATURE;
+        data[len++] = LO8(temperature);
+        data[len++] = HI8(temperature);
+        data[len++] = BTHOME_ID_HUMIDITY;
+        data[len++] = LO8(humidity);
+        data[len++] = HI8(humidity);
+    }
+    BTHome_Finish(advData, len);
+}
+
+#endif /* (ADV_ENCODER == ADV_ENCODER_BTHOME) */
+
+/* [] END OF FILE */
@@ -0,0 +1,122 @@
+/* ========================================
+ * Filename:        advenc_eddystone.c
+ * Description:     Eddystone-TLM advertising payload encoder source file
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+
+#include "advenc.h"
+
+#if (ADV_ENCODER == ADV_ENCODER_EDDYSTONE_TLM)
+
+#include <string.h>
+
+/***************************************
+*        API Constants
+***************************************/
+#define EDDYSTONE_UUID                              (0xFEAAu)
+#define EDDYSTONE_FRAME_TLM                         (0x20u)
+#define EDDYSTONE_TLM_VERSION                       (0x00u)  /* Unencrypted TLM */
+
+/* ADV payload data structure: flags, service UUID list, service data */
+#define EDDYSTONE_AD_OFFSET                         (7u)
+#define EDDYSTONE_VBATT_OFFSET                      (EDDYSTONE_AD_OFFSET + 6u)
+#define EDDYSTONE_TEMP_OFFSET                       (EDDYSTONE_AD_OFFSET + 8u)
+#define EDDYSTONE_ADV_CNT_OFFSET                    (EDDYSTONE_AD_OFFSET + 10u)
+#define EDDYSTONE_SEC_CNT_OFFSET                    (EDDYSTONE_AD_OFFSET + 14u)
+
+static const uint8 advTemplate[] =
+{
+    0x02u, 0x01u, 0x06u,                            /* Flags: LE General Discoverable, BR/EDR not supported */
+    0x03u, 0x03u, LO8(EDDYSTONE_UUID), HI8(EDDYSTONE_UUID),  /* Complete list of 16-bit UUIDs */
+    0x11u, 0x16u, LO8(EDDYSTONE_UUID), HI8(EDDYSTONE_UUID),  /* Service data - 16-bit UUID */
+    EDDYSTONE_FRAME_TLM, EDDYSTONE_TLM_VERSION,
+    0x00u, 0x00u,                                   /* VBATT, 0 = not supported */
+    0x80u, 0x00u,                                   /* TEMP, 0x8000 = not supported */
+    0x00u, 0x00u, 0x00u, 0x00u,                     /* ADV_CNT */
+    0x00u, 0x00u, 0x00u, 0x00u                      /* SEC_CNT */
+};
+
+/*******************************************************************************
+* Function Name: Eddystone_PutBe32
+********************************************************************************
+*
+* Summary:
+*  This routine stores a 32-bit value big endian, as Eddystone requires.
+*
+* Parameters:
+*  uint8* dst: Destination
+*  uint32 value: Value to store
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Eddystone_PutBe32(uint8* dst, uint32 value)
+{
+    dst[0] = (uint8)(value >> 24u);
+    dst[1] = (uint8)(value >> 16u);
+    dst[2] = (uint8)(value >> 8u);
+    dst[3] = (uint8)value;
+}
+
+/*******************************************************************************
+* Function Name: AdvEnc_Init
+********************************************************************************
+*
+* Summary:
+*  This routine loads the Eddystone-TLM template into the ADV data.
+*
+* Parameters:
+*  CYBLE_GAPP_DISC_DATA_T* advData: ADV data to initialize
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void AdvEnc_Init(CYBLE_GAPP_DISC_DATA_T* advData)
+{
+    (void)memcpy(advData->advData, advTemplate, sizeof(advTemplate));
+    advData->advDataLen = sizeof(advTemplate);
+}
+
+/*******************************************************************************
+* Function Name: AdvEnc_Encode
+********************************************************************************
+*
+* Summary:
+*  This routine writes a reading into the TLM frame. TEMP is signed 8.8 fixed
+*  point: x10 * 25.6 is done as (x10 * 6554) >> 8 to avoid a division. TLM has
+*  no humidity field. ADV_CNT should count advertising events since boot, but
+*  the stack does not report them; it carries the payload updates committed
+*  since boot instead, which only grows, so a gateway still sees no reset.
+*
+* Parameters:
+*  CYBLE_GAPP_DISC_DATA_T* advData: ADV data to update
+*  const ADV_SAMPLE_T* sample: Reading to encode
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void AdvEnc_Encode(CYBLE_GAPP_DISC_DATA_T* advData, const ADV_SAMPLE_T* sample)
+{
+    int32 magnitude = (sample->temperatureX10 < 0) ? -(int32)sample->temperatureX10 : sample->temperatureX10;
+    int32 temp88 = (int32)(((uint32)magnitude * 6554u) >> 8u);
+    uint16 temp = (uint16)((sample->temperatureX10 < 0) ? -temp88 : temp88);
+    
+    /* 0x8000 tells the receiver the temperature is not supported */
+    if ((sample->status & ADVFMT_FLAG_NO_DATA) != 0u) {
+        temp = 0x8000u;
+    }
+    
+    advData->advData[EDDYSTONE_TEMP_OFFSET] = HI8(temp);
+    advData->advData[EDDYSTONE_TEMP_OFFSET + 1u] = LO8(temp);
+    Eddystone_PutBe32(&advData->advData[EDDYSTONE_ADV_CNT_OFFSET], sample->advCount);
+    Eddystone_PutBe32(&advData->advData[EDDYSTONE_SEC_CNT_OFFSET], sample->uptimeDs);
+}
+
+#endif /* (ADV_ENCODER == ADV_ENCODER_EDDYSTONE_TLM) */
+
+/* [] END OF FILE */
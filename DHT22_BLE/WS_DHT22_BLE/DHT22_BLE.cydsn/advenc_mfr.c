@@ -0,0 +1,216 @@
+/* ========================================
+ * Filename:        advenc_mfr.c
+ * Description:     Manufacturer specific data advertising payload encoder source file
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+
+#include "advenc.h"
+
+#if (ADV_ENCODER == ADV_ENCODER_MANUFACTURER)
+
+#include "advfmt.h"
+#include "advauth.h"
+#include <string.h>
+
+/***************************************
+*        API Constants
+***************************************/
+/* ADV payload data structure: flags, manufacturer specific data (see advfmt.h) */
+#define MFR_AD_OFFSET                               (3u)
+#define MFR_DATA_OFFSET                             (MFR_AD_OFFSET + 4u)
+#define MFR_SEQUENCE_OFFSET                         (ADVFMT_EXT_OFFSET + ADVFMT_EXT_HEADER_LEN)
+#if (ADVAUTH_ENABLED)
+    #define MFR_AUTH_OFFSET                         (MFR_SEQUENCE_OFFSET + ADVFMT_EXT_SEQUENCE_LEN + ADVFMT_EXT_HEADER_LEN)
+    #define MFR_HISTORY_OFFSET                      (MFR_AUTH_OFFSET + ADVFMT_EXT_AUTH_LEN + ADVFMT_EXT_HEADER_LEN)
+#else
+    #define MFR_HISTORY_OFFSET                      (MFR_SEQUENCE_OFFSET + ADVFMT_EXT_SEQUENCE_LEN + ADVFMT_EXT_HEADER_LEN)
+#endif /* (ADVAUTH_ENABLED) */
+
+/* The history fills whatever the ADV data has left */
+#define MFR_HISTORY_DEPTH                           ((CYBLE_GAP_MAX_ADV_DATA_LEN - MFR_DATA_OFFSET - MFR_HISTORY_OFFSET) / ADVFMT_HISTORY_ENTRY_LEN)
+#define MFR_HISTORY_LEN                             (MFR_HISTORY_DEPTH * ADVFMT_HISTORY_ENTRY_LEN)
+#define MFR_AD_LEN                                  (3u + MFR_HISTORY_OFFSET + MFR_HISTORY_LEN)
+
+/* Previous readings, the history is encoded as deltas against the current one */
+typedef struct
+{
+    int16   temperatureX10;
+    uint16  humidityX10;
+    uint8   valid;
+} MFR_HISTORY_T;
+
+static const uint8 advTemplate[] =
+{
+    0x02u, 0x01u, 0x06u,                            /* Flags: LE General Discoverable, BR/EDR not supported */
+    MFR_AD_LEN, ADVFMT_AD_TYPE,
+    LO8(ADVFMT_COMPANY_ID), HI8(ADVFMT_COMPANY_ID),
+    ADVFMT_VERSION,
+    ADVFMT_FLAG_NO_DATA,
+    LO8(ADVFMT_TEMPERATURE_NO_DATA), HI8(ADVFMT_TEMPERATURE_NO_DATA),
+    LO8(ADVFMT_HUMIDITY_NO_DATA), HI8(ADVFMT_HUMIDITY_NO_DATA),
+    ADVFMT_EXT_SEQUENCE, ADVFMT_EXT_SEQUENCE_LEN,
+    0x00u, 0x00u, 0x00u, 0x00u,
+#if (ADVAUTH_ENABLED)
+    ADVFMT_EXT_AUTH, ADVFMT_EXT_AUTH_LEN,
+    0x00u, 0x00u, 0x00u, 0x00u,
+#endif /* (ADVAUTH_ENABLED) */
+    ADVFMT_EXT_HISTORY, MFR_HISTORY_LEN
+};
+
+static MFR_HISTORY_T mfrHistory[MFR_HISTORY_DEPTH];
+static uint8 mfrHistoryHead = 0u;                   /* Slot of the most recent reading */
+static MFR_HISTORY_T mfrCurrent;
+
+/*******************************************************************************
+* Function Name: Mfr_Delta
+********************************************************************************
+*
+* Summary:
+*  This routine returns the signed 8-bit delta between two readings, or
+*  ADVFMT_HISTORY_MISSING if it does not fit.
+*
+* Parameters:
+*  int32 value: Past reading
+*  int32 reference: Current reading
+*
+* Return:
+*  uint8: Delta as int8
+*
+*******************************************************************************/
+static uint8 Mfr_Delta(int32 value, int32 reference)
+{
+    int32 delta = value - reference;
+    
+    if ((delta < -127) || (delta > 127)) {
+        return ADVFMT_HISTORY_MISSING;
+    }
+    return (uint8)delta;
+}
+
+/*******************************************************************************
+* Function Name: Mfr_Temperature
+********************************************************************************
+*
+* Summary:
+*  This routine scales a reading from 0.1C to the 0.01C of the payload. A
+*  sample without data gets ADVFMT_TEMPERATURE_NO_DATA, and other readings
+*  are saturated so that they can neither wrap nor become the sentinel.
+*
+* Parameters:
+*  const ADV_SAMPLE_T* sample: Reading to encode
+*
+* Return:
+*  int16: Temperature in 0.01C
+*
+*******************************************************************************/
+static int16 Mfr_Temperature(const ADV_SAMPLE_T* sample)
+{
+    int32 temperature = sample->temperatureX10;
+    
+    if ((sample->status & ADVFMT_FLAG_NO_DATA) != 0u) {
+        return ADVFMT_TEMPERATURE_NO_DATA;
+    }
+    if (temperature > (INT16_MAX / 10)) {
+        temperature = INT16_MAX / 10;
+    } else if (temperature < -(INT16_MAX / 10)) {
+        temperature = -(INT16_MAX / 10);
+    }
+    return (int16)(temperature * 10);
+}
+
+/*******************************************************************************
+* Function Name: AdvEnc_Init
+********************************************************************************
+*
+* Summary:
+*  This routine loads the manufacturer specific data template into the ADV data.
+*
+* Parameters:
+*  CYBLE_GAPP_DISC_DATA_T* advData: ADV data to initialize
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void AdvEnc_Init(CYBLE_GAPP_DISC_DATA_T* advData)
+{
+    (void)memcpy(advData->advData, advTemplate, sizeof(advTemplate));
+    (void)memset(&advData->advData[sizeof(advTemplate)], ADVFMT_HISTORY_MISSING, MFR_HISTORY_LEN);
+    advData->advDataLen = sizeof(advTemplate) + MFR_HISTORY_LEN;
+}
+
+/*******************************************************************************
+* Function Name: AdvEnc_Encode
+********************************************************************************
+*
+* Summary:
+*  This routine writes a reading into the manufacturer specific data, along
+*  with the previous MFR_HISTORY_DEPTH readings as deltas. Every call is a new
+*  sample, so the reading it replaces moves into the history.
+*
+* Parameters:
+*  CYBLE_GAPP_DISC_DATA_T* advData: ADV data to update
+*  const ADV_SAMPLE_T* sample: Reading to encode
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void AdvEnc_Encode(CYBLE_GAPP_DISC_DATA_T* advData, const ADV_SAMPLE_T* sample)
+{
+    uint8* data = &advData->advData[MFR_DATA_OFFSET];
+    int16 temperature = Mfr_Temperature(sample);
+    uint16 humidity = ((sample->status & ADVFMT_FLAG_NO_DATA) != 0u) ? ADVFMT_HUMIDITY_NO_DATA : sample->humidityX10;
+    uint8 slot;
+    uint8 i;
+    
+    data[ADVFMT_FLAGS_OFFSET] = sample->status;
+    data[ADVFMT_TEMPERATURE_OFFSET] = LO8(temperature);
+    data[ADVFMT_TEMPERATURE_OFFSET + 1u] = HI8(temperature);
+    data[ADVFMT_HUMIDITY_OFFSET] = LO8(humidity);
+    data[ADVFMT_HUMIDITY_OFFSET + 1u] = HI8(humidity);
+    
+    /* (boot, sequence) identifies a sample, so scanners can drop repeats and count gaps */
+    data[MFR_SEQUENCE_OFFSET] = LO8(sample->bootCount);
+    data[MFR_SEQUENCE_OFFSET + 1u] = HI8(sample->bootCount);
+    data[MFR_SEQUENCE_OFFSET + 2u] = LO8(LO16(sample->sampleCount));
+    data[MFR_SEQUENCE_OFFSET + 3u] = HI8(LO16(sample->sampleCount));
+    
+#if (ADVAUTH_ENABLED)
+    /* Let gateways reject spoofed readings. A sample that is not signed, e.g.
+     * before its boot count is in flash, gets a zero MIC rather than a stale one */
+    if (AdvAuth_Sign(data, sample->bootCount, LO16(sample->sampleCount), &data[MFR_AUTH_OFFSET]) != 0u) {
+        (void)memset(&data[MFR_AUTH_OFFSET], 0, ADVFMT_EXT_AUTH_LEN);
+    }
+#endif /* (ADVAUTH_ENABLED) */
+    
+    /* Push the previous reading into the history. Only fresh readings are
+     * kept; repeats of the last valid one after a failed read are not. The
+     * deltas are taken against the advertised reading even if it is stale. */
+    mfrHistoryHead = (mfrHistoryHead == 0u) ? (MFR_HISTORY_DEPTH - 1u) : (mfrHistoryHead - 1u);
+    mfrHistory[mfrHistoryHead] = mfrCurrent;
+    mfrCurrent.temperatureX10 = sample->temperatureX10;
+    mfrCurrent.humidityX10 = sample->humidityX10;
+    mfrCurrent.valid = (sample->status == 0u) ? 1u : 0u;
+    
+    slot = mfrHistoryHead;
+    for (i = 0u; i < MFR_HISTORY_LEN; i += ADVFMT_HISTORY_ENTRY_LEN) {
+        uint8 dt = ADVFMT_HISTORY_MISSING;
+        uint8 dh = ADVFMT_HISTORY_MISSING;
+        
+        if (mfrHistory[slot].valid != 0u) {
+            dt = Mfr_Delta(mfrHistory[slot].temperatureX10, mfrCurrent.temperatureX10);
+            dh = Mfr_Delta(mfrHistory[slot].humidityX10, mfrCurrent.humidityX10);
+        }
+        data[MFR_HISTORY_OFFSET + i] = dt;
+        data[MFR_HISTORY_OFFSET + i + 1u] = dh;
+        
+        slot = (slot == (MFR_HISTORY_DEPTH - 1u)) ? 0u : (slot + 1u);
+    }
+}
+
+#endif /* (ADV_ENCODER == ADV_ENCODER_MANUFACTURER) */
+
+/* [] END OF FILE */
@@ -0,0 +1,92 @@
+/* ========================================
+ * Filename:        advenc_name.c
+ * Description:     Local name advertising payload encoder source file
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+
+#include "advenc.h"
+
+#if (ADV_ENCODER == ADV_ENCODER_NAME)
+
+#include "fmt.h"
+#include <string.h>
+
+/***************************************
+*        API Constants
+***************************************/
+#define NAME_PREFIX                                 "DHT22 "
+#define NAME_PREFIX_LEN                             (sizeof(NAME_PREFIX) - 1u)
+
+/* ADV payload data structure: flags, then the local name "DHT22 xx.xC xx%" */
+#define NAME_AD_OFFSET                              (3u)
+#define NAME_OFFSET                                 (NAME_AD_OFFSET + 2u)
+
+static const uint8 advTemplate[] =
+{
+    0x02u, 0x01u, 0x06u,                            /* Flags: LE General Discoverable, BR/EDR not supported */
+    0x10u, 0x09u,                                   /* Complete local name, 15 chars */
+    'D', 'H', 'T', '2', '2', ' ', 'x', 'x', '.', 'x', 'C', ' ', 'x', 'x', '%'
+};
+
+/*******************************************************************************
+* Function Name: AdvEnc_Init
+********************************************************************************
+*
+* Summary:
+*  This routine loads the placeholder "DHT22 xx.xC xx%" name into the ADV data.
+*
+* Parameters:
+*  CYBLE_GAPP_DISC_DATA_T* advData: ADV data to initialize
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void AdvEnc_Init(CYBLE_GAPP_DISC_DATA_T* advData)
+{
+    (void)memcpy(advData->advData, advTemplate, sizeof(advTemplate));
+    advData->advDataLen = sizeof(advTemplate);
+}
+
+/*******************************************************************************
+* Function Name: AdvEnc_Encode
+********************************************************************************
+*
+* Summary:
+*  This routine rebuilds the local name from a reading. The length changes
+*  for negative or three-digit values.
+*
+* Parameters:
+*  CYBLE_GAPP_DISC_DATA_T* advData: ADV data to update
+*  const ADV_SAMPLE_T* sample: Reading to encode
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void AdvEnc_Encode(CYBLE_GAPP_DISC_DATA_T* advData, const ADV_SAMPLE_T* sample)
+{
+    uint8_t* advName = &advData->advData[NAME_OFFSET];
+    uint8_t len = NAME_PREFIX_LEN;
+    
+    /* Keep the placeholder until the first reading */
+    if ((sample->status & ADVFMT_FLAG_NO_DATA) != 0u) {
+        return;
+    }
+    
+    (void)memcpy(advName, NAME_PREFIX, NAME_PREFIX_LEN);
+    len += FMT_FixedX10((char*)&advName[len], sample->temperatureX10, 2u);
+    advName[len++] = 'C';
+    advName[len++] = ' ';
+    len += FMT_Unsigned((char*)&advName[len], (uint16_t)FMT_DIV10(sample->humidityX10), 2u);
+    advName[len++] = '%';
+    
+    advData->advData[NAME_AD_OFFSET] = len + 1u;
+    advData->advDataLen = NAME_OFFSET + len;
+}
+
+#endif /* (ADV_ENCODER == ADV_ENCODER_NAME) */
+
+/* [] END OF FILE */
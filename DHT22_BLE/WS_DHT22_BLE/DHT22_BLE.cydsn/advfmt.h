@@ -0,0 +1,100 @@
+/* ========================================
+ * Filename:        advfmt.h
+ * Description:     Binary manufacturer specific ADV data wire format header file
+ *                  Shared by the firmware encoder and the host reference decoder,
+ *                  so it must only depend on <stdint.h>.
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+#include <stdint.h>
+
+#ifndef __ADVFMT_H
+#define __ADVFMT_H
+
+/***************************************
+*        API Constants
+***************************************/
+#define ADVFMT_AD_TYPE                              (0xFFu)    /* Manufacturer specific data */
+#define ADVFMT_COMPANY_ID                           (0xFFFFu)  /* Reserved for internal use / testing */
+#define ADVFMT_VERSION                              (0x01u)
+
+/* Manufacturer data layout, all fields little endian. Offsets are relative to
+ * the first byte after the 16-bit company ID.
+ *
+ *  0       version     ADVFMT_VERSION
+ *  1       flags       ADVFMT_FLAG_x
+ *  2..3    int16       temperature, 0.01C
+ *  4..5    uint16      humidity, 0.1%RH
+ *  6..     extensions  [type][len][len bytes of data], repeated
+ *
+ * Decoders must skip extensions with an unknown type using their length. */
+#define ADVFMT_VERSION_OFFSET                       (0u)
+#define ADVFMT_FLAGS_OFFSET                         (1u)
+#define ADVFMT_TEMPERATURE_OFFSET                   (2u)
+#define ADVFMT_HUMIDITY_OFFSET                      (4u)
+#define ADVFMT_EXT_OFFSET                           (6u)
+#define ADVFMT_CORE_LEN                             (6u)
+#define ADVFMT_EXT_HEADER_LEN                       (2u)
+
+/* Extension types */
+#define ADVFMT_EXT_SEQUENCE                         (0x01u)  /* uint16 boot count, uint16 sample sequence */
+#define ADVFMT_EXT_SEQUENCE_LEN                     (4u)
+#define ADVFMT_EXT_HISTORY                          (0x02u)  /* Previous readings, newest first */
+
+/* History entry: int8 temperature delta (0.1C), int8 humidity delta (0.1%RH)
+ * against the current reading. Entry n is the sample with sequence - 1 - n.
+ * ADVFMT_HISTORY_MISSING in either byte marks a sample without a valid
+ * reading or with a delta out of range. */
+#define ADVFMT_HISTORY_ENTRY_LEN                    (2u)
+#define ADVFMT_HISTORY_MISSING                      (0x80u)
+
+/* Scan response manufacturer data: version, then extensions from offset 1 */
+#define ADVFMT_SCAN_RSP_EXT_OFFSET                  (1u)
+#define ADVFMT_EXT_STATS_SHORT                      (0x03u)  /* Statistics over the short window */
+#define ADVFMT_EXT_STATS_LONG                       (0x04u)  /* Statistics over the long window */
+
+/* Statistics extension, little endian:
+ *  0..1    uint16      window length, minutes
+ *  2..7    int16 x 3   temperature min, max, mean, 0.1C
+ *  8..10   uint8 x 3   humidity min, max, mean, 0.5%RH
+ * A window without samples has ADVFMT_TEMPERATURE_NO_DATA and
+ * ADVFMT_STATS_HUMIDITY_NO_DATA in every field. */
+#define ADVFMT_EXT_STATS_LEN                        (11u)
+#define ADVFMT_STATS_WINDOW_OFFSET                  (0u)
+#define ADVFMT_STATS_TEMPERATURE_OFFSET             (2u)
+#define ADVFMT_STATS_HUMIDITY_OFFSET                (8u)
+#define ADVFMT_STATS_HUMIDITY_NO_DATA               (0xFFu)
+
+/* Authentication extension, placed right after the sequence extension: a
+ * 4-byte AES-CCM (RFC 3610) MIC over the ADVFMT_AUTH_DATA_LEN bytes from the
+ * version byte (core fields and sequence extension), with a 2-byte length
+ * field and ADVFMT_AUTH_AAD_LEN bytes of additional data. Nonce:
+ *  0..5    device address, over-the-air (little endian) byte order
+ *  6..7    uint16 boot count
+ *  8..9    uint16 sequence
+ *  10..12  company ID, format version
+ * A sample the node does not sign carries an all-zero MIC. */
+#define ADVFMT_EXT_AUTH                             (0x05u)
+#define ADVFMT_EXT_AUTH_LEN                         (4u)
+#define ADVFMT_AUTH_DATA_LEN                        (ADVFMT_CORE_LEN + ADVFMT_EXT_HEADER_LEN + ADVFMT_EXT_SEQUENCE_LEN)
+#define ADVFMT_AUTH_AAD_LEN                         (0u)   /* No additional data, all signed fields are in the data or the nonce */
+#define ADVFMT_AUTH_NONCE_LEN                       (13u)
+#define ADVFMT_AUTH_NONCE_ADDR_OFFSET               (0u)
+#define ADVFMT_AUTH_NONCE_BOOT_OFFSET               (6u)
+#define ADVFMT_AUTH_NONCE_SEQUENCE_OFFSET           (8u)
+#define ADVFMT_AUTH_NONCE_DOMAIN_OFFSET             (10u)
+
+/* Status flags */
+#define ADVFMT_FLAG_SENSOR_ERROR                    (0x01u)  /* Last read failed, the reading is the last valid one */
+#define ADVFMT_FLAG_RESTORED                        (0x02u)  /* Reading restored from flash, not measured since boot */
+#define ADVFMT_FLAG_NO_DATA                         (0x04u)  /* No reading available yet */
+
+#define ADVFMT_TEMPERATURE_NO_DATA                  (-32768)
+#define ADVFMT_HUMIDITY_NO_DATA                     (0xFFFFu)
+
+#endif
+
+
+
+/* [] END OF FILE */
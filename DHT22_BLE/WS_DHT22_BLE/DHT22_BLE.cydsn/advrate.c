@@ -0,0 +1,294 @@
+/* ========================================
+ * Filename:        advrate.c
+ * Description:     Adaptive advertising interval policy source file
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+
+#include "advrate.h"
+#include "sched.h"
+#include "radio.h"
+
+/***************************************
+*        API Constants
+***************************************/
+#if (ADVRATE_MODE == ADVRATE_MODE_BROADCAST)
+    #define ADVRATE_ADV_TYPE                        (CYBLE_GAPP_NON_CONNECTABLE_UNDIRECTED_ADV)
+#elif (ADVRATE_MODE == ADVRATE_MODE_SCANNABLE)
+    #define ADVRATE_ADV_TYPE                        (CYBLE_GAPP_SCANNABLE_UNDIRECTED_ADV)
+#else
+    #define ADVRATE_ADV_TYPE                        (CYBLE_GAPP_CONNECTABLE_UNDIRECTED_ADV)
+#endif /* (ADVRATE_MODE == ADVRATE_MODE_BROADCAST) */
+
+static uint16 advRateIntervals[ADVRATE_LEVEL_COUNT][2] =
+{
+    { ADVRATE_FAST_INT_MIN, ADVRATE_FAST_INT_MAX },
+    { ADVRATE_SLOW_INT_MIN, ADVRATE_SLOW_INT_MAX },
+    { ADVRATE_IDLE_INT_MIN, ADVRATE_IDLE_INT_MAX }
+};
+
+static ADVRATE_LEVEL_T advRateLevel = ADVRATE_LEVEL_FAST;  /* Level wanted */
+static ADVRATE_LEVEL_T advRateActive = ADVRATE_LEVEL_FAST; /* Level advertising with */
+static int16 advRateLowX10 = ADVRATE_TEMPERATURE_LOW_X10;
+static int16 advRateHighX10 = ADVRATE_TEMPERATURE_HIGH_X10;
+static int16 advRateRefTemperatureX10 = 0;
+static uint16 advRateRefHumidityX10 = 0u;
+static uint8 advRateRefValid = 0u;
+
+/*******************************************************************************
+* Function Name: AdvRate_Zone
+********************************************************************************
+*
+* Summary:
+*  This routine returns which side of the thresholds a temperature is on.
+*
+* Parameters:
+*  int16 temperatureX10: Temperature x 10
+*
+* Return:
+*  uint8: 0 = below low, 1 = between, 2 = above high
+*
+*******************************************************************************/
+static uint8 AdvRate_Zone(int16 temperatureX10)
+{
+    if (temperatureX10 < advRateLowX10) {
+        return 0u;
+    }
+    return (temperatureX10 > advRateHighX10) ? 2u : 1u;
+}
+
+/*******************************************************************************
+* Function Name: AdvRate_SetLevel
+********************************************************************************
+*
+* Summary:
+*  This routine changes the wanted level. The interval of a running
+*  advertisement can't be changed, so advertising is stopped and restarted by
+*  the application from CYBLE_EVT_GAPP_ADVERTISEMENT_START_STOP through
+*  AdvRate_Start(). When not advertising the level is used on the next start.
+*
+* Parameters:
+*  ADVRATE_LEVEL_T level: Wanted level
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void AdvRate_SetLevel(ADVRATE_LEVEL_T level)
+{
+    advRateLevel = level;
+    
+    if ((CyBle_GetState() == CYBLE_STATE_ADVERTISING) && (advRateActive != level))
+    {
+        CyBle_GappStopAdvertisement();
+    }
+}
+
+/*******************************************************************************
+* Function Name: AdvRate_Init
+********************************************************************************
+*
+* Summary:
+*  This routine registers the decay task. Call before the BLE stack is started.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void AdvRate_Init(void)
+{
+    Sched_Register(SCHED_TASK_ADVRATE, &AdvRate_Task);
+}
+
+/*******************************************************************************
+* Function Name: AdvRate_Start
+********************************************************************************
+*
+* Summary:
+*  This routine starts advertising with the interval of the wanted level and
+*  the PDU type of ADVRATE_MODE, with no timeout. Idle advertising only
+*  carries low-priority updates and uses the low-priority channel map. The
+*  level decays on the scheduler instead of the stack's fast advertising
+*  timeout.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  CYBLE_API_RESULT_T: Result of CyBle_GappStartAdvertisement()
+*
+*******************************************************************************/
+CYBLE_API_RESULT_T AdvRate_Start(void)
+{
+    CYBLE_API_RESULT_T result;
+    
+    cyBle_discoveryModeInfo.advTo = 0u;
+    cyBle_discoveryModeInfo.advParam->advType = ADVRATE_ADV_TYPE;
+    cyBle_discoveryModeInfo.advParam->advChannelMap = Radio_GetChannelMap((advRateLevel == ADVRATE_LEVEL_IDLE) ? 1u : 0u);
+    cyBle_discoveryModeInfo.advParam->advIntvMin = advRateIntervals[advRateLevel][0];
+    cyBle_discoveryModeInfo.advParam->advIntvMax = advRateIntervals[advRateLevel][1];
+    
+    result = CyBle_GappStartAdvertisement(CYBLE_ADVERTISING_CUSTOM);
+    if (result == CYBLE_ERROR_OK)
+    {
+        advRateActive = advRateLevel;
+    }
+    
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: AdvRate_Burst
+********************************************************************************
+*
+* Summary:
+*  This routine switches to fast advertising for ADVRATE_BURST_MS, then decays
+*  to slow and, after ADVRATE_SETTLE_MS without another burst, to idle.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void AdvRate_Burst(void)
+{
+    AdvRate_SetLevel(ADVRATE_LEVEL_FAST);
+    Sched_Start(SCHED_TASK_ADVRATE, ADVRATE_BURST_MS, 0u);
+}
+
+/*******************************************************************************
+* Function Name: AdvRate_OnReading
+********************************************************************************
+*
+* Summary:
+*  This routine starts a burst if a valid reading crossed a temperature
+*  threshold or moved by more than a deadband since the last burst.
+*
+* Parameters:
+*  int16 temperatureX10: Temperature x 10
+*  uint16 humidityX10: Humidity x 10
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void AdvRate_OnReading(int16 temperatureX10, uint16 humidityX10)
+{
+    int16 dt = (int16)(temperatureX10 - advRateRefTemperatureX10);
+    int16 dh = (int16)(humidityX10 - advRateRefHumidityX10);
+    
+    if ((advRateRefValid == 0u) ||
+        (AdvRate_Zone(temperatureX10) != AdvRate_Zone(advRateRefTemperatureX10)) ||
+        (dt > (int16)ADVRATE_TEMPERATURE_DEADBAND_X10) || (-dt > (int16)ADVRATE_TEMPERATURE_DEADBAND_X10) ||
+        (dh > (int16)ADVRATE_HUMIDITY_DEADBAND_X10) || (-dh > (int16)ADVRATE_HUMIDITY_DEADBAND_X10))
+    {
+        advRateRefTemperatureX10 = temperatureX10;
+        advRateRefHumidityX10 = humidityX10;
+        advRateRefValid = 1u;
+        AdvRate_Burst();
+    }
+}
+
+/*******************************************************************************
+* Function Name: AdvRate_SetThresholds
+********************************************************************************
+*
+* Summary:
+*  This routine sets the temperatures whose crossing starts a burst.
+*
+* Parameters:
+*  int16 lowX10: Low threshold x 10
+*  int16 highX10: High threshold x 10
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void AdvRate_SetThresholds(int16 lowX10, int16 highX10)
+{
+    advRateLowX10 = lowX10;
+    advRateHighX10 = highX10;
+}
+
+/*******************************************************************************
+* Function Name: AdvRate_SetInterval
+********************************************************************************
+*
+* Summary:
+*  This routine changes the advertising interval of a level. When advertising
+*  at that level, advertising is restarted with the new interval.
+*
+* Parameters:
+*  ADVRATE_LEVEL_T level: Level to change
+*  uint16 intMin: Minimum interval in 0.625ms units
+*  uint16 intMax: Maximum interval in 0.625ms units
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void AdvRate_SetInterval(ADVRATE_LEVEL_T level, uint16 intMin, uint16 intMax)
+{
+    advRateIntervals[level][0] = intMin;
+    advRateIntervals[level][1] = intMax;
+    
+    if ((CyBle_GetState() == CYBLE_STATE_ADVERTISING) && (advRateActive == level))
+    {
+        CyBle_GappStopAdvertisement();
+    }
+}
+
+/*******************************************************************************
+* Function Name: AdvRate_GetLevel
+********************************************************************************
+*
+* Summary:
+*  This routine returns the wanted advertising level.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  ADVRATE_LEVEL_T: Current level
+*
+*******************************************************************************/
+ADVRATE_LEVEL_T AdvRate_GetLevel(void)
+{
+    return advRateLevel;
+}
+
+/*******************************************************************************
+* Function Name: AdvRate_Task
+********************************************************************************
+*
+* Summary:
+*  This routine decays the advertising level by one step: fast to slow, then
+*  slow to idle.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void AdvRate_Task(void)
+{
+    if (advRateLevel == ADVRATE_LEVEL_FAST)
+    {
+        AdvRate_SetLevel(ADVRATE_LEVEL_SLOW);
+        Sched_Start(SCHED_TASK_ADVRATE, ADVRATE_SETTLE_MS, 0u);
+    }
+    else
+    {
+        AdvRate_SetLevel(ADVRATE_LEVEL_IDLE);
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,75 @@
+/* ========================================
+ * Filename:        advrate.h
+ * Description:     Adaptive advertising interval policy header file
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+#include <project.h>
+
+#ifndef __ADVRATE_H
+#define __ADVRATE_H
+
+/***************************************
+*        API Constants
+***************************************/
+#define ADVRATE_MODE_CONNECTABLE                    (0u)  /* Connectable undirected, scan response and connections */
+#define ADVRATE_MODE_SCANNABLE                      (1u)  /* Scannable undirected, scan response only */
+#define ADVRATE_MODE_BROADCAST                      (2u)  /* Non-connectable, no RX window after the ADV PDUs */
+
+/* Build-time advertising mode. The two broadcaster-only modes never accept a
+ * connection, so main.c leaves out the GATT services, the log channel and the
+ * connection handling; with the linker's section garbage collection their
+ * code and RAM go too. The GATT database itself is generated: for the
+ * smallest footprint also set the GAP role to Broadcaster in the BLE
+ * component customizer, which drops the GATT server. */
+#define ADVRATE_MODE                                (ADVRATE_MODE_CONNECTABLE)
+
+/* Advertising intervals in 0.625ms units */
+#if (ADVRATE_MODE == ADVRATE_MODE_CONNECTABLE)
+    #define ADVRATE_FAST_INT_MIN                    (CYBLE_FAST_ADV_INT_MIN)  /* 20ms */
+    #define ADVRATE_FAST_INT_MAX                    (CYBLE_FAST_ADV_INT_MAX)  /* 30ms */
+#else
+    /* Scannable and non-connectable advertising can't go below 100ms */
+    #define ADVRATE_FAST_INT_MIN                    (0x00A0u)                 /* 100ms */
+    #define ADVRATE_FAST_INT_MAX                    (0x00B0u)                 /* 110ms */
+#endif /* (ADVRATE_MODE == ADVRATE_MODE_CONNECTABLE) */
+#define ADVRATE_SLOW_INT_MIN                        (CYBLE_SLOW_ADV_INT_MIN)  /* 1s */
+#define ADVRATE_SLOW_INT_MAX                        (CYBLE_SLOW_ADV_INT_MAX)  /* 1.1s */
+#define ADVRATE_IDLE_INT_MIN                        (0x2000u)                 /* 5.12s */
+#define ADVRATE_IDLE_INT_MAX                        (0x2100u)                 /* 5.28s */
+
+#define ADVRATE_BURST_MS                            (2000u)   /* Fast advertising after a change */
+#define ADVRATE_SETTLE_MS                           (60000u)  /* Slow advertising before going idle */
+
+/* A burst starts when a reading moves this far from the one that started the
+ * last burst, or crosses one of the temperature thresholds */
+#define ADVRATE_TEMPERATURE_DEADBAND_X10            (5u)      /* 0.5C */
+#define ADVRATE_HUMIDITY_DEADBAND_X10               (30u)     /* 3.0%RH */
+#define ADVRATE_TEMPERATURE_LOW_X10                 (0)       /* 0.0C */
+#define ADVRATE_TEMPERATURE_HIGH_X10                (300)     /* 30.0C */
+
+typedef enum
+{
+    ADVRATE_LEVEL_FAST = 0u,
+    ADVRATE_LEVEL_SLOW,
+    ADVRATE_LEVEL_IDLE,
+    ADVRATE_LEVEL_COUNT
+} ADVRATE_LEVEL_T;
+
+/***************************************
+*        Function Prototypes
+***************************************/
+    void    AdvRate_Init(void);                                             // Register the decay task
+    CYBLE_API_RESULT_T AdvRate_Start(void);                                 // Start advertising at the current level
+    void    AdvRate_Burst(void);                                            // Advertise fast, then decay
+    void    AdvRate_OnReading(int16 temperatureX10, uint16 humidityX10);    // Burst on a significant change
+    void    AdvRate_SetThresholds(int16 lowX10, int16 highX10);
+    void    AdvRate_SetInterval(ADVRATE_LEVEL_T level, uint16 intMin, uint16 intMax); // 0.625ms units
+    ADVRATE_LEVEL_T AdvRate_GetLevel(void);
+    void    AdvRate_Task(void);                                             // Scheduler task, do not call directly
+#endif
+
+
+
+/* [] END OF FILE */
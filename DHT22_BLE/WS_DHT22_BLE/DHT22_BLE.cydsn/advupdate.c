@@ -0,0 +1,245 @@
+/* ========================================
+ * Filename:        advupdate.c
+ * Description:     Deferred BLE advertising payload update source file
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+
+#include "advupdate.h"
+#include <string.h>
+
+/***************************************
+*        API Constants
+***************************************/
+#define ADV_PENDING_ADV_DATA                        (0x01u)
+#define ADV_PENDING_SCAN_RSP_DATA                   (0x02u)
+
+/* Staging copies of the ADV and scan response data, written by the application at any time */
+static CYBLE_GAPP_DISC_DATA_T stagedAdvData;
+static CYBLE_GAPP_SCAN_RSP_DATA_T stagedScanRspData;
+static volatile uint8_t updatePending = 0u;
+static uint32 updateCommitted = 0u;                 /* Updates that went on air */
+static uint32 updateSuperseded = 0u;                /* Staged updates replaced before they were committed */
+
+/*******************************************************************************
+* Function Name: ADV_Commit
+********************************************************************************
+*
+* Summary:
+*  This routine copies the pending staging copies into the live data.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void ADV_Commit(void)
+{
+    if ((updatePending & ADV_PENDING_ADV_DATA) != 0u)
+    {
+        (void)memcpy(cyBle_discoveryModeInfo.advData, &stagedAdvData, sizeof(stagedAdvData));
+    }
+    if ((updatePending & ADV_PENDING_SCAN_RSP_DATA) != 0u)
+    {
+        (void)memcpy(cyBle_discoveryModeInfo.scanRspData, &stagedScanRspData, sizeof(stagedScanRspData));
+    }
+}
+
+/*******************************************************************************
+* Function Name: ADV_BeginUpdate
+********************************************************************************
+*
+* Summary:
+*  This routine returns the staging copy of the ADV data. If no update is
+*  pending the staging copy is refreshed from the live ADV data first, so the
+*  caller only needs to modify the bytes that change.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  CYBLE_GAPP_DISC_DATA_T*: Pointer to the staging copy of the ADV data
+*
+*******************************************************************************/
+CYBLE_GAPP_DISC_DATA_T* ADV_BeginUpdate(void)
+{
+    if ((updatePending & ADV_PENDING_ADV_DATA) == 0u)
+    {
+        (void)memcpy(&stagedAdvData, cyBle_discoveryModeInfo.advData, sizeof(stagedAdvData));
+    }
+    return &stagedAdvData;
+}
+
+/*******************************************************************************
+* Function Name: ADV_EndUpdate
+********************************************************************************
+*
+* Summary:
+*  This routine marks the staging copy as pending. It is committed by
+*  ADV_ProcessPendingUpdate() at the next BLESS event-close.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void ADV_EndUpdate(void)
+{
+    if ((updatePending & ADV_PENDING_ADV_DATA) != 0u)
+    {
+        updateSuperseded++;
+    }
+    updatePending |= ADV_PENDING_ADV_DATA;
+}
+
+/*******************************************************************************
+* Function Name: ADV_BeginScanRspUpdate
+********************************************************************************
+*
+* Summary:
+*  This routine returns the staging copy of the scan response data, refreshed
+*  from the live data if no scan response update is pending.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  CYBLE_GAPP_SCAN_RSP_DATA_T*: Pointer to the staging copy of the scan response data
+*
+*******************************************************************************/
+CYBLE_GAPP_SCAN_RSP_DATA_T* ADV_BeginScanRspUpdate(void)
+{
+    if ((updatePending & ADV_PENDING_SCAN_RSP_DATA) == 0u)
+    {
+        (void)memcpy(&stagedScanRspData, cyBle_discoveryModeInfo.scanRspData, sizeof(stagedScanRspData));
+    }
+    return &stagedScanRspData;
+}
+
+/*******************************************************************************
+* Function Name: ADV_EndScanRspUpdate
+********************************************************************************
+*
+* Summary:
+*  This routine marks the staged scan response as pending. It is committed
+*  together with any staged ADV data by ADV_ProcessPendingUpdate().
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void ADV_EndScanRspUpdate(void)
+{
+    if ((updatePending & ADV_PENDING_SCAN_RSP_DATA) != 0u)
+    {
+        updateSuperseded++;
+    }
+    updatePending |= ADV_PENDING_SCAN_RSP_DATA;
+}
+
+/*******************************************************************************
+* Function Name: ADV_IsUpdatePending
+********************************************************************************
+*
+* Summary:
+*  This routine checks if a staged ADV or scan response update is waiting to
+*  be committed.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint8_t pending: 1 = update pending, 0 = nothing to commit
+*
+*******************************************************************************/
+uint8_t ADV_IsUpdatePending(void)
+{
+    return (updatePending != 0u) ? 1u : 0u;
+}
+
+/*******************************************************************************
+* Function Name: ADV_ProcessPendingUpdate
+********************************************************************************
+*
+* Summary:
+*  This routine commits staged ADV and scan response updates. Must be called from the main loop
+*  after CyBle_ProcessEvents(). While advertising, the live ADV data is only
+*  touched when the BLESS reports CYBLE_BLESS_STATE_EVENT_CLOSE, i.e. between
+*  two ADV events. When not advertising (stack starting up or connected) the
+*  live ADV data is updated directly and used by the next advertisement start.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint8_t committed: 1 = update committed, 0 = nothing committed
+*
+*******************************************************************************/
+uint8_t ADV_ProcessPendingUpdate(void)
+{
+    uint8_t committed = 0u;
+    
+    if (updatePending != 0u)
+    {
+        if (CyBle_GetState() != CYBLE_STATE_ADVERTISING)
+        {
+            ADV_Commit();
+            updatePending = 0u;
+            committed = 1u;
+        }
+        else if (CyBle_GetBleSsState() == CYBLE_BLESS_STATE_EVENT_CLOSE)
+        {
+            ADV_Commit();
+            
+            if (CyBle_GapUpdateAdvData(cyBle_discoveryModeInfo.advData, 
+                cyBle_discoveryModeInfo.scanRspData) == CYBLE_ERROR_OK)
+            {
+                updatePending = 0u;
+                committed = 1u;
+            }
+        }
+        else
+        {
+            /* BLESS is busy, try again at the next event-close */
+        }
+    }
+    
+    if (committed != 0u)
+    {
+        updateCommitted++;
+    }
+    return committed;
+}
+
+/*******************************************************************************
+* Function Name: ADV_GetUpdateCounts
+********************************************************************************
+*
+* Summary:
+*  This routine returns the update counters since boot. A staged update that
+*  is replaced by a newer one before the BLESS allows the commit never goes
+*  on air and counts as superseded.
+*
+* Parameters:
+*  uint32* committed: Commits, ADV and scan response data committed together count once
+*  uint32* superseded: Staged ADV or scan response updates replaced before the commit
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void ADV_GetUpdateCounts(uint32* committed, uint32* superseded)
+{
+    *committed = updateCommitted;
+    *superseded = updateSuperseded;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,23 @@
+/* ========================================
+ * Filename:        advupdate.h
+ * Description:     Deferred BLE advertising payload update header file
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+#include <project.h>
+
+#ifndef __ADVUPDATE_H
+#define __ADVUPDATE_H
+    CYBLE_GAPP_DISC_DATA_T* ADV_BeginUpdate(void);       // Get the staging copy of the ADV data
+    void    ADV_EndUpdate(void);                         // Mark the staging copy as pending
+    CYBLE_GAPP_SCAN_RSP_DATA_T* ADV_BeginScanRspUpdate(void);  // Get the staging copy of the scan response data
+    void    ADV_EndScanRspUpdate(void);                  // Mark the staged scan response as pending
+    uint8_t ADV_IsUpdatePending(void);                   // Check for a staged, uncommitted update
+    uint8_t ADV_ProcessPendingUpdate(void);              // Commit a staged update if the BLESS allows it
+    void    ADV_GetUpdateCounts(uint32* committed, uint32* superseded); // Update counters since boot
+#endif
+
+
+
+/* [] END OF FILE */
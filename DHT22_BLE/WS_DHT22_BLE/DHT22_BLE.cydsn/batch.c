@@ -0,0 +1,458 @@
+/* ========================================
+ * Filename:        batch.c
+ * Description:     Batched live reading notifications source file
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+
+#include "batch.h"
+#include "histfmt.h"
+#include "sched.h"
+#include "rtc.h"
+
+/***************************************
+*        API Constants
+***************************************/
+#define BATCH_TICKS_PER_UNIT                        (8192u)  /* LFCLK ticks per HISTFMT_BATCH_TIME_UNIT_MS */
+
+typedef struct
+{
+    uint32  time;                                   /* HISTFMT_BATCH_TIME_UNIT_MS units of clock time */
+    int16   temperatureX10;
+    uint16  humidityX10;
+} BATCH_ENTRY_T;
+
+static BATCH_ENTRY_T batchRing[BATCH_RING_DEPTH];
+static uint8 batchHead = 0u;                        /* Oldest entry */
+static uint8 batchCount = 0u;
+static uint8 batchFlushCount = 0u;                  /* Oldest entries to send even if the batch is not full */
+static uint32 batchDeadlineMs = BATCH_DEADLINE_MS;
+static uint8 batchSize = BATCH_SIZE;
+static uint32 batchDropped = 0u;
+static uint8 batchPacket[BATCH_PACKET_MAX_LEN];
+
+/*******************************************************************************
+* Function Name: Batch_Now
+********************************************************************************
+*
+* Summary:
+*  This routine returns the uncorrected clock time. Entries keep it and only
+*  the packet time is converted, so deltas never go backwards when the
+*  clock is set while readings are pending.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32: HISTFMT_BATCH_TIME_UNIT_MS units since the clock started
+*
+*******************************************************************************/
+static uint32 Batch_Now(void)
+{
+    return (uint32)(Rtc_GetTicks() / BATCH_TICKS_PER_UNIT);
+}
+
+/*******************************************************************************
+* Function Name: Batch_IsEnabled
+********************************************************************************
+*
+* Summary:
+*  This routine reports whether a client listens to batch notifications.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint8: 1 = notifications enabled
+*
+*******************************************************************************/
+static uint8 Batch_IsEnabled(void)
+{
+    return ((CyBle_GetState() == CYBLE_STATE_CONNECTED) &&
+            CYBLE_IS_NOTIFICATION_ENABLED(BATCH_DATA_CCCD_HANDLE)) ? 1u : 0u;
+}
+
+/*******************************************************************************
+* Function Name: Batch_PerPacket
+********************************************************************************
+*
+* Summary:
+*  This routine returns how many entries make a full batch: what fits the
+*  MTU the client negotiated, limited to the configured batch size.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint8: Entries per notification
+*
+*******************************************************************************/
+static uint8 Batch_PerPacket(void)
+{
+    uint16 mtu = CYBLE_GATT_DEFAULT_MTU;
+    uint8 entries;
+
+    (void)CyBle_GattGetMtuSize(&mtu);
+    if (mtu > CYBLE_GATT_MTU) {
+        mtu = CYBLE_GATT_MTU;
+    }
+
+    entries = (uint8)((mtu - 3u - HISTFMT_BATCH_HEADER_LEN) / HISTFMT_BATCH_ENTRY_LEN);
+    if ((batchSize != 0u) && (batchSize < entries)) {
+        entries = batchSize;
+    }
+    return entries;
+}
+
+/*******************************************************************************
+* Function Name: Batch_Clear
+********************************************************************************
+*
+* Summary:
+*  This routine drops all pending readings.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Batch_Clear(void)
+{
+    batchHead = 0u;
+    batchCount = 0u;
+    batchFlushCount = 0u;
+    Sched_Stop(SCHED_TASK_BATCH);
+}
+
+/*******************************************************************************
+* Function Name: Batch_Arm
+********************************************************************************
+*
+* Summary:
+*  This routine starts the deadline of the oldest pending reading.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Batch_Arm(void)
+{
+    uint32 ageMs = (Batch_Now() - batchRing[batchHead].time) * HISTFMT_BATCH_TIME_UNIT_MS;
+
+    if ((batchDeadlineMs == 0u) || (ageMs >= batchDeadlineMs)) {
+        batchFlushCount = batchCount;
+    } else {
+        Sched_Start(SCHED_TASK_BATCH, batchDeadlineMs - ageMs, 0u);
+    }
+}
+
+/*******************************************************************************
+* Function Name: Batch_Init
+********************************************************************************
+*
+* Summary:
+*  This routine registers the deadline task and restores the default flush
+*  policy.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Batch_Init(void)
+{
+    Sched_Register(SCHED_TASK_BATCH, &Batch_Task);
+    batchDeadlineMs = BATCH_DEADLINE_MS;
+    batchSize = BATCH_SIZE;
+    Batch_Clear();
+}
+
+/*******************************************************************************
+* Function Name: Batch_SetDeadline
+********************************************************************************
+*
+* Summary:
+*  This routine sets the longest a reading waits for its batch to fill.
+*
+* Parameters:
+*  uint32 deadlineMs: Deadline, 0 = send every reading at once
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Batch_SetDeadline(uint32 deadlineMs)
+{
+    batchDeadlineMs = deadlineMs;
+    if (batchCount != 0u) {
+        Batch_Arm();
+    }
+}
+
+/*******************************************************************************
+* Function Name: Batch_SetSize
+********************************************************************************
+*
+* Summary:
+*  This routine sets how many readings make a full batch. A batch never
+*  holds more than the MTU allows.
+*
+* Parameters:
+*  uint8 entries: Batch size, 0 = as many as the MTU holds
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Batch_SetSize(uint8 entries)
+{
+    batchSize = entries;
+}
+
+/*******************************************************************************
+* Function Name: Batch_Add
+********************************************************************************
+*
+* Summary:
+*  This routine queues a reading for the client. Readings are only kept
+*  while notifications are enabled. When the client falls behind the
+*  oldest reading is dropped.
+*
+* Parameters:
+*  int16 temperatureX10: Temperature x 10
+*  uint16 humidityX10: Humidity x 10
+*  uint8 status: ADVFMT_FLAG_x describing the reading
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Batch_Add(int16 temperatureX10, uint16 humidityX10, uint8 status)
+{
+    uint32 now = Batch_Now();
+    BATCH_ENTRY_T* entry;
+
+    if (Batch_IsEnabled() == 0u) {
+        return;
+    }
+
+    if (batchCount == BATCH_RING_DEPTH) {
+        batchHead = (uint8)((batchHead + 1u) % BATCH_RING_DEPTH);
+        batchCount--;
+        batchDropped++;
+        if (batchFlushCount > batchCount) {
+            batchFlushCount = batchCount;
+        }
+    }
+
+    /* A gap the delta can't hold ends the batch; the new reading starts the next one */
+    if ((batchCount != 0u) &&
+        ((now - batchRing[(batchHead + batchCount - 1u) % BATCH_RING_DEPTH].time) > HISTFMT_BATCH_DELTA_MAX)) {
+        batchFlushCount = batchCount;
+    }
+
+    entry = &batchRing[(batchHead + batchCount) % BATCH_RING_DEPTH];
+    entry->time = now;
+    if (status == 0u) {
+        entry->temperatureX10 = temperatureX10;
+        entry->humidityX10 = humidityX10;
+    } else {
+        entry->temperatureX10 = HISTFMT_TEMPERATURE_NO_DATA;
+        entry->humidityX10 = HISTFMT_HUMIDITY_NO_DATA;
+    }
+    batchCount++;
+
+    if (batchCount == 1u) {
+        Batch_Arm();
+    }
+}
+
+/*******************************************************************************
+* Function Name: Batch_WriteRequest
+********************************************************************************
+*
+* Summary:
+*  This routine handles a write request to the batch CCCD. Readings still
+*  pending when notifications are turned off are dropped. The caller sends
+*  the response.
+*
+* Parameters:
+*  CYBLE_GATTS_WRITE_REQ_PARAM_T* request: Write request from the client
+*
+* Return:
+*  CYBLE_GATT_ERR_CODE_T: CYBLE_GATT_ERR_ATTRIBUTE_NOT_FOUND if the handle is
+*                         not the batch CCCD
+*
+*******************************************************************************/
+CYBLE_GATT_ERR_CODE_T Batch_WriteRequest(CYBLE_GATTS_WRITE_REQ_PARAM_T* request)
+{
+    CYBLE_GATT_ERR_CODE_T gattErr;
+
+    if (request->handleValPair.attrHandle != BATCH_DATA_CCCD_HANDLE) {
+        return CYBLE_GATT_ERR_ATTRIBUTE_NOT_FOUND;
+    }
+
+    gattErr = CyBle_GattsWriteAttributeValue(&request->handleValPair, 0u,
+                    &request->connHandle, CYBLE_GATT_DB_PEER_INITIATED);
+    if (!CYBLE_IS_NOTIFICATION_ENABLED(BATCH_DATA_CCCD_HANDLE)) {
+        Batch_Clear();
+    }
+    return gattErr;
+}
+
+/*******************************************************************************
+* Function Name: Batch_Process
+********************************************************************************
+*
+* Summary:
+*  This routine sends full batches, and everything held once the deadline
+*  has expired, as packed notifications. A batch stays queued while the
+*  stack is busy.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Batch_Process(void)
+{
+    CYBLE_GATT_HANDLE_VALUE_PAIR_T handleVal;
+    uint8 perPacket;
+    uint8 sent = 0u;
+
+    if ((batchCount == 0u) || (Batch_IsEnabled() == 0u)) {
+        return;
+    }
+
+    perPacket = Batch_PerPacket();
+    handleVal.attrHandle = BATCH_DATA_HANDLE;
+    handleVal.value.val = batchPacket;
+
+    while ((batchCount != 0u) && ((batchFlushCount != 0u) || (batchCount >= perPacket)) &&
+           (CyBle_GattGetBusyStatus() == CYBLE_STACK_STATE_FREE)) {
+        uint32 previous = batchRing[batchHead].time;
+        uint8* p = &batchPacket[HISTFMT_BATCH_HEADER_LEN];
+        uint8 n = 0u;
+        uint8 fraction;
+        uint32 time = Rtc_ToTime((uint64)previous * BATCH_TICKS_PER_UNIT, &fraction);
+
+        /* The first entry's delta places it within the packet's second */
+        batchPacket[0] = LO8(LO16(time));
+        batchPacket[1] = HI8(LO16(time));
+        batchPacket[2] = LO8(HI16(time));
+        batchPacket[3] = HI8(HI16(time));
+
+        while ((n < perPacket) && (n < batchCount)) {
+            const BATCH_ENTRY_T* entry = &batchRing[(batchHead + n) % BATCH_RING_DEPTH];
+
+            if ((entry->time - previous) > HISTFMT_BATCH_DELTA_MAX) {
+                break;
+            }
+            p[HISTFMT_BATCH_DELTA_OFFSET] = (n == 0u) ? (uint8)(fraction / 64u) : (uint8)(entry->time - previous);
+            p[HISTFMT_BATCH_TEMPERATURE_OFFSET] = LO8((uint16)entry->temperatureX10);
+            p[HISTFMT_BATCH_TEMPERATURE_OFFSET + 1u] = HI8((uint16)entry->temperatureX10);
+            p[HISTFMT_BATCH_HUMIDITY_OFFSET] = LO8(entry->humidityX10);
+            p[HISTFMT_BATCH_HUMIDITY_OFFSET + 1u] = HI8(entry->humidityX10);
+            previous = entry->time;
+            p += HISTFMT_BATCH_ENTRY_LEN;
+            n++;
+        }
+
+        handleVal.value.len = (uint16)(HISTFMT_BATCH_HEADER_LEN + (n * HISTFMT_BATCH_ENTRY_LEN));
+        if (CyBle_GattsNotification(cyBle_connHandle, &handleVal) != CYBLE_ERROR_OK) {
+            break;
+        }
+        batchHead = (uint8)((batchHead + n) % BATCH_RING_DEPTH);
+        batchCount -= n;
+        batchFlushCount = (batchFlushCount > n) ? (uint8)(batchFlushCount - n) : 0u;
+        sent = 1u;
+    }
+
+    /* Whatever is left waits for the deadline of its own oldest reading */
+    if (batchCount == 0u) {
+        Batch_Clear();
+    } else if ((sent != 0u) && (batchFlushCount == 0u)) {
+        Batch_Arm();
+    } else {
+        /* Still filling, or still flushing while the stack is busy */
+    }
+}
+
+/*******************************************************************************
+* Function Name: Batch_GetDropped
+********************************************************************************
+*
+* Summary:
+*  This routine returns how many readings were dropped because the client
+*  did not keep up.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32: Dropped readings since boot
+*
+*******************************************************************************/
+uint32 Batch_GetDropped(void)
+{
+    return batchDropped;
+}
+
+/*******************************************************************************
+* Function Name: Batch_OnDisconnect
+********************************************************************************
+*
+* Summary:
+*  This routine drops pending readings and clears the CCCD. Without bonding
+*  the client enables notifications again on the next connection.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Batch_OnDisconnect(void)
+{
+    CYBLE_GATT_HANDLE_VALUE_PAIR_T handleVal;
+    uint8 cccd[CYBLE_CCCD_LEN] = { 0u, 0u };
+
+    Batch_Clear();
+
+    handleVal.attrHandle = BATCH_DATA_CCCD_HANDLE;
+    handleVal.value.val = cccd;
+    handleVal.value.len = CYBLE_CCCD_LEN;
+    (void)CyBle_GattsWriteAttributeValue(&handleVal, 0u, NULL, CYBLE_GATT_DB_LOCALLY_INITIATED);
+}
+
+/*******************************************************************************
+* Function Name: Batch_Task
+********************************************************************************
+*
+* Summary:
+*  This routine runs when the oldest pending reading reaches the deadline.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Batch_Task(void)
+{
+    batchFlushCount = batchCount;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,49 @@
+/* ========================================
+ * Filename:        batch.h
+ * Description:     Batched live reading notifications header file
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+#include <project.h>
+
+#ifndef __BATCH_H
+#define __BATCH_H
+
+/***************************************
+*        API Constants
+***************************************/
+/* Attribute handles, from the Batch Data characteristic (UUID ...0004) of
+ * the History Transfer custom service in the BLE component (TopDesign.cysch) */
+#define BATCH_DATA_HANDLE                           (CYBLE_HISTORY_TRANSFER_BATCH_DATA_CHAR_HANDLE)
+#define BATCH_DATA_CCCD_HANDLE                      (CYBLE_HISTORY_TRANSFER_BATCH_DATA_CLIENT_CHARACTERISTIC_CONFIGURATION_DESC_HANDLE)
+
+/* Readings held for the client, two full packets at the largest MTU */
+#define BATCH_RING_DEPTH                            (48u)
+
+/* Default flush policy. A batch is sent once it holds BATCH_SIZE entries,
+ * or fills the MTU, or its oldest entry is BATCH_DEADLINE_MS old, whichever
+ * comes first. A longer deadline wakes the radio less often, a shorter one
+ * delivers readings sooner. */
+#define BATCH_DEADLINE_MS                           (60000u)   /* 0 = send every reading at once */
+#define BATCH_SIZE                                  (0u)       /* 0 = as many as the MTU holds */
+
+#define BATCH_PACKET_MAX_LEN                        (CYBLE_GATT_MTU - 3u)
+
+/***************************************
+*        Function Prototypes
+***************************************/
+    void    Batch_Init(void);                                       // Register the deadline task
+    void    Batch_SetDeadline(uint32 deadlineMs);
+    void    Batch_SetSize(uint8 entries);
+    void    Batch_Add(int16 temperatureX10, uint16 humidityX10, uint8 status); // ADVFMT_FLAG_x status, kept only while notifications are on
+    CYBLE_GATT_ERR_CODE_T Batch_WriteRequest(CYBLE_GATTS_WRITE_REQ_PARAM_T* request); // ATTRIBUTE_NOT_FOUND if not the batch CCCD
+    void    Batch_Process(void);                                    // Send due batches, call from the main loop
+    uint32  Batch_GetDropped(void);                                 // Readings lost to a full ring
+    void    Batch_OnDisconnect(void);                               // Drop pending readings and clear the CCCD
+    void    Batch_Task(void);                                       // Scheduler task, do not call directly
+#endif
+
+
+
+/* [] END OF FILE */
@@ -0,0 +1,127 @@
+/* ========================================
+ * Filename:        clkgov.c
+ * Description:     SYSCLK governor source file
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+
+#include "clkgov.h"
+#include "energy.h"
+
+/***************************************
+*        API Constants
+***************************************/
+#define HFCLK_MHZ                                   (CYDEV_BCLK__HFCLK__MHZ)
+
+/* SYSCLK divider per level. HFCLK (IMO) is left untouched so the BLESS and
+ * the peripherals clocked from HFCLK are not affected by a level change. */
+static const uint8_t clkGovDivider[CLKGOV_LEVEL_COUNT] =
+{
+    CY_SYS_CLK_SYSCLK_DIV4,                         /* 12MHz */
+    CY_SYS_CLK_SYSCLK_DIV2,                         /* 24MHz */
+    CY_SYS_CLK_SYSCLK_DIV1,                         /* 48MHz */
+};
+
+static CLKGOV_LEVEL_T clkGovLevel = CLKGOV_LEVEL_HIGH;  /* Level set by the startup code */
+
+/*******************************************************************************
+* Function Name: ClkGov_Init
+********************************************************************************
+*
+* Summary:
+*  This routine switches from the startup clock to the low level.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void ClkGov_Init(void)
+{
+    ClkGov_SetLevel(CLKGOV_LEVEL_LOW);
+}
+
+/*******************************************************************************
+* Function Name: ClkGov_SetLevel
+********************************************************************************
+*
+* Summary:
+*  This routine changes the SYSCLK divider. The flash wait states are
+*  increased before raising the clock and reduced after lowering it, so flash
+*  is never accessed with too few wait states. CyDelay calibration and the
+*  energy accounting timebase are updated on every change.
+*  Must not be called while an energy accounting task is being timed.
+*
+* Parameters:
+*  CLKGOV_LEVEL_T level: New clock level
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void ClkGov_SetLevel(CLKGOV_LEVEL_T level)
+{
+    if (level != clkGovLevel)
+    {
+        uint32 mhz = HFCLK_MHZ >> clkGovDivider[level];
+        
+        if (level > clkGovLevel)
+        {
+            CySysFlashSetWaitCycles(mhz);
+            CySysClkWriteSysclkDiv(clkGovDivider[level]);
+        }
+        else
+        {
+            CySysClkWriteSysclkDiv(clkGovDivider[level]);
+            CySysFlashSetWaitCycles(mhz);
+        }
+        
+        CyDelayFreq(mhz * 1000000u);
+        Energy_SetSysclkFreq(mhz);
+        
+        clkGovLevel = level;
+    }
+}
+
+/*******************************************************************************
+* Function Name: ClkGov_GetLevel
+********************************************************************************
+*
+* Summary:
+*  This routine returns the current clock level.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  CLKGOV_LEVEL_T level: Current clock level
+*
+*******************************************************************************/
+CLKGOV_LEVEL_T ClkGov_GetLevel(void)
+{
+    return clkGovLevel;
+}
+
+/*******************************************************************************
+* Function Name: ClkGov_GetSysclkFreq
+********************************************************************************
+*
+* Summary:
+*  This routine returns the current SYSCLK frequency.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32 freq: SYSCLK in Hz
+*
+*******************************************************************************/
+uint32 ClkGov_GetSysclkFreq(void)
+{
+    return ((uint32)CYDEV_BCLK__HFCLK__HZ >> clkGovDivider[clkGovLevel]);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,29 @@
+/* ========================================
+ * Filename:        clkgov.h
+ * Description:     SYSCLK governor header file
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+#include <project.h>
+
+#ifndef __CLKGOV_H
+#define __CLKGOV_H
+
+typedef enum
+{
+    CLKGOV_LEVEL_LOW = 0u,                          /* Idle bookkeeping, ADV formatting */
+    CLKGOV_LEVEL_MEDIUM,                            /* BLE stack processing */
+    CLKGOV_LEVEL_HIGH,                              /* Timing-critical DHT22 capture */
+    CLKGOV_LEVEL_COUNT
+} CLKGOV_LEVEL_T;
+
+    void    ClkGov_Init(void);                      // Apply the initial (low) clock level
+    void    ClkGov_SetLevel(CLKGOV_LEVEL_T level);  // Switch SYSCLK and re-derive delay / wait states
+    CLKGOV_LEVEL_T ClkGov_GetLevel(void);
+    uint32  ClkGov_GetSysclkFreq(void);             // Current SYSCLK in Hz
+#endif
+
+
+
+/* [] END OF FILE */
@@ -27,6 +27,7 @@
 #include "BLE_gatt.h"
 #include "BLE.h"
 #include "BLE_ias.h"
+#include "BLE_custom.h"
 #include "BLE_HAL_PVT.h"
 #include "BLE_STACK_PVT.h"
 #include "BLE_StackGap.h"
@@ -0,0 +1,444 @@
+/* ========================================
+ * Filename:        config.c
+ * Description:     Runtime configuration service source file
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+
+#include "config.h"
+#include "nvstore.h"
+#include "sched.h"
+#include "advrate.h"
+#include "ess.h"
+#include "batch.h"
+#include "radio.h"
+#include <string.h>
+
+#define CONFIG_IMAGE_LEN                            (CONFIG_MAGIC_LEN + CONFIG_RECORD_LEN)
+
+#define CONFIG_GET16(r, o)                          ((uint16)((uint16)(r)[o] | ((uint16)(r)[(o) + 1u] << 8u)))
+
+static uint8 configRecord[CONFIG_RECORD_LEN];       /* Record in use */
+static uint8 configStored[CONFIG_IMAGE_LEN];        /* Magic and record as held in the EEPROM */
+static uint8 configStoredKnown = 0u;                /* 0 = EEPROM contents unknown, write everything */
+static uint8 configSavePending = 0u;
+
+/*******************************************************************************
+* Function Name: Config_Put16
+********************************************************************************
+*
+* Summary:
+*  This routine writes a little-endian field.
+*
+* Parameters:
+*  uint8* record: Record
+*  uint8 offset: CONFIG_x_OFFSET
+*  uint16 value: Field value
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Config_Put16(uint8* record, uint8 offset, uint16 value)
+{
+    record[offset] = LO8(value);
+    record[offset + 1u] = HI8(value);
+}
+
+/*******************************************************************************
+* Function Name: Config_Defaults
+********************************************************************************
+*
+* Summary:
+*  This routine builds the record the modules start with. The radio fields
+*  are read back from the radio module, so call after Radio_Init().
+*
+* Parameters:
+*  uint8* record: Destination, CONFIG_RECORD_LEN bytes
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Config_Defaults(uint8* record)
+{
+    Config_Put16(record, CONFIG_SENSOR_PERIOD_OFFSET, (uint16)(CONFIG_SENSOR_PERIOD_MS / 1000u));
+    Config_Put16(record, CONFIG_ADV_SLOW_INT_OFFSET, ADVRATE_SLOW_INT_MIN);
+    Config_Put16(record, CONFIG_ADV_IDLE_INT_OFFSET, ADVRATE_IDLE_INT_MIN);
+    Config_Put16(record, CONFIG_TEMPERATURE_LOW_OFFSET, (uint16)ADVRATE_TEMPERATURE_LOW_X10);
+    Config_Put16(record, CONFIG_TEMPERATURE_HIGH_OFFSET, (uint16)ADVRATE_TEMPERATURE_HIGH_X10);
+    Config_Put16(record, CONFIG_ESS_TRIGGER_TEMPERATURE_OFFSET, ESS_TRIGGER_TEMPERATURE);
+    Config_Put16(record, CONFIG_ESS_TRIGGER_HUMIDITY_OFFSET, ESS_TRIGGER_HUMIDITY);
+    Config_Put16(record, CONFIG_BATCH_DEADLINE_OFFSET, (uint16)(BATCH_DEADLINE_MS / 1000u));
+    record[CONFIG_BATCH_SIZE_OFFSET] = BATCH_SIZE;
+    record[CONFIG_RADIO_PROFILE_OFFSET] = (uint8)Radio_GetProfile();
+    record[CONFIG_TX_POWER_OFFSET] = (uint8)Radio_GetTxPower();
+    record[CONFIG_CHANNEL_MAP_OFFSET] = Radio_GetChannelMap(0u);
+    record[CONFIG_LOW_PRIORITY_CHANNEL_MAP_OFFSET] = Radio_GetChannelMap(1u);
+}
+
+/*******************************************************************************
+* Function Name: Config_Check
+********************************************************************************
+*
+* Summary:
+*  This routine checks every field of a record against its limits.
+*
+* Parameters:
+*  const uint8* record: Record to check
+*
+* Return:
+*  uint8: 1 = valid, 0 = a field is out of range
+*
+*******************************************************************************/
+static uint8 Config_Check(const uint8* record)
+{
+    uint16 period = CONFIG_GET16(record, CONFIG_SENSOR_PERIOD_OFFSET);
+    uint16 slow = CONFIG_GET16(record, CONFIG_ADV_SLOW_INT_OFFSET);
+    uint16 idle = CONFIG_GET16(record, CONFIG_ADV_IDLE_INT_OFFSET);
+
+    if ((period < CONFIG_SENSOR_PERIOD_MIN_S) || (period > CONFIG_SENSOR_PERIOD_MAX_S) ||
+        (slow < CONFIG_ADV_INT_MIN) || (slow > CONFIG_ADV_INT_MAX) ||
+        (idle < CONFIG_ADV_INT_MIN) || (idle > CONFIG_ADV_INT_MAX)) {
+        return 0u;
+    }
+    if ((int16)CONFIG_GET16(record, CONFIG_TEMPERATURE_LOW_OFFSET) >
+        (int16)CONFIG_GET16(record, CONFIG_TEMPERATURE_HIGH_OFFSET)) {
+        return 0u;
+    }
+    if ((record[CONFIG_RADIO_PROFILE_OFFSET] >= (uint8)RADIO_PROFILE_COUNT) ||
+        (Radio_IsTxPowerValid((RADIO_PROFILE_T)record[CONFIG_RADIO_PROFILE_OFFSET],
+                              (CYBLE_BLESS_PWR_LVL_T)record[CONFIG_TX_POWER_OFFSET]) == 0u)) {
+        return 0u;
+    }
+    if ((record[CONFIG_CHANNEL_MAP_OFFSET] == 0u) || (record[CONFIG_CHANNEL_MAP_OFFSET] > RADIO_CHANNELS_ALL) ||
+        (record[CONFIG_LOW_PRIORITY_CHANNEL_MAP_OFFSET] == 0u) ||
+        (record[CONFIG_LOW_PRIORITY_CHANNEL_MAP_OFFSET] > RADIO_CHANNELS_ALL)) {
+        return 0u;
+    }
+    return 1u;
+}
+
+/*******************************************************************************
+* Function Name: Config_Changed
+********************************************************************************
+*
+* Summary:
+*  This routine tells whether fields of a record differ from the record in
+*  use.
+*
+* Parameters:
+*  const uint8* record: New record
+*  uint8 offset: First field, CONFIG_x_OFFSET
+*  uint8 len: Length of the fields in bytes
+*
+* Return:
+*  uint8: 1 = changed
+*
+*******************************************************************************/
+static uint8 Config_Changed(const uint8* record, uint8 offset, uint8 len)
+{
+    return (memcmp(&record[offset], &configRecord[offset], len) != 0) ? 1u : 0u;
+}
+
+/*******************************************************************************
+* Function Name: Config_Apply
+********************************************************************************
+*
+* Summary:
+*  This routine hands the changed fields of a checked record to the modules
+*  and makes it the record in use. Fields that did not change are left
+*  alone, so e.g. the statistics windows survive a threshold change.
+*
+* Parameters:
+*  const uint8* record: New record
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Config_Apply(const uint8* record)
+{
+    uint16 interval;
+
+    if (Config_Changed(record, CONFIG_SENSOR_PERIOD_OFFSET, 2u) != 0u) {
+        uint32 periodMs = (uint32)CONFIG_GET16(record, CONFIG_SENSOR_PERIOD_OFFSET) * 1000u;
+
+        if (Sched_IsRunning(SCHED_TASK_SENSOR) != 0u) {
+            Sched_Start(SCHED_TASK_SENSOR, periodMs, periodMs);
+        }
+    }
+
+    /* Intervals are set with a 10% window, as the defaults */
+    if (Config_Changed(record, CONFIG_ADV_SLOW_INT_OFFSET, 2u) != 0u) {
+        interval = CONFIG_GET16(record, CONFIG_ADV_SLOW_INT_OFFSET);
+        AdvRate_SetInterval(ADVRATE_LEVEL_SLOW, interval, interval + (interval / 10u));
+    }
+    if (Config_Changed(record, CONFIG_ADV_IDLE_INT_OFFSET, 2u) != 0u) {
+        interval = CONFIG_GET16(record, CONFIG_ADV_IDLE_INT_OFFSET);
+        AdvRate_SetInterval(ADVRATE_LEVEL_IDLE, interval, interval + (interval / 10u));
+    }
+
+    if (Config_Changed(record, CONFIG_TEMPERATURE_LOW_OFFSET, 4u) != 0u) {
+        AdvRate_SetThresholds((int16)CONFIG_GET16(record, CONFIG_TEMPERATURE_LOW_OFFSET),
+                              (int16)CONFIG_GET16(record, CONFIG_TEMPERATURE_HIGH_OFFSET));
+    }
+
+    /* A profile change resets the TX power to the profile's initial level,
+     * so the stored level is set after it */
+    if (Config_Changed(record, CONFIG_RADIO_PROFILE_OFFSET, 2u) != 0u) {
+        Radio_SetProfile((RADIO_PROFILE_T)record[CONFIG_RADIO_PROFILE_OFFSET]);
+        Radio_SetTxPower((CYBLE_BLESS_PWR_LVL_T)record[CONFIG_TX_POWER_OFFSET]);
+    }
+    /* Used from the next advertising start */
+    if (Config_Changed(record, CONFIG_CHANNEL_MAP_OFFSET, 2u) != 0u) {
+        Radio_SetChannelMaps(record[CONFIG_CHANNEL_MAP_OFFSET], record[CONFIG_LOW_PRIORITY_CHANNEL_MAP_OFFSET]);
+    }
+
+#if (ADVRATE_MODE == ADVRATE_MODE_CONNECTABLE)
+    if (Config_Changed(record, CONFIG_ESS_TRIGGER_TEMPERATURE_OFFSET, 4u) != 0u) {
+        Ess_SetTrigger(CONFIG_GET16(record, CONFIG_ESS_TRIGGER_TEMPERATURE_OFFSET),
+                       CONFIG_GET16(record, CONFIG_ESS_TRIGGER_HUMIDITY_OFFSET));
+    }
+
+    if (Config_Changed(record, CONFIG_BATCH_DEADLINE_OFFSET, 2u) != 0u) {
+        Batch_SetDeadline((uint32)CONFIG_GET16(record, CONFIG_BATCH_DEADLINE_OFFSET) * 1000u);
+    }
+    if (Config_Changed(record, CONFIG_BATCH_SIZE_OFFSET, 1u) != 0u) {
+        Batch_SetSize(record[CONFIG_BATCH_SIZE_OFFSET]);
+    }
+#endif /* (ADVRATE_MODE == ADVRATE_MODE_CONNECTABLE) */
+
+    (void)memcpy(configRecord, record, CONFIG_RECORD_LEN);
+}
+
+/*******************************************************************************
+* Function Name: Config_Init
+********************************************************************************
+*
+* Summary:
+*  This routine registers the save task and applies the stored record. The
+*  modules start with their defaults, so only stored fields that differ are
+*  applied. With no valid stored record the defaults stay in use and nothing
+*  is written until a client changes a field. Call after NV_Init() and the
+*  Init of every configured module, Radio_Init() included.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Config_Init(void)
+{
+    Sched_Register(SCHED_TASK_CONFIG, &Config_Task);
+    Config_Defaults(configRecord);
+
+    if (NV_Read(NV_CONFIG_ADDR, configStored, CONFIG_IMAGE_LEN) != 0u) {
+        return;
+    }
+    configStoredKnown = 1u;
+
+    if ((CONFIG_GET16(configStored, 0u) == LO16(CONFIG_MAGIC)) &&
+        (CONFIG_GET16(configStored, 2u) == HI16(CONFIG_MAGIC)) &&
+        (Config_Check(&configStored[CONFIG_MAGIC_LEN]) != 0u)) {
+        Config_Apply(&configStored[CONFIG_MAGIC_LEN]);
+    }
+}
+
+/*******************************************************************************
+* Function Name: Config_Publish
+********************************************************************************
+*
+* Summary:
+*  This routine writes the record in use to the GATT database, where clients
+*  read it.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Config_Publish(void)
+{
+    CYBLE_GATT_HANDLE_VALUE_PAIR_T handleVal;
+
+    handleVal.attrHandle = CONFIG_VALUE_HANDLE;
+    handleVal.value.val = configRecord;
+    handleVal.value.len = CONFIG_RECORD_LEN;
+    (void)CyBle_GattsWriteAttributeValue(&handleVal, 0u, NULL, CYBLE_GATT_DB_LOCALLY_INITIATED);
+}
+
+/*******************************************************************************
+* Function Name: Config_GetSensorPeriodMs
+********************************************************************************
+*
+* Summary:
+*  This routine returns the time between sensor reads.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32: Sensor period in ms
+*
+*******************************************************************************/
+uint32 Config_GetSensorPeriodMs(void)
+{
+    return (uint32)CONFIG_GET16(configRecord, CONFIG_SENSOR_PERIOD_OFFSET) * 1000u;
+}
+
+/*******************************************************************************
+* Function Name: Config_WriteRequest
+********************************************************************************
+*
+* Summary:
+*  This routine handles a write of the whole record. A valid record is
+*  applied at once and saved CONFIG_SAVE_DELAY_MS after the last write, so a
+*  client changing several settings costs one flash row write. A gateway RSSI
+*  report is passed to the radio module. The caller sends the response.
+*
+* Parameters:
+*  CYBLE_GATTS_WRITE_REQ_PARAM_T* request: Write request from the client
+*
+* Return:
+*  CYBLE_GATT_ERR_CODE_T: CYBLE_GATT_ERR_ATTRIBUTE_NOT_FOUND if the handle is
+*                         not the configuration or gateway RSSI
+*
+*******************************************************************************/
+CYBLE_GATT_ERR_CODE_T Config_WriteRequest(CYBLE_GATTS_WRITE_REQ_PARAM_T* request)
+{
+    const uint8* value = request->handleValPair.value.val;
+
+    if (request->handleValPair.attrHandle == CONFIG_GATEWAY_RSSI_HANDLE) {
+        if (request->handleValPair.value.len != 1u) {
+            return CYBLE_GATT_ERR_INVALID_ATTRIBUTE_LEN;
+        }
+        Radio_OnGatewayRssi((int8)value[0]);
+        return CYBLE_GATT_ERR_NONE;
+    }
+    if (request->handleValPair.attrHandle != CONFIG_VALUE_HANDLE) {
+        return CYBLE_GATT_ERR_ATTRIBUTE_NOT_FOUND;
+    }
+    if (request->handleValPair.value.len != CONFIG_RECORD_LEN) {
+        return CYBLE_GATT_ERR_INVALID_ATTRIBUTE_LEN;
+    }
+    if (Config_Check(value) == 0u) {
+        return CYBLE_GATT_ERR_OUT_OF_RANGE;
+    }
+
+    if (memcmp(value, configRecord, CONFIG_RECORD_LEN) != 0) {
+        Config_Apply(value);
+        Config_Publish();
+        Sched_Start(SCHED_TASK_CONFIG, CONFIG_SAVE_DELAY_MS, 0u);
+    }
+    return CYBLE_GATT_ERR_NONE;
+}
+
+/*******************************************************************************
+* Function Name: Config_SetEssTrigger
+********************************************************************************
+*
+* Summary:
+*  This routine copies ESS notification triggers a client wrote through the
+*  ES Trigger Setting descriptors into the record, and saves them like a
+*  record write. The ESS module has applied them already.
+*
+* Parameters:
+*  uint16 temperatureX100: Temperature trigger in 0.01C
+*  uint16 humidityX100: Humidity trigger in 0.01%
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Config_SetEssTrigger(uint16 temperatureX100, uint16 humidityX100)
+{
+    uint8 record[CONFIG_RECORD_LEN];
+
+    (void)memcpy(record, configRecord, CONFIG_RECORD_LEN);
+    Config_Put16(record, CONFIG_ESS_TRIGGER_TEMPERATURE_OFFSET, temperatureX100);
+    Config_Put16(record, CONFIG_ESS_TRIGGER_HUMIDITY_OFFSET, humidityX100);
+
+    if (memcmp(record, configRecord, CONFIG_RECORD_LEN) != 0) {
+        (void)memcpy(configRecord, record, CONFIG_RECORD_LEN);
+        Config_Publish();
+        Sched_Start(SCHED_TASK_CONFIG, CONFIG_SAVE_DELAY_MS, 0u);
+    }
+}
+
+/*******************************************************************************
+* Function Name: Config_Process
+********************************************************************************
+*
+* Summary:
+*  This routine saves the record once the save delay has passed and the
+*  BLESS allows a flash write. Only the bytes from the first to the last
+*  one that differ from the EEPROM are written, and nothing at all if the
+*  settings were changed back.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Config_Process(void)
+{
+    uint8 image[CONFIG_IMAGE_LEN];
+    uint8 first = 0u;
+    uint8 last = CONFIG_IMAGE_LEN - 1u;
+
+    if ((configSavePending == 0u) || (NV_CanWrite() == 0u)) {
+        return;
+    }
+
+    Config_Put16(image, 0u, LO16(CONFIG_MAGIC));
+    Config_Put16(image, 2u, HI16(CONFIG_MAGIC));
+    (void)memcpy(&image[CONFIG_MAGIC_LEN], configRecord, CONFIG_RECORD_LEN);
+
+    if (configStoredKnown != 0u) {
+        while ((first < CONFIG_IMAGE_LEN) && (image[first] == configStored[first])) {
+            first++;
+        }
+        if (first == CONFIG_IMAGE_LEN) {
+            configSavePending = 0u;
+            return;
+        }
+        while (image[last] == configStored[last]) {
+            last--;
+        }
+    }
+
+    if (NV_Write(NV_CONFIG_ADDR + first, &image[first], (uint32)(last - first) + 1u) == 0u) {
+        (void)memcpy(&configStored[first], &image[first], (uint32)(last - first) + 1u);
+        configStoredKnown = 1u;
+        configSavePending = 0u;
+    }
+}
+
+/*******************************************************************************
+* Function Name: Config_Task
+********************************************************************************
+*
+* Summary:
+*  This routine marks the record for saving once writes have settled.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Config_Task(void)
+{
+    configSavePending = 1u;
+}
+
+/* [] END OF FILE */
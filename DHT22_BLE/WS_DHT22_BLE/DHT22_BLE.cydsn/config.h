@@ -0,0 +1,72 @@
+/* ========================================
+ * Filename:        config.h
+ * Description:     Runtime configuration service header file
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+#include <project.h>
+
+#ifndef __CONFIG_H
+#define __CONFIG_H
+
+/***************************************
+*        API Constants
+***************************************/
+/* Attribute handle, from the Configuration custom service in the BLE
+ * component (TopDesign.cysch). Service ...0010, characteristic ...0011. */
+#define CONFIG_VALUE_HANDLE                         (CYBLE_CONFIGURATION_SERVICE_CONFIGURATION_CHAR_HANDLE)
+
+/* Gateway RSSI, write only, int8 dBm the gateway sees for this node. Each
+ * write steps the TX power one level within the profile range, starting
+ * from the TX power field. Not stored. */
+#define CONFIG_GATEWAY_RSSI_HANDLE                  (CYBLE_CONFIGURATION_SERVICE_GATEWAY_RSSI_CHAR_HANDLE)
+
+/* Configuration record, the characteristic value and the stored copy.
+ * Little-endian. A client reads it, changes fields and writes it back whole. */
+#define CONFIG_SENSOR_PERIOD_OFFSET                 (0u)   /* uint16 s between sensor reads */
+#define CONFIG_ADV_SLOW_INT_OFFSET                  (2u)   /* uint16 0.625ms, slow advertising interval */
+#define CONFIG_ADV_IDLE_INT_OFFSET                  (4u)   /* uint16 0.625ms, idle advertising interval */
+#define CONFIG_TEMPERATURE_LOW_OFFSET               (6u)   /* int16 0.1C, advertising burst thresholds */
+#define CONFIG_TEMPERATURE_HIGH_OFFSET              (8u)
+#define CONFIG_ESS_TRIGGER_TEMPERATURE_OFFSET       (10u)  /* uint16 0.01C, ESS notification triggers */
+#define CONFIG_ESS_TRIGGER_HUMIDITY_OFFSET          (12u)  /* uint16 0.01%RH */
+#define CONFIG_BATCH_DEADLINE_OFFSET                (14u)  /* uint16 s, 0 = send every reading at once */
+#define CONFIG_BATCH_SIZE_OFFSET                    (16u)  /* uint8 entries, 0 = as many as the MTU holds */
+#define CONFIG_RADIO_PROFILE_OFFSET                 (17u)  /* uint8 RADIO_PROFILE_T */
+#define CONFIG_TX_POWER_OFFSET                      (18u)  /* uint8 CYBLE_BLESS_PWR_LVL_T, within the profile range */
+#define CONFIG_CHANNEL_MAP_OFFSET                   (19u)  /* uint8 advertising channel map, bit 0 = channel 37 */
+#define CONFIG_LOW_PRIORITY_CHANNEL_MAP_OFFSET      (20u)  /* uint8 channel map for idle advertising */
+#define CONFIG_RECORD_LEN                           (21u)
+
+/* Default sensor period, the other defaults come from the modules' headers */
+#define CONFIG_SENSOR_PERIOD_MS                     (10000u)
+
+/* Limits, a write outside them is rejected */
+#define CONFIG_SENSOR_PERIOD_MIN_S                  (2u)       /* DHT22 minimum */
+#define CONFIG_SENSOR_PERIOD_MAX_S                  (3600u)
+#define CONFIG_ADV_INT_MIN                          (0x00A0u)  /* 100ms */
+#define CONFIG_ADV_INT_MAX                          (0x3A00u)  /* 9.28s, the 10% window stays below 10.24s */
+
+/* Stored record, NV_CONFIG_ADDR in the emulated EEPROM */
+#define CONFIG_MAGIC                                (0x43463232u)  /* "CF22" */
+#define CONFIG_MAGIC_LEN                            (4u)
+
+/* Writes arriving within this time are saved together, one row write */
+#define CONFIG_SAVE_DELAY_MS                        (5000u)
+
+/***************************************
+*        Function Prototypes
+***************************************/
+    void    Config_Init(void);                                      // Load the stored record and apply it, call after NV_Init()
+    void    Config_Publish(void);                                   // Write the record to the GATT database, call once the stack is on
+    uint32  Config_GetSensorPeriodMs(void);
+    CYBLE_GATT_ERR_CODE_T Config_WriteRequest(CYBLE_GATTS_WRITE_REQ_PARAM_T* request); // ATTRIBUTE_NOT_FOUND if not the configuration or gateway RSSI
+    void    Config_SetEssTrigger(uint16 temperatureX100, uint16 humidityX100); // Record triggers the ESS module already applied
+    void    Config_Process(void);                                   // Save changed fields when the BLESS allows it
+    void    Config_Task(void);                                      // Scheduler task, do not call directly
+#endif
+
+
+
+/* [] END OF FILE */
@@ -0,0 +1,309 @@
+/* ========================================
+ * Filename:        connparam.c
+ * Description:     Connection parameter profile manager source file
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+
+#include "connparam.h"
+#include "sched.h"
+
+/* First request and fallback of each profile */
+static const CYBLE_GAP_CONN_UPDATE_PARAM_T connParamProfiles[CONNPARAM_PROFILE_COUNT][2] =
+{
+    {
+        { 0u, 0u, 0u, 0u },
+        { 0u, 0u, 0u, 0u }
+    },
+    {
+        { CONNPARAM_BULK_INT_MIN, CONNPARAM_BULK_INT_MAX, CONNPARAM_BULK_LATENCY, CONNPARAM_BULK_TIMEOUT },
+        { CONNPARAM_BULK_FALLBACK_INT_MIN, CONNPARAM_BULK_FALLBACK_INT_MAX, CONNPARAM_BULK_LATENCY, CONNPARAM_BULK_TIMEOUT }
+    },
+    {
+        { CONNPARAM_IDLE_INT_MIN, CONNPARAM_IDLE_INT_MAX, CONNPARAM_IDLE_LATENCY, CONNPARAM_IDLE_TIMEOUT },
+        { CONNPARAM_IDLE_FALLBACK_INT_MIN, CONNPARAM_IDLE_FALLBACK_INT_MAX, CONNPARAM_IDLE_FALLBACK_LATENCY, CONNPARAM_IDLE_FALLBACK_TIMEOUT }
+    }
+};
+
+static uint8 connParamConnected = 0u;
+static uint8 connParamBulk = 0u;
+static CONNPARAM_PROFILE_T connParamWanted = CONNPARAM_PROFILE_IDLE;
+static CONNPARAM_PROFILE_T connParamActive = CONNPARAM_PROFILE_NONE;    /* Profile the link runs with */
+static CONNPARAM_PROFILE_T connParamPending = CONNPARAM_PROFILE_NONE;   /* Profile requested, waiting for the central */
+static uint8 connParamAttempts = 0u;                                    /* Requests since the wanted profile changed */
+
+/*******************************************************************************
+* Function Name: ConnParam_Request
+********************************************************************************
+*
+* Summary:
+*  This routine asks the central for the wanted profile, unless the link
+*  already runs with it or a request is outstanding. Only one L2CAP
+*  signalling request may be outstanding, so a change of mind while one is
+*  is sent once the central has answered. The first attempt uses the
+*  profile, later ones its fallback.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void ConnParam_Request(void)
+{
+    CYBLE_GAP_CONN_UPDATE_PARAM_T param;
+
+    if ((connParamConnected == 0u) || (connParamPending != CONNPARAM_PROFILE_NONE) ||
+        (connParamWanted == connParamActive) || (connParamAttempts >= CONNPARAM_MAX_ATTEMPTS)) {
+        return;
+    }
+
+    param = connParamProfiles[connParamWanted][(connParamAttempts == 0u) ? 0u : 1u];
+    if (CyBle_L2capLeConnectionParamUpdateRequest(cyBle_connHandle.bdHandle, &param) == CYBLE_ERROR_OK) {
+        connParamPending = connParamWanted;
+        connParamAttempts++;
+    }
+
+    /* Response timeout, or a retry if the stack could not send */
+    Sched_Start(SCHED_TASK_CONNPARAM, CONNPARAM_RETRY_MS, 0u);
+}
+
+/*******************************************************************************
+* Function Name: ConnParam_Classify
+********************************************************************************
+*
+* Summary:
+*  This routine works out which profile parameters the central chose on its
+*  own correspond to.
+*
+* Parameters:
+*  const CYBLE_GAP_CONN_PARAM_UPDATED_IN_CONTROLLER_T* param: Parameters in use
+*
+* Return:
+*  CONNPARAM_PROFILE_T: Matching profile, CONNPARAM_PROFILE_NONE if neither
+*
+*******************************************************************************/
+static CONNPARAM_PROFILE_T ConnParam_Classify(const CYBLE_GAP_CONN_PARAM_UPDATED_IN_CONTROLLER_T* param)
+{
+    if ((param->connIntv <= CONNPARAM_BULK_FALLBACK_INT_MAX) && (param->connLatency == 0u)) {
+        return CONNPARAM_PROFILE_BULK;
+    }
+    if ((param->connIntv >= CONNPARAM_IDLE_FALLBACK_INT_MIN) && (param->connLatency != 0u)) {
+        return CONNPARAM_PROFILE_IDLE;
+    }
+    return CONNPARAM_PROFILE_NONE;
+}
+
+/*******************************************************************************
+* Function Name: ConnParam_Init
+********************************************************************************
+*
+* Summary:
+*  This routine registers the request task. Call before the BLE stack is
+*  started.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void ConnParam_Init(void)
+{
+    Sched_Register(SCHED_TASK_CONNPARAM, &ConnParam_Task);
+}
+
+/*******************************************************************************
+* Function Name: ConnParam_SetBulk
+********************************************************************************
+*
+* Summary:
+*  This routine follows the bulk transfer state. The bulk profile is
+*  requested as soon as a transfer starts. Going idle waits for
+*  CONNPARAM_IDLE_DELAY_MS, so back-to-back transfers keep the short
+*  interval.
+*
+* Parameters:
+*  uint8 bulk: 1 = a bulk transfer is running
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void ConnParam_SetBulk(uint8 bulk)
+{
+    bulk = (bulk != 0u) ? 1u : 0u;
+    if (bulk == connParamBulk) {
+        return;
+    }
+    connParamBulk = bulk;
+    connParamAttempts = 0u;
+
+    if (bulk != 0u) {
+        connParamWanted = CONNPARAM_PROFILE_BULK;
+        ConnParam_Request();
+    } else {
+        connParamWanted = CONNPARAM_PROFILE_IDLE;
+        if (connParamPending == CONNPARAM_PROFILE_NONE) {
+            Sched_Start(SCHED_TASK_CONNPARAM, CONNPARAM_IDLE_DELAY_MS, 0u);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: ConnParam_OnConnect
+********************************************************************************
+*
+* Summary:
+*  This routine starts managing a new link. The central's parameters are
+*  kept for CONNPARAM_IDLE_DELAY_MS so service discovery runs at its pace,
+*  then the idle profile is requested.
+*
+* Parameters:
+*  const CYBLE_GAP_CONN_PARAM_UPDATED_IN_CONTROLLER_T* param: Parameters in use
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void ConnParam_OnConnect(const CYBLE_GAP_CONN_PARAM_UPDATED_IN_CONTROLLER_T* param)
+{
+    connParamConnected = 1u;
+    connParamBulk = 0u;
+    connParamWanted = CONNPARAM_PROFILE_IDLE;
+    connParamActive = ConnParam_Classify(param);
+    connParamPending = CONNPARAM_PROFILE_NONE;
+    connParamAttempts = 0u;
+    Sched_Start(SCHED_TASK_CONNPARAM, CONNPARAM_IDLE_DELAY_MS, 0u);
+}
+
+/*******************************************************************************
+* Function Name: ConnParam_OnUpdate
+********************************************************************************
+*
+* Summary:
+*  This routine takes the parameters the controller switched to. After a
+*  request they are taken as the requested profile, even if the central
+*  picked other values within its own limits, so the same request is not
+*  repeated. An update the central started on its own is classified, and
+*  the wanted profile is asked for again if it moved away from it.
+*
+* Parameters:
+*  const CYBLE_GAP_CONN_PARAM_UPDATED_IN_CONTROLLER_T* param: Parameters in use
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void ConnParam_OnUpdate(const CYBLE_GAP_CONN_PARAM_UPDATED_IN_CONTROLLER_T* param)
+{
+    if (param->status != 0u) {
+        /* The update failed on the link, try again later */
+        connParamPending = CONNPARAM_PROFILE_NONE;
+        Sched_Start(SCHED_TASK_CONNPARAM, CONNPARAM_RETRY_MS, 0u);
+        return;
+    }
+
+    if (connParamPending != CONNPARAM_PROFILE_NONE) {
+        connParamActive = connParamPending;
+        connParamPending = CONNPARAM_PROFILE_NONE;
+    } else {
+        connParamActive = ConnParam_Classify(param);
+    }
+
+    Sched_Stop(SCHED_TASK_CONNPARAM);
+    ConnParam_Request();
+}
+
+/*******************************************************************************
+* Function Name: ConnParam_OnResponse
+********************************************************************************
+*
+* Summary:
+*  This routine takes the central's answer to a request. An accepted request
+*  completes with CYBLE_EVT_GAP_CONNECTION_UPDATE_COMPLETE. A rejected one
+*  is retried with the fallback after CONNPARAM_RETRY_MS.
+*
+* Parameters:
+*  uint16 result: CYBLE_L2CAP_CONN_PARAM_ACCEPTED or CYBLE_L2CAP_CONN_PARAM_REJECTED
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void ConnParam_OnResponse(uint16 result)
+{
+    if (result == CYBLE_L2CAP_CONN_PARAM_ACCEPTED) {
+        return;
+    }
+
+    connParamPending = CONNPARAM_PROFILE_NONE;
+    Sched_Start(SCHED_TASK_CONNPARAM, CONNPARAM_RETRY_MS, 0u);
+}
+
+/*******************************************************************************
+* Function Name: ConnParam_OnDisconnect
+********************************************************************************
+*
+* Summary:
+*  This routine stops managing the link.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void ConnParam_OnDisconnect(void)
+{
+    connParamConnected = 0u;
+    connParamActive = CONNPARAM_PROFILE_NONE;
+    connParamPending = CONNPARAM_PROFILE_NONE;
+    Sched_Stop(SCHED_TASK_CONNPARAM);
+}
+
+/*******************************************************************************
+* Function Name: ConnParam_GetProfile
+********************************************************************************
+*
+* Summary:
+*  This routine returns the profile the link runs with.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  CONNPARAM_PROFILE_T: Active profile
+*
+*******************************************************************************/
+CONNPARAM_PROFILE_T ConnParam_GetProfile(void)
+{
+    return connParamActive;
+}
+
+/*******************************************************************************
+* Function Name: ConnParam_Task
+********************************************************************************
+*
+* Summary:
+*  This routine sends the wanted profile after the idle delay or a retry
+*  wait. A request still unanswered after CONNPARAM_RETRY_MS is given up.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void ConnParam_Task(void)
+{
+    connParamPending = CONNPARAM_PROFILE_NONE;
+    ConnParam_Request();
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,68 @@
+/* ========================================
+ * Filename:        connparam.h
+ * Description:     Connection parameter profile manager header file
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+#include <project.h>
+
+#ifndef __CONNPARAM_H
+#define __CONNPARAM_H
+
+/***************************************
+*        API Constants
+***************************************/
+/* Bulk profile, requested as soon as a log transfer starts. Intervals in
+ * 1.25ms units, supervision timeout in 10ms units. */
+#define CONNPARAM_BULK_INT_MIN                      (0x0006u)  /* 7.5ms */
+#define CONNPARAM_BULK_INT_MAX                      (0x000Cu)  /* 15ms */
+#define CONNPARAM_BULK_LATENCY                      (0u)
+#define CONNPARAM_BULK_TIMEOUT                      (400u)     /* 4s */
+
+/* Idle profile: the node only sends a notification per sensor period, so
+ * with slave latency it wakes for one connection event in five and
+ * otherwise sleeps through them. Interval max * (latency + 1) stays within
+ * 2s, the limit most centrals accept. */
+#define CONNPARAM_IDLE_INT_MIN                      (0x0100u)  /* 320ms */
+#define CONNPARAM_IDLE_INT_MAX                      (0x0140u)  /* 400ms */
+#define CONNPARAM_IDLE_LATENCY                      (4u)
+#define CONNPARAM_IDLE_TIMEOUT                      (600u)     /* 6s */
+
+/* Fallbacks, tried after the central rejects the first request. The bulk
+ * one meets the 15ms minimum some centrals enforce. */
+#define CONNPARAM_BULK_FALLBACK_INT_MIN             (0x000Cu)  /* 15ms */
+#define CONNPARAM_BULK_FALLBACK_INT_MAX             (0x0018u)  /* 30ms */
+#define CONNPARAM_IDLE_FALLBACK_INT_MIN             (0x0050u)  /* 100ms */
+#define CONNPARAM_IDLE_FALLBACK_INT_MAX             (0x00A0u)  /* 200ms */
+#define CONNPARAM_IDLE_FALLBACK_LATENCY             (2u)
+#define CONNPARAM_IDLE_FALLBACK_TIMEOUT             (500u)     /* 5s */
+
+#define CONNPARAM_IDLE_DELAY_MS                     (5000u)    /* Wait after connecting or a transfer before going idle */
+#define CONNPARAM_RETRY_MS                          (30000u)   /* Wait after a rejection, and for a missing response */
+#define CONNPARAM_MAX_ATTEMPTS                      (4u)       /* Requests per profile change */
+
+typedef enum
+{
+    CONNPARAM_PROFILE_NONE = 0u,                    /* Whatever the central chose */
+    CONNPARAM_PROFILE_BULK,
+    CONNPARAM_PROFILE_IDLE,
+    CONNPARAM_PROFILE_COUNT
+} CONNPARAM_PROFILE_T;
+
+/***************************************
+*        Function Prototypes
+***************************************/
+    void    ConnParam_Init(void);                                                       // Register the request task
+    void    ConnParam_SetBulk(uint8 bulk);                                              // 1 = a bulk transfer is running, call from the main loop
+    void    ConnParam_OnConnect(const CYBLE_GAP_CONN_PARAM_UPDATED_IN_CONTROLLER_T* param);   // CYBLE_EVT_GAP_DEVICE_CONNECTED
+    void    ConnParam_OnUpdate(const CYBLE_GAP_CONN_PARAM_UPDATED_IN_CONTROLLER_T* param);    // CYBLE_EVT_GAP_CONNECTION_UPDATE_COMPLETE
+    void    ConnParam_OnResponse(uint16 result);                                        // CYBLE_EVT_L2CAP_CONN_PARAM_UPDATE_RSP
+    void    ConnParam_OnDisconnect(void);
+    CONNPARAM_PROFILE_T ConnParam_GetProfile(void);                                     // Profile the link runs with
+    void    ConnParam_Task(void);                                                       // Scheduler task, do not call directly
+#endif
+
+
+
+/* [] END OF FILE */
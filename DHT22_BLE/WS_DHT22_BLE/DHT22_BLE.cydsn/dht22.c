@@ -9,6 +9,8 @@
 #include "dht22.h"
 #include <project.h>
 
+static DHT22_STATS_T dht22Stats = { 0u, 0u, 0u };
+
 /*******************************************************************************
 * Function Name: DHT22_Reset
 ********************************************************************************
@@ -161,9 +163,14 @@ uint8_t DHT22_Read_Data(uint8_t *data)
 {        
  	volatile uint8_t buf[5];
 	
+    dht22Stats.reads++;
     DHT22_Reset();
 	
-    if(DHT22_Check() == 0)
+    if(DHT22_Check() != 0)
+    {
+        if (dht22Stats.noResponse < UINT16_MAX) dht22Stats.noResponse++;
+    }
+    else
 	{
 		for(uint8_t i = 0; i < 5; i++) // Read 40-bit data
 		{
@@ -180,10 +187,30 @@ uint8_t DHT22_Read_Data(uint8_t *data)
 			}
 			return 0;	
 		}
+        if (dht22Stats.checksum < UINT16_MAX) dht22Stats.checksum++;
 	}
 	return 1;   
 }
 
+/*******************************************************************************
+* Function Name: DHT22_GetStats
+********************************************************************************
+*
+* Summary:
+*  This routine returns the read statistics since boot.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  const DHT22_STATS_T*: Pointer to the read statistics
+*
+*******************************************************************************/
+const DHT22_STATS_T* DHT22_GetStats(void)
+{
+    return &dht22Stats;
+}
+
 /*******************************************************************************
 * Function Name: DHT22_Init
 ********************************************************************************
@@ -205,22 +232,24 @@ uint8_t DHT22_Init(void)
 }
 
 /*******************************************************************************
-* Function Name: DHT22_getTemperatureX100
+* Function Name: DHT22_getTemperatureX10
 ********************************************************************************
 *
 * Summary:
-*  This routine extracts the temperature data from a data packet read from a DHT22 sensor
+*  This routine extracts the temperature data from a data packet read from a DHT22 sensor.
+*  The DHT22 sends the temperature as a 15-bit magnitude in 0.1C with the sign in the MSB.
 *
 * Parameters:
 *  uint8_t* data: DHT22 data array
 *
 * Return:
-*  int16_t temperature: Temperature x 100 (to avoid using floats)
+*  int16_t temperature: Temperature x 10 (to avoid using floats)
 *
 *******************************************************************************/
-int16_t DHT22_getTemperatureX100(uint8_t* data) {
+int16_t DHT22_getTemperatureX10(uint8_t* data) {
+    int16_t temperature = (int16_t)(((data[2] & 0x7Fu) << 8) | data[3]);
     
-    return ((data[3] * 10) + data[2]);
+    return (data[2] & 0x80u) ? -temperature : temperature;
 }
 
 /*******************************************************************************
@@ -238,7 +267,7 @@ int16_t DHT22_getTemperatureX100(uint8_t* data) {
 *
 *******************************************************************************/
 uint16_t DHT22_getHumidityX10(uint8_t* data) {
-    return ((data[1] * 10) + data[0]);
+    return (uint16_t)((data[0] << 8) | data[1]);
 }
 
 /* [] END OF FILE */
@@ -9,6 +9,14 @@
 
 #ifndef __DHT22_H
 #define __DHT22_H 
+
+/* Read statistics, failure counts stop at UINT16_MAX */
+typedef struct {
+    uint32_t reads;                                 // DHT22_Read_Data() calls
+    uint16_t noResponse;                            // No presence pulse
+    uint16_t checksum;                              // Checksum mismatch
+} DHT22_STATS_T;
+
     int     DHTread(void);
     uint8_t DHT22_Init(void);			                // Initialize DHT22
     uint8_t DHT22_Read_Data(uint8_t *temp);	            // Read temperature and humidity
@@ -16,8 +24,9 @@
     uint8_t DHT22_Read_Bit(void);		                // Read a bit
     uint8_t DHT22_Check(void);			                // Check if there is DHT22
     void    DHT22_Reset(void);			                // Reset DHT22  
-    int16_t DHT22_getTemperatureX100(uint8_t* data);
+    int16_t DHT22_getTemperatureX10(uint8_t* data);
     uint16_t DHT22_getHumidityX10(uint8_t* data);
+    const DHT22_STATS_T* DHT22_GetStats(void);          // Read statistics since boot
 #endif
 
 
@@ -0,0 +1,254 @@
+/* ========================================
+ * Filename:        diag.c
+ * Description:     Diagnostics service source file
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+
+#include "diag.h"
+#include "dht22.h"
+#include "advupdate.h"
+#include "batch.h"
+#include "rtc.h"
+#include "sched.h"
+#include "energy.h"
+
+/* Stack bounds from cm0gcc.ld, the stack grows down from __cy_stack */
+extern uint32 __cy_stack[];
+extern uint32 __cy_stack_limit[];
+
+static uint8 diagResetReason = 0u;
+
+/*******************************************************************************
+* Function Name: Diag_Put16
+********************************************************************************
+*
+* Summary:
+*  This routine stores a counter little-endian in 16 bits, stopping at 0xFFFF.
+*
+* Parameters:
+*  uint8* dst: Destination
+*  uint32 value: Counter
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Diag_Put16(uint8* dst, uint32 value)
+{
+    if (value > 0xFFFFu) {
+        value = 0xFFFFu;
+    }
+    dst[0] = LO8(value);
+    dst[1] = HI8(value);
+}
+
+/*******************************************************************************
+* Function Name: Diag_Put8
+********************************************************************************
+*
+* Summary:
+*  This routine stores a counter in 8 bits, stopping at 0xFF.
+*
+* Parameters:
+*  uint8* dst: Destination
+*  uint32 value: Counter
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Diag_Put8(uint8* dst, uint32 value)
+{
+    *dst = (value > 0xFFu) ? 0xFFu : (uint8)value;
+}
+
+/*******************************************************************************
+* Function Name: Diag_Put32
+********************************************************************************
+*
+* Summary:
+*  This routine stores a value little-endian in 32 bits.
+*
+* Parameters:
+*  uint8* dst: Destination
+*  uint32 value: Value
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Diag_Put32(uint8* dst, uint32 value)
+{
+    dst[0] = LO8(value);
+    dst[1] = HI8(value);
+    dst[2] = LO8(HI16(value));
+    dst[3] = HI8(HI16(value));
+}
+
+/*******************************************************************************
+* Function Name: Diag_GetStackUsed
+********************************************************************************
+*
+* Summary:
+*  This routine finds the deepest stack use since boot, the lowest word no
+*  longer holding the pattern painted by Diag_Init().
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32: Bytes
+*
+*******************************************************************************/
+static uint32 Diag_GetStackUsed(void)
+{
+    const uint32* word = __cy_stack_limit;
+
+    while ((word < __cy_stack) && (*word == DIAG_STACK_PATTERN)) {
+        word++;
+    }
+    return (uint32)((const uint8*)__cy_stack - (const uint8*)word);
+}
+
+/*******************************************************************************
+* Function Name: Diag_Init
+********************************************************************************
+*
+* Summary:
+*  This routine latches and clears the reset reason, so the next reset
+*  reports only its own cause, and paints the unused stack for the high-water
+*  mark. Must be called first in main(), while the stack is shallow.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Diag_Init(void)
+{
+    uint32 reason = CySysGetResetReason(CY_SYS_RESET_WDT | CY_SYS_RESET_PROTFAULT | CY_SYS_RESET_SW);
+    uint32* word = __cy_stack_limit;
+    uint32* top = (uint32*)(__get_MSP() - DIAG_STACK_MARGIN);
+
+    diagResetReason = 0u;
+    if ((reason & CY_SYS_RESET_WDT) != 0u) {
+        diagResetReason |= DIAG_RESET_WDT;
+    }
+    if ((reason & CY_SYS_RESET_PROTFAULT) != 0u) {
+        diagResetReason |= DIAG_RESET_PROTFAULT;
+    }
+    if ((reason & CY_SYS_RESET_SW) != 0u) {
+        diagResetReason |= DIAG_RESET_SW;
+    }
+
+    while (word < top) {
+        *word = DIAG_STACK_PATTERN;
+        word++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: Diag_ReadEnergy
+********************************************************************************
+*
+* Summary:
+*  This routine writes a fresh energy record to the GATT database. Times are
+*  summed over the tasks they were accounted to.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Diag_ReadEnergy(void)
+{
+    CYBLE_GATT_HANDLE_VALUE_PAIR_T handleVal;
+    uint8 value[DIAG_ENERGY_RECORD_LEN] = { 0u };
+#if (ENERGY_ACCOUNTING_ENABLED)
+    const ENERGY_COUNTERS_T* energy = Energy_GetCounters();
+    uint64 modeUs[ENERGY_MODE_COUNT] = { 0u };
+    uint64 totalUs = 0u;
+
+    for (uint8_t task = 0u; task < (uint8_t)ENERGY_TASK_COUNT; task++) {
+        for (uint8_t mode = 0u; mode < (uint8_t)ENERGY_MODE_COUNT; mode++) {
+            modeUs[mode] += energy->timeUs[task][mode];
+            totalUs += energy->timeUs[task][mode];
+        }
+    }
+
+    Diag_Put32(&value[DIAG_ENERGY_CURRENT_OFFSET], Energy_GetAverageCurrent());
+    Diag_Put32(&value[DIAG_ENERGY_TOTAL_OFFSET], (uint32)(totalUs / 1000000u));
+    Diag_Put32(&value[DIAG_ENERGY_ACTIVE_OFFSET], (uint32)(modeUs[ENERGY_MODE_ACTIVE] / 1000u));
+    Diag_Put32(&value[DIAG_ENERGY_SLEEP_OFFSET], (uint32)(modeUs[ENERGY_MODE_SLEEP] / 1000u));
+    Diag_Put32(&value[DIAG_ENERGY_LED_OFFSET], (uint32)(energy->loadTimeUs[ENERGY_LOAD_LED] / 1000u));
+#endif /* ENERGY_ACCOUNTING_ENABLED */
+
+    handleVal.attrHandle = DIAG_ENERGY_HANDLE;
+    handleVal.value.val = value;
+    handleVal.value.len = DIAG_ENERGY_RECORD_LEN;
+    (void)CyBle_GattsWriteAttributeValue(&handleVal, 0u, NULL, CYBLE_GATT_DB_LOCALLY_INITIATED);
+}
+
+/*******************************************************************************
+* Function Name: Diag_ReadRequest
+********************************************************************************
+*
+* Summary:
+*  This routine writes a fresh diagnostics or energy record to the GATT
+*  database when a client is about to read it.
+*
+* Parameters:
+*  CYBLE_GATTS_CHAR_VAL_READ_REQ_T* request: Read access event parameter
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Diag_ReadRequest(CYBLE_GATTS_CHAR_VAL_READ_REQ_T* request)
+{
+    CYBLE_GATT_HANDLE_VALUE_PAIR_T handleVal;
+    uint8 value[DIAG_RECORD_LEN];
+    const DHT22_STATS_T* sensor = DHT22_GetStats();
+    uint32 advCommitted;
+    uint32 advSuperseded;
+    uint32 schedLate;
+    uint32 schedOverruns;
+    uint32 stackUnits;
+
+    if (request->attrHandle == DIAG_ENERGY_HANDLE) {
+        Diag_ReadEnergy();
+        return;
+    }
+    if (request->attrHandle != DIAG_VALUE_HANDLE) {
+        return;
+    }
+
+    ADV_GetUpdateCounts(&advCommitted, &advSuperseded);
+    Sched_GetCounts(&schedLate, &schedOverruns);
+    stackUnits = (Diag_GetStackUsed() + DIAG_STACK_UNIT - 1u) / DIAG_STACK_UNIT;
+
+    Diag_Put32(&value[DIAG_UPTIME_OFFSET], (uint32)(Rtc_GetTicks() / RTC_TICKS_PER_S));
+    Diag_Put32(&value[DIAG_SENSOR_READS_OFFSET], sensor->reads);
+    Diag_Put16(&value[DIAG_SENSOR_NO_RESPONSE_OFFSET], sensor->noResponse);
+    Diag_Put16(&value[DIAG_SENSOR_CHECKSUM_OFFSET], sensor->checksum);
+    Diag_Put16(&value[DIAG_ADV_COMMITTED_OFFSET], advCommitted);
+    Diag_Put16(&value[DIAG_ADV_SUPERSEDED_OFFSET], advSuperseded);
+    Diag_Put16(&value[DIAG_BATCH_DROPPED_OFFSET], Batch_GetDropped());
+    value[DIAG_RESET_REASON_OFFSET] = diagResetReason;
+    Diag_Put8(&value[DIAG_STACK_USED_OFFSET], stackUnits);
+    Diag_Put8(&value[DIAG_SCHED_LATE_OFFSET], schedLate);
+    Diag_Put8(&value[DIAG_SCHED_OVERRUN_OFFSET], schedOverruns);
+
+    handleVal.attrHandle = DIAG_VALUE_HANDLE;
+    handleVal.value.val = value;
+    handleVal.value.len = DIAG_RECORD_LEN;
+    (void)CyBle_GattsWriteAttributeValue(&handleVal, 0u, NULL, CYBLE_GATT_DB_LOCALLY_INITIATED);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,63 @@
+/* ========================================
+ * Filename:        diag.h
+ * Description:     Diagnostics service header file
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+#include <project.h>
+
+#ifndef __DIAG_H
+#define __DIAG_H
+
+/***************************************
+*        API Constants
+***************************************/
+/* Attribute handle, from the Diagnostics custom service in the BLE
+ * component (TopDesign.cysch). Service ...0020, characteristic ...0021. */
+#define DIAG_VALUE_HANDLE                           (CYBLE_DIAGNOSTICS_SERVICE_DIAGNOSTICS_CHAR_HANDLE)
+#define DIAG_ENERGY_HANDLE                          (CYBLE_DIAGNOSTICS_SERVICE_ENERGY_CHAR_HANDLE)  /* Characteristic ...0022 */
+
+/* Diagnostics record, little-endian. Fits the 22 bytes one ATT read returns
+ * at the default MTU. 16-bit and 8-bit counts stop at their maximum. */
+#define DIAG_UPTIME_OFFSET                          (0u)   /* uint32 s since the scheduler started */
+#define DIAG_SENSOR_READS_OFFSET                    (4u)   /* uint32 DHT22 reads */
+#define DIAG_SENSOR_NO_RESPONSE_OFFSET              (8u)   /* uint16 reads without a presence pulse */
+#define DIAG_SENSOR_CHECKSUM_OFFSET                 (10u)  /* uint16 reads with a bad checksum */
+#define DIAG_ADV_COMMITTED_OFFSET                   (12u)  /* uint16 ADV updates that went on air */
+#define DIAG_ADV_SUPERSEDED_OFFSET                  (14u)  /* uint16 ADV updates replaced before the commit */
+#define DIAG_BATCH_DROPPED_OFFSET                   (16u)  /* uint16 live readings lost to a full batch ring */
+#define DIAG_RESET_REASON_OFFSET                    (18u)  /* uint8 DIAG_RESET_x bits, 0 = power-on, XRES or brown-out */
+#define DIAG_STACK_USED_OFFSET                      (19u)  /* uint8 stack high-water mark, DIAG_STACK_UNIT bytes */
+#define DIAG_SCHED_LATE_OFFSET                      (20u)  /* uint8 task runs more than SCHED_LATE_TICKS late */
+#define DIAG_SCHED_OVERRUN_OFFSET                   (21u)  /* uint8 periodic task runs a whole period behind */
+#define DIAG_RECORD_LEN                             (22u)
+
+/* Energy record, little-endian, from the energy.c accounting since boot.
+ * Deep-Sleep time is the total less the Active and Sleep time. All zero when
+ * ENERGY_ACCOUNTING_ENABLED is 0. */
+#define DIAG_ENERGY_CURRENT_OFFSET                  (0u)   /* uint32 average current, nA */
+#define DIAG_ENERGY_TOTAL_OFFSET                    (4u)   /* uint32 s accounted */
+#define DIAG_ENERGY_ACTIVE_OFFSET                   (8u)   /* uint32 ms CPU running */
+#define DIAG_ENERGY_SLEEP_OFFSET                    (12u)  /* uint32 ms in Sleep, radio busy */
+#define DIAG_ENERGY_LED_OFFSET                      (16u)  /* uint32 ms LED on */
+#define DIAG_ENERGY_RECORD_LEN                      (20u)
+
+#define DIAG_RESET_WDT                              (0x01u)
+#define DIAG_RESET_PROTFAULT                        (0x02u)
+#define DIAG_RESET_SW                               (0x04u)
+
+#define DIAG_STACK_UNIT                             (16u)         /* The 0x800 byte stack is 128 units */
+#define DIAG_STACK_PATTERN                          (0x5AC3A55Cu)
+#define DIAG_STACK_MARGIN                           (64u)         /* Left unpainted below the caller's stack pointer */
+
+/***************************************
+*        Function Prototypes
+***************************************/
+    void    Diag_Init(void);                                        // Latch the reset reason and paint the stack, call first in main()
+    void    Diag_ReadRequest(CYBLE_GATTS_CHAR_VAL_READ_REQ_T* request); // Refresh a record before the stack reads it
+#endif
+
+
+
+/* [] END OF FILE */
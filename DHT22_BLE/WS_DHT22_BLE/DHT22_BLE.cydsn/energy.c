@@ -0,0 +1,354 @@
+/* ========================================
+ * Filename:        energy.c
+ * Description:     Per-task energy accounting source file
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+
+#include "energy.h"
+#include "sched.h"
+#include <string.h>
+
+/***************************************
+*        API Constants
+***************************************/
+#define SYSTICK_MAX_RELOAD                          (0x00FFFFFFu)  /* 24-bit down counter */
+
+/*******************************************************************************
+* Function Name: Energy_Init
+********************************************************************************
+*
+* Summary:
+*  This routine starts the timebase used for accounting. SysTick runs free
+*  from SYSCLK to time active work. Sleep and Deep-Sleep are timed with the
+*  scheduler LFCLK timebase, so Sched_Init() must be called first. SysTick
+*  is started even with the accounting compiled out, AdvAuth_GetCost() uses
+*  it too.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Energy_Init(void)
+{
+    CySysTickSetClockSource(CY_SYS_SYST_CSR_CLK_SRC_SYSCLK);
+    CySysTickSetReload(SYSTICK_MAX_RELOAD);
+    CySysTickDisableInterrupt();
+    CySysTickClear();
+    CySysTickEnable();
+    
+#if (ENERGY_ACCOUNTING_ENABLED)
+    Energy_Reset();
+#endif /* ENERGY_ACCOUNTING_ENABLED */
+}
+
+#if (ENERGY_ACCOUNTING_ENABLED)
+
+/***************************************
+*        Global Variables
+***************************************/
+static ENERGY_COUNTERS_T energyCounters;
+static uint32 energyCurrentTable[ENERGY_MODE_COUNT] =
+{
+    ENERGY_CURRENT_ACTIVE_NA,
+    ENERGY_CURRENT_SLEEP_NA,
+    ENERGY_CURRENT_DEEPSLEEP_NA
+};
+
+static uint32 energyLoadCurrent[ENERGY_LOAD_COUNT] =
+{
+    ENERGY_CURRENT_LED_NA
+};
+
+static uint32 sysclkMhz = CYDEV_BCLK__SYSCLK__MHZ;
+static uint32 taskStartTicks[ENERGY_TASK_COUNT];
+static uint32 lowPowerStartTicks;
+static ENERGY_MODE_T lowPowerMode;
+static uint32 loadOnTicks[ENERGY_LOAD_COUNT];
+static uint8_t loadIsOn[ENERGY_LOAD_COUNT];
+
+/*******************************************************************************
+* Function Name: Energy_BeginTask
+********************************************************************************
+*
+* Summary:
+*  This routine starts timing an active task.
+*
+* Parameters:
+*  ENERGY_TASK_T task: Task to account the time to
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Energy_BeginTask(ENERGY_TASK_T task)
+{
+    taskStartTicks[task] = CySysTickGetValue();
+}
+
+/*******************************************************************************
+* Function Name: Energy_EndTask
+********************************************************************************
+*
+* Summary:
+*  This routine stops timing an active task. SysTick is a 24-bit down counter,
+*  so a single task must complete within one SysTick period (349ms at 48MHz).
+*
+* Parameters:
+*  ENERGY_TASK_T task: Task to account the time to
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Energy_EndTask(ENERGY_TASK_T task)
+{
+    uint32 cycles = (taskStartTicks[task] - CySysTickGetValue()) & SYSTICK_MAX_RELOAD;
+    
+    energyCounters.timeUs[task][ENERGY_MODE_ACTIVE] += (cycles / sysclkMhz);
+    energyCounters.runs[task]++;
+}
+
+/*******************************************************************************
+* Function Name: Energy_EnterLowPower
+********************************************************************************
+*
+* Summary:
+*  This routine records the LFCLK counter before the system enters a low power
+*  mode. Must be called inside the critical section that enters the mode.
+*
+* Parameters:
+*  ENERGY_MODE_T mode: ENERGY_MODE_SLEEP or ENERGY_MODE_DEEPSLEEP
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Energy_EnterLowPower(ENERGY_MODE_T mode)
+{
+    lowPowerMode = mode;
+    lowPowerStartTicks = Sched_GetTicks();
+}
+
+/*******************************************************************************
+* Function Name: Energy_ExitLowPower
+********************************************************************************
+*
+* Summary:
+*  This routine accounts the time spent in the low power mode to the
+*  ENERGY_TASK_SLEEP task. LFCLK ticks are converted to us with
+*  1000000 / 32768 = 15625 / 512.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Energy_ExitLowPower(void)
+{
+    uint32 ticks = Sched_GetTicks() - lowPowerStartTicks;
+    
+    energyCounters.timeUs[ENERGY_TASK_SLEEP][lowPowerMode] += (((uint64)ticks * 15625u) >> 9u);
+}
+
+/*******************************************************************************
+* Function Name: Energy_LoadOn
+********************************************************************************
+*
+* Summary:
+*  This routine starts timing a load that draws current independently of the
+*  CPU power mode, e.g. an LED that stays lit through Deep-Sleep.
+*
+* Parameters:
+*  ENERGY_LOAD_T load: Load switched on
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Energy_LoadOn(ENERGY_LOAD_T load)
+{
+    if (loadIsOn[load] == 0u)
+    {
+        loadOnTicks[load] = Sched_GetTicks();
+        loadIsOn[load] = 1u;
+    }
+}
+
+/*******************************************************************************
+* Function Name: Energy_LoadOff
+********************************************************************************
+*
+* Summary:
+*  This routine stops timing a load and accounts its on-time.
+*
+* Parameters:
+*  ENERGY_LOAD_T load: Load switched off
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Energy_LoadOff(ENERGY_LOAD_T load)
+{
+    if (loadIsOn[load] != 0u)
+    {
+        uint32 ticks = Sched_GetTicks() - loadOnTicks[load];
+        
+        energyCounters.loadTimeUs[load] += (((uint64)ticks * 15625u) >> 9u);
+        loadIsOn[load] = 0u;
+    }
+}
+
+/*******************************************************************************
+* Function Name: Energy_SetModeCurrent
+********************************************************************************
+*
+* Summary:
+*  This routine updates an entry of the current table used by
+*  Energy_GetAverageCurrent().
+*
+* Parameters:
+*  ENERGY_MODE_T mode: Power mode
+*  uint32 currentNa: Current drawn in that power mode in nA
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Energy_SetModeCurrent(ENERGY_MODE_T mode, uint32 currentNa)
+{
+    energyCurrentTable[mode] = currentNa;
+}
+
+/*******************************************************************************
+* Function Name: Energy_SetLoadCurrent
+********************************************************************************
+*
+* Summary:
+*  This routine updates the current drawn by a load.
+*
+* Parameters:
+*  ENERGY_LOAD_T load: Load
+*  uint32 currentNa: Current drawn while the load is on in nA
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Energy_SetLoadCurrent(ENERGY_LOAD_T load, uint32 currentNa)
+{
+    energyLoadCurrent[load] = currentNa;
+}
+
+/*******************************************************************************
+* Function Name: Energy_SetSysclkFreq
+********************************************************************************
+*
+* Summary:
+*  This routine updates the SysTick rate used to convert active cycles to us.
+*  Must be called after every SYSCLK change.
+*
+* Parameters:
+*  uint32 mhz: New SYSCLK frequency in MHz
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Energy_SetSysclkFreq(uint32 mhz)
+{
+    sysclkMhz = mhz;
+}
+
+/*******************************************************************************
+* Function Name: Energy_GetCounters
+********************************************************************************
+*
+* Summary:
+*  This routine returns the raw accounting counters.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  const ENERGY_COUNTERS_T*: Pointer to the counters
+*
+*******************************************************************************/
+const ENERGY_COUNTERS_T* Energy_GetCounters(void)
+{
+    return &energyCounters;
+}
+
+/*******************************************************************************
+* Function Name: Energy_GetAverageCurrent
+********************************************************************************
+*
+* Summary:
+*  This routine derives the average current since the last reset from the
+*  accounted time and the current table. Load currents are added on top of
+*  the power mode currents.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32 current: Average current in nA, 0 if nothing was accounted yet
+*
+*******************************************************************************/
+uint32 Energy_GetAverageCurrent(void)
+{
+    uint64 totalUs = 0u;
+    uint64 chargeNaUs = 0u;
+    
+    for (uint8_t task = 0u; task < (uint8_t)ENERGY_TASK_COUNT; task++)
+    {
+        for (uint8_t mode = 0u; mode < (uint8_t)ENERGY_MODE_COUNT; mode++)
+        {
+            totalUs += energyCounters.timeUs[task][mode];
+            chargeNaUs += energyCounters.timeUs[task][mode] * energyCurrentTable[mode];
+        }
+    }
+    
+    for (uint8_t load = 0u; load < (uint8_t)ENERGY_LOAD_COUNT; load++)
+    {
+        chargeNaUs += energyCounters.loadTimeUs[load] * energyLoadCurrent[load];
+    }
+    
+    return (totalUs == 0u) ? 0u : (uint32)(chargeNaUs / totalUs);
+}
+
+/*******************************************************************************
+* Function Name: Energy_Reset
+********************************************************************************
+*
+* Summary:
+*  This routine clears all accounting counters.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Energy_Reset(void)
+{
+    (void)memset(&energyCounters, 0, sizeof(energyCounters));
+    
+    /* Loads that are on keep being timed from now */
+    for (uint8_t load = 0u; load < (uint8_t)ENERGY_LOAD_COUNT; load++)
+    {
+        loadOnTicks[load] = Sched_GetTicks();
+    }
+}
+
+#endif /* ENERGY_ACCOUNTING_ENABLED */
+
+/* [] END OF FILE */
@@ -0,0 +1,94 @@
+/* ========================================
+ * Filename:        energy.h
+ * Description:     Per-task energy accounting header file
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+#include <project.h>
+#include "advrate.h"
+
+#ifndef __ENERGY_H
+#define __ENERGY_H
+
+/***************************************
+*        API Constants
+***************************************/
+/* The totals are read through the Energy characteristic, so by default the
+ * instrumentation and its 64-bit counters are only built where there is a
+ * GATT server to export them */
+#ifndef ENERGY_ACCOUNTING_ENABLED
+    #define ENERGY_ACCOUNTING_ENABLED               (ADVRATE_MODE == ADVRATE_MODE_CONNECTABLE)
+#endif /* ENERGY_ACCOUNTING_ENABLED */
+
+/* Default current table in nA, override at runtime with Energy_SetModeCurrent() */
+#define ENERGY_CURRENT_ACTIVE_NA                    (5600000u)  /* CPU running at 48MHz from flash */
+#define ENERGY_CURRENT_SLEEP_NA                     (1300000u)  /* CPU stopped, HFCLK running */
+#define ENERGY_CURRENT_DEEPSLEEP_NA                 (1300u)     /* WCO and BLESS deep-sleep timer only */
+#define ENERGY_CURRENT_LED_NA                       (2000000u)  /* LED_R, drawn on top of the power mode current */
+
+typedef enum
+{
+    ENERGY_TASK_SENSOR = 0u,                        /* DHT22 read */
+    ENERGY_TASK_ADV,                                /* ADV payload formatting and commit */
+    ENERGY_TASK_BLE,                                /* CyBle_ProcessEvents() */
+    ENERGY_TASK_SLEEP,                              /* EnterLowPowerMode() */
+    ENERGY_TASK_COUNT
+} ENERGY_TASK_T;
+
+typedef enum
+{
+    ENERGY_MODE_ACTIVE = 0u,
+    ENERGY_MODE_SLEEP,
+    ENERGY_MODE_DEEPSLEEP,
+    ENERGY_MODE_COUNT
+} ENERGY_MODE_T;
+
+typedef enum
+{
+    ENERGY_LOAD_LED = 0u,                           /* Loads switched independently of the CPU */
+    ENERGY_LOAD_COUNT
+} ENERGY_LOAD_T;
+
+typedef struct
+{
+    uint64 timeUs[ENERGY_TASK_COUNT][ENERGY_MODE_COUNT];    /* Time per task and power mode */
+    uint32 runs[ENERGY_TASK_COUNT];                         /* Number of times each task ran */
+    uint64 loadTimeUs[ENERGY_LOAD_COUNT];                   /* On-time per load */
+} ENERGY_COUNTERS_T;
+
+/***************************************
+*        Function Prototypes
+***************************************/
+    void    Energy_Init(void);                                      // Start the SysTick timebase
+#if (ENERGY_ACCOUNTING_ENABLED)
+    void    Energy_BeginTask(ENERGY_TASK_T task);                   // Start timing an active task
+    void    Energy_EndTask(ENERGY_TASK_T task);                     // Stop timing an active task
+    void    Energy_EnterLowPower(ENERGY_MODE_T mode);               // Call right before Sleep/Deep-Sleep
+    void    Energy_ExitLowPower(void);                              // Call right after wakeup
+    void    Energy_LoadOn(ENERGY_LOAD_T load);                      // Start timing a load
+    void    Energy_LoadOff(ENERGY_LOAD_T load);                     // Stop timing a load
+    void    Energy_SetModeCurrent(ENERGY_MODE_T mode, uint32 currentNa);
+    void    Energy_SetLoadCurrent(ENERGY_LOAD_T load, uint32 currentNa);
+    void    Energy_SetSysclkFreq(uint32 mhz);                       // SysTick rate after a clock change
+    const ENERGY_COUNTERS_T* Energy_GetCounters(void);
+    uint32  Energy_GetAverageCurrent(void);                         // Average current in nA
+    void    Energy_Reset(void);
+#else
+    #define Energy_BeginTask(task)
+    #define Energy_EndTask(task)
+    #define Energy_EnterLowPower(mode)
+    #define Energy_ExitLowPower()
+    #define Energy_LoadOn(load)
+    #define Energy_LoadOff(load)
+    #define Energy_SetModeCurrent(mode, currentNa)
+    #define Energy_SetLoadCurrent(load, currentNa)
+    #define Energy_SetSysclkFreq(mhz)
+    #define Energy_Reset()
+#endif /* ENERGY_ACCOUNTING_ENABLED */
+
+#endif
+
+
+
+/* [] END OF FILE */
@@ -0,0 +1,274 @@
+/* ========================================
+ * Filename:        ess.c
+ * Description:     Environmental Sensing Service source file
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+
+#include "ess.h"
+#include "advfmt.h"
+#include "config.h"
+
+/***************************************
+*        API Constants
+***************************************/
+#define ESS_CHAR_TEMPERATURE                        (0u)
+#define ESS_CHAR_HUMIDITY                           (1u)
+#define ESS_CHAR_COUNT                              (2u)
+
+typedef struct
+{
+    CYBLE_GATT_DB_ATTR_HANDLE_T valueHandle;
+    CYBLE_GATT_DB_ATTR_HANDLE_T cccdHandle;
+    CYBLE_GATT_DB_ATTR_HANDLE_T triggerHandle;      /* ES Trigger Setting descriptor */
+    uint16  trigger;                                /* Change that is notified, in 0.01 units */
+    int32   notified;                               /* Last notified value */
+    uint8   notifiedValid;                          /* 0 = notify the next value regardless of the trigger */
+} ESS_CHAR_T;
+
+static ESS_CHAR_T essChars[ESS_CHAR_COUNT] =
+{
+    { ESS_TEMPERATURE_HANDLE, ESS_TEMPERATURE_CCCD_HANDLE, ESS_TEMPERATURE_TRIGGER_HANDLE, ESS_TRIGGER_TEMPERATURE, 0, 0u },
+    { ESS_HUMIDITY_HANDLE,    ESS_HUMIDITY_CCCD_HANDLE,    ESS_HUMIDITY_TRIGGER_HANDLE,    ESS_TRIGGER_HUMIDITY,    0, 0u }
+};
+
+/*******************************************************************************
+* Function Name: Ess_CharUpdate
+********************************************************************************
+*
+* Summary:
+*  This routine writes a value to the GATT database, so reads always get the
+*  latest reading, and notifies it if the client subscribed and the value
+*  moved by the trigger since the last notification. A notification the stack
+*  cannot queue is retried with the next reading.
+*
+* Parameters:
+*  ESS_CHAR_T* essChar: Characteristic to update
+*  int32 value: New value, int16 or uint16 in 0.01 units
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Ess_CharUpdate(ESS_CHAR_T* essChar, int32 value)
+{
+    CYBLE_GATT_HANDLE_VALUE_PAIR_T handleVal;
+    uint8 buffer[ESS_VALUE_LEN];
+    int32 change = value - essChar->notified;
+
+    buffer[0] = LO8((uint16)value);
+    buffer[1] = HI8((uint16)value);
+    handleVal.attrHandle = essChar->valueHandle;
+    handleVal.value.val = buffer;
+    handleVal.value.len = ESS_VALUE_LEN;
+
+    (void)CyBle_GattsWriteAttributeValue(&handleVal, 0u, NULL, CYBLE_GATT_DB_LOCALLY_INITIATED);
+
+    if (change < 0) {
+        change = -change;
+    }
+
+    if ((CyBle_GetState() != CYBLE_STATE_CONNECTED) ||
+        (!CYBLE_IS_NOTIFICATION_ENABLED(essChar->cccdHandle))) {
+        return;
+    }
+
+    if ((essChar->notifiedValid != 0u) && ((change == 0) || (change < (int32)essChar->trigger))) {
+        return;
+    }
+
+    if (CyBle_GattsNotification(cyBle_connHandle, &handleVal) == CYBLE_ERROR_OK) {
+        essChar->notified = value;
+        essChar->notifiedValid = 1u;
+    }
+}
+
+/*******************************************************************************
+* Function Name: Ess_Init
+********************************************************************************
+*
+* Summary:
+*  This routine restores the default notification triggers.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Ess_Init(void)
+{
+    Ess_SetTrigger(ESS_TRIGGER_TEMPERATURE, ESS_TRIGGER_HUMIDITY);
+    Ess_OnDisconnect();
+}
+
+/*******************************************************************************
+* Function Name: Ess_SetTrigger
+********************************************************************************
+*
+* Summary:
+*  This routine sets how far a value must move from the last notified one
+*  before it is notified again, and shows it in the ES Trigger Setting
+*  descriptors. Applied from the next reading.
+*
+* Parameters:
+*  uint16 temperatureX100: Temperature trigger in 0.01C, 0 = every change
+*  uint16 humidityX100: Humidity trigger in 0.01%, 0 = every change
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Ess_SetTrigger(uint16 temperatureX100, uint16 humidityX100)
+{
+    essChars[ESS_CHAR_TEMPERATURE].trigger = temperatureX100;
+    essChars[ESS_CHAR_HUMIDITY].trigger = humidityX100;
+    Ess_Publish();
+}
+
+/*******************************************************************************
+* Function Name: Ess_Publish
+********************************************************************************
+*
+* Summary:
+*  This routine writes the triggers in use to the ES Trigger Setting
+*  descriptors, where clients read them.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Ess_Publish(void)
+{
+    CYBLE_GATT_HANDLE_VALUE_PAIR_T handleVal;
+    uint8 setting[ESS_TRIGGER_SETTING_LEN];
+    uint8 i;
+
+    handleVal.value.val = setting;
+    handleVal.value.len = ESS_TRIGGER_SETTING_LEN;
+
+    for (i = 0u; i < ESS_CHAR_COUNT; i++) {
+        setting[0] = ESS_TRIGGER_CONDITION_CHANGED;
+        setting[1] = LO8(essChars[i].trigger);
+        setting[2] = HI8(essChars[i].trigger);
+        handleVal.attrHandle = essChars[i].triggerHandle;
+        (void)CyBle_GattsWriteAttributeValue(&handleVal, 0u, NULL, CYBLE_GATT_DB_LOCALLY_INITIATED);
+    }
+}
+
+/*******************************************************************************
+* Function Name: Ess_Update
+********************************************************************************
+*
+* Summary:
+*  This routine publishes a reading. Values without data are published as
+*  the characteristics' "unknown" values.
+*
+* Parameters:
+*  int16_t temperature: Temperature x 10
+*  uint16_t humidity: Humidity x 10
+*  uint8_t status: ADVFMT_FLAG_x describing the reading
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Ess_Update(int16_t temperature, uint16_t humidity, uint8_t status)
+{
+    if ((status & ADVFMT_FLAG_NO_DATA) != 0u) {
+        Ess_CharUpdate(&essChars[ESS_CHAR_TEMPERATURE], ESS_TEMPERATURE_UNKNOWN);
+        Ess_CharUpdate(&essChars[ESS_CHAR_HUMIDITY], (int32)ESS_HUMIDITY_UNKNOWN);
+    } else {
+        Ess_CharUpdate(&essChars[ESS_CHAR_TEMPERATURE], (int32)temperature * 10);
+        Ess_CharUpdate(&essChars[ESS_CHAR_HUMIDITY], (int32)humidity * 10);
+    }
+}
+
+/*******************************************************************************
+* Function Name: Ess_WriteRequest
+********************************************************************************
+*
+* Summary:
+*  This routine handles a write request to an ESS CCCD or ES Trigger Setting
+*  descriptor. A client that subscribes gets the next reading whatever the
+*  trigger. A new trigger is applied and copied to the configuration record,
+*  so it is saved and reads the same through both. The caller sends the
+*  response.
+*
+* Parameters:
+*  CYBLE_GATTS_WRITE_REQ_PARAM_T* request: Write request from the client
+*
+* Return:
+*  CYBLE_GATT_ERR_CODE_T: CYBLE_GATT_ERR_ATTRIBUTE_NOT_FOUND if the handle is
+*                         not an ESS descriptor
+*
+*******************************************************************************/
+CYBLE_GATT_ERR_CODE_T Ess_WriteRequest(CYBLE_GATTS_WRITE_REQ_PARAM_T* request)
+{
+    CYBLE_GATT_ERR_CODE_T gattErr = CYBLE_GATT_ERR_ATTRIBUTE_NOT_FOUND;
+    const uint8* value = request->handleValPair.value.val;
+    uint16 trigger[ESS_CHAR_COUNT];
+    uint8 i;
+
+    for (i = 0u; i < ESS_CHAR_COUNT; i++) {
+        trigger[i] = essChars[i].trigger;
+    }
+
+    for (i = 0u; i < ESS_CHAR_COUNT; i++) {
+        if (request->handleValPair.attrHandle == essChars[i].cccdHandle) {
+            gattErr = CyBle_GattsWriteAttributeValue(&request->handleValPair, 0u,
+                            &request->connHandle, CYBLE_GATT_DB_PEER_INITIATED);
+            essChars[i].notifiedValid = 0u;
+        } else if (request->handleValPair.attrHandle == essChars[i].triggerHandle) {
+            if (request->handleValPair.value.len != ESS_TRIGGER_SETTING_LEN) {
+                return CYBLE_GATT_ERR_INVALID_ATTRIBUTE_LEN;
+            }
+            if (value[0] != ESS_TRIGGER_CONDITION_CHANGED) {
+                return (CYBLE_GATT_ERR_CODE_T)ESS_ERR_CONDITION_NOT_SUPPORTED;
+            }
+            trigger[i] = (uint16)value[1] | ((uint16)value[2] << 8u);
+            Ess_SetTrigger(trigger[ESS_CHAR_TEMPERATURE], trigger[ESS_CHAR_HUMIDITY]);
+            Config_SetEssTrigger(trigger[ESS_CHAR_TEMPERATURE], trigger[ESS_CHAR_HUMIDITY]);
+            gattErr = CYBLE_GATT_ERR_NONE;
+        }
+    }
+    return gattErr;
+}
+
+/*******************************************************************************
+* Function Name: Ess_OnDisconnect
+********************************************************************************
+*
+* Summary:
+*  This routine clears the CCCDs when the client disconnects. Without bonding
+*  the subscriptions do not carry over to the next connection.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Ess_OnDisconnect(void)
+{
+    CYBLE_GATT_HANDLE_VALUE_PAIR_T handleVal;
+    uint8 cccd[CYBLE_CCCD_LEN] = { 0u, 0u };
+    uint8 i;
+
+    handleVal.value.val = cccd;
+    handleVal.value.len = CYBLE_CCCD_LEN;
+
+    for (i = 0u; i < ESS_CHAR_COUNT; i++) {
+        handleVal.attrHandle = essChars[i].cccdHandle;
+        (void)CyBle_GattsWriteAttributeValue(&handleVal, 0u, NULL, CYBLE_GATT_DB_LOCALLY_INITIATED);
+        essChars[i].notifiedValid = 0u;
+    }
+}
+
+/* [] END OF FILE */
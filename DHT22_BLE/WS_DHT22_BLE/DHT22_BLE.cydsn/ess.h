@@ -0,0 +1,56 @@
+/* ========================================
+ * Filename:        ess.h
+ * Description:     Environmental Sensing Service header file
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+#include <project.h>
+
+#ifndef __ESS_H
+#define __ESS_H
+
+/***************************************
+*        API Constants
+***************************************/
+/* Attribute handles, from the Environmental Sensing custom service in the BLE
+ * component (TopDesign.cysch) */
+#define ESS_TEMPERATURE_HANDLE                      (CYBLE_ENVIRONMENTAL_SENSING_TEMPERATURE_CHAR_HANDLE)
+#define ESS_TEMPERATURE_CCCD_HANDLE                 (CYBLE_ENVIRONMENTAL_SENSING_TEMPERATURE_CLIENT_CHARACTERISTIC_CONFIGURATION_DESC_HANDLE)
+#define ESS_HUMIDITY_HANDLE                         (CYBLE_ENVIRONMENTAL_SENSING_HUMIDITY_CHAR_HANDLE)
+#define ESS_HUMIDITY_CCCD_HANDLE                    (CYBLE_ENVIRONMENTAL_SENSING_HUMIDITY_CLIENT_CHARACTERISTIC_CONFIGURATION_DESC_HANDLE)
+#define ESS_TEMPERATURE_TRIGGER_HANDLE              (CYBLE_ENVIRONMENTAL_SENSING_TEMPERATURE_ES_TRIGGER_SETTING_DESC_HANDLE)
+#define ESS_HUMIDITY_TRIGGER_HANDLE                 (CYBLE_ENVIRONMENTAL_SENSING_HUMIDITY_ES_TRIGGER_SETTING_DESC_HANDLE)
+
+/* Characteristic values: Temperature sint16 0.01C, Humidity uint16 0.01% */
+#define ESS_VALUE_LEN                               (2u)
+#define ESS_TEMPERATURE_UNKNOWN                     (-32768)
+#define ESS_HUMIDITY_UNKNOWN                        (0xFFFFu)
+
+/* Default notification triggers, a value is notified once it moves this far
+ * from the last notified one. 0 = notify every change */
+#define ESS_TRIGGER_TEMPERATURE                     (20u)    /* 0.2C in 0.01C */
+#define ESS_TRIGGER_HUMIDITY                        (50u)    /* 0.5% in 0.01% */
+
+/* ES Trigger Setting descriptor: condition, then the trigger above as a
+ * uint16 operand in the characteristic's units. Only the "value changed
+ * more than" condition is supported; writing it also updates the trigger
+ * fields of the configuration record. */
+#define ESS_TRIGGER_SETTING_LEN                     (3u)
+#define ESS_TRIGGER_CONDITION_CHANGED               (0x03u)
+#define ESS_ERR_CONDITION_NOT_SUPPORTED             (0x81u)  /* ESS application error */
+
+/***************************************
+*        Function Prototypes
+***************************************/
+    void    Ess_Init(void);
+    void    Ess_SetTrigger(uint16 temperatureX100, uint16 humidityX100);
+    void    Ess_Publish(void);                                      // Write the trigger settings to the GATT database, call once the stack is on
+    void    Ess_Update(int16_t temperature, uint16_t humidity, uint8_t status); // x10 reading, ADVFMT_FLAG_x status
+    CYBLE_GATT_ERR_CODE_T Ess_WriteRequest(CYBLE_GATTS_WRITE_REQ_PARAM_T* request); // ATTRIBUTE_NOT_FOUND if not an ESS descriptor
+    void    Ess_OnDisconnect(void);                                 // Clear the CCCDs, no bonding to keep them
+#endif
+
+
+
+/* [] END OF FILE */
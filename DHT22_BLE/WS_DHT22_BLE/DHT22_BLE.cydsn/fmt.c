@@ -0,0 +1,81 @@
+/* ========================================
+ * Filename:        fmt.c
+ * Description:     Division-free integer to ASCII formatter source file
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+
+#include "fmt.h"
+
+/*******************************************************************************
+* Function Name: FMT_Unsigned
+********************************************************************************
+*
+* Summary:
+*  This routine converts an unsigned value to decimal ASCII. The Cortex-M0 has
+*  no hardware divider, so digits are split off with a reciprocal multiply
+*  (FMT_DIV10) instead of / and %. No terminating zero is written.
+*
+* Parameters:
+*  char* dst: Destination, at least FMT_UNSIGNED_MAX_LEN chars
+*  uint16_t value: Value to convert
+*  uint8_t minDigits: Pad with leading zeros up to this many digits
+*
+* Return:
+*  uint8_t length: Number of chars written
+*
+*******************************************************************************/
+uint8_t FMT_Unsigned(char *dst, uint16_t value, uint8_t minDigits)
+{
+    char digits[FMT_UNSIGNED_MAX_LEN];
+    uint8_t count = 0;
+    uint32_t n = value;
+    
+    // Split off the digits, least significant first
+    do {
+        uint32_t q = FMT_DIV10(n);
+        digits[count++] = (char)('0' + (n - (q * 10u)));
+        n = q;
+    } while ((n != 0u) || ((count < minDigits) && (count < FMT_UNSIGNED_MAX_LEN)));
+    
+    for (uint8_t i = 0; i < count; i++) {
+        dst[i] = digits[count - 1u - i];
+    }
+    return count;
+}
+
+/*******************************************************************************
+* Function Name: FMT_FixedX10
+********************************************************************************
+*
+* Summary:
+*  This routine converts a signed value x 10 to ASCII with one decimal,
+*  e.g. -123 to "-12.3". No terminating zero is written.
+*
+* Parameters:
+*  char* dst: Destination, at least FMT_FIXED_X10_MAX_LEN chars
+*  int16_t valueX10: Value x 10
+*  uint8_t minIntDigits: Pad the integer part with leading zeros up to this many digits
+*
+* Return:
+*  uint8_t length: Number of chars written
+*
+*******************************************************************************/
+uint8_t FMT_FixedX10(char *dst, int16_t valueX10, uint8_t minIntDigits)
+{
+    uint8_t len = 0;
+    uint32_t magnitude = (valueX10 < 0) ? (uint32_t)(-(int32_t)valueX10) : (uint32_t)valueX10;
+    uint32_t integer = FMT_DIV10(magnitude);
+    
+    if (valueX10 < 0) {
+        dst[len++] = '-';
+    }
+    len += FMT_Unsigned(&dst[len], (uint16_t)integer, minIntDigits);
+    dst[len++] = '.';
+    dst[len++] = (char)('0' + (magnitude - (integer * 10u)));
+    
+    return len;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,31 @@
+/* ========================================
+ * Filename:        fmt.h
+ * Description:     Division-free integer to ASCII formatter header file
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+#include <stdint.h>
+
+#ifndef __FMT_H
+#define __FMT_H
+
+/***************************************
+*        API Constants
+***************************************/
+#define FMT_UNSIGNED_MAX_LEN                        (5u)  /* "65535" */
+#define FMT_FIXED_X10_MAX_LEN                       (8u)  /* "-03276.8", minIntDigits is capped at 5 */
+
+/* n / 10 for n < 81920 without calling __aeabi_uidiv, 0xCCCD / 2^19 = 0.1000003 */
+#define FMT_DIV10(n)                                ((uint32_t)(((uint32_t)(n) * 0xCCCDu) >> 19u))
+
+/***************************************
+*        Function Prototypes
+***************************************/
+    uint8_t FMT_Unsigned(char *dst, uint16_t value, uint8_t minDigits);       // Returns chars written
+    uint8_t FMT_FixedX10(char *dst, int16_t valueX10, uint8_t minIntDigits);  // "-12.3", returns chars written
+#endif
+
+
+
+/* [] END OF FILE */
@@ -0,0 +1,88 @@
+/* ========================================
+ * Filename:        histfmt.h
+ * Description:     History transfer wire format header file
+ *                  Shared by the firmware and the host reference reader,
+ *                  so it must only depend on <stdint.h>.
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+#include <stdint.h>
+
+#ifndef __HISTFMT_H
+#define __HISTFMT_H
+
+/***************************************
+*        API Constants
+***************************************/
+/* Timestamp: uint32 seconds since 2020-01-01 00:00:00 UTC, once a client
+ * has set the clock through the Current Time characteristic. Until then
+ * bit 31 is set and the other bits count seconds since the device started.
+ * Times are corrected for the drift measured between clock writes. */
+#define HISTFMT_TIME_EPOCH_UNIX                     (1577836800u)  /* 2020-01-01 in Unix time */
+#define HISTFMT_TIME_UNSYNCED                       (0x80000000u)
+
+/* History record, one per sensor period, little endian:
+ *  0..1    int16       temperature, 0.1C
+ *  2..3    uint16      humidity, 0.1%RH
+ *  4..5    uint16      seconds since the previous record, 0 for the first
+ *                      record since boot
+ *
+ * A period without a valid reading is logged with the no-data values, so
+ * record n is always sample n since boot. */
+#define HISTFMT_RECORD_LEN                          (6u)
+#define HISTFMT_TEMPERATURE_OFFSET                  (0u)
+#define HISTFMT_HUMIDITY_OFFSET                     (2u)
+#define HISTFMT_DELTA_OFFSET                        (4u)
+#define HISTFMT_TEMPERATURE_NO_DATA                 (-32768)
+#define HISTFMT_HUMIDITY_NO_DATA                    (0xFFFFu)
+
+/* Data packet: uint32 index of the first record, uint32 timestamp of the
+ * first record, then as many records, oldest first, as fit the packet. The
+ * first record is at the packet time, each later one its delta after the
+ * one before it. A packet without records ends the transfer; its index is
+ * the next record to be logged and its time the current time. */
+#define HISTFMT_PACKET_HEADER_LEN                   (8u)
+#define HISTFMT_PACKET_TIME_OFFSET                  (4u)
+
+/* Control point write: [opcode][uint32 cursor]. The transfer starts at the
+ * cursor, or at the oldest record still held if the cursor is older. To
+ * resume an interrupted transfer, write the index after the last record
+ * received. */
+#define HISTFMT_OP_STOP                             (0x00u)
+#define HISTFMT_OP_START                            (0x01u)
+#define HISTFMT_CONTROL_WRITE_LEN                   (5u)
+
+/* Control point read: uint32 oldest record held, uint32 next record index */
+#define HISTFMT_CONTROL_READ_LEN                    (8u)
+
+/* The same transfer runs over an L2CAP LE credit based channel on this
+ * LE_PSM. The client sends the control point write as an SDU, every data
+ * packet arrives as one SDU. There is no ATT header per packet and an SDU
+ * can span several L2CAP frames. */
+#define HISTFMT_LE_PSM                              (0x0081u)
+
+/* Batch notification, live readings packed several to a notification:
+ *  0..3    uint32      timestamp of the second the first entry falls in
+ *  then entries, oldest first:
+ *  0       uint8       time since the previous entry, 0.25s units; for the
+ *                      first entry the time since the packet timestamp
+ *  1..2    int16       temperature, 0.1C
+ *  3..4    uint16      humidity, 0.1%RH
+ *
+ * Entry times are exact multiples of the unit from the packet time. A gap
+ * too long for the delta starts a new packet. Failed reads carry the
+ * record no-data values. */
+#define HISTFMT_BATCH_HEADER_LEN                    (4u)
+#define HISTFMT_BATCH_ENTRY_LEN                     (5u)
+#define HISTFMT_BATCH_DELTA_OFFSET                  (0u)
+#define HISTFMT_BATCH_TEMPERATURE_OFFSET            (1u)
+#define HISTFMT_BATCH_HUMIDITY_OFFSET               (3u)
+#define HISTFMT_BATCH_TIME_UNIT_MS                  (250u)
+#define HISTFMT_BATCH_DELTA_MAX                     (255u)
+
+#endif
+
+
+
+/* [] END OF FILE */
@@ -0,0 +1,234 @@
+/* ========================================
+ * Filename:        histlog.c
+ * Description:     On-device reading history log source file
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+
+#include "histlog.h"
+#include "histfmt.h"
+#include "rtc.h"
+
+typedef struct
+{
+    int16   temperatureX10;
+    uint16  humidityX10;
+    uint16  delta;                                  /* Seconds since the previous record */
+} HISTLOG_RECORD_T;
+
+static HISTLOG_RECORD_T histLog[HISTLOG_DEPTH];
+static uint32 histLogNext = 0u;                     /* Records logged since boot */
+static uint32 histLogFirstTime = 0u;                /* Clock seconds of the oldest record held */
+static uint32 histLogLastTime = 0u;                 /* Clock seconds of the newest record */
+
+/*******************************************************************************
+* Function Name: HistLog_Init
+********************************************************************************
+*
+* Summary:
+*  This routine empties the log. Record indices restart from 0.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void HistLog_Init(void)
+{
+    histLogNext = 0u;
+    histLogFirstTime = 0u;
+    histLogLastTime = 0u;
+}
+
+/*******************************************************************************
+* Function Name: HistLog_Add
+********************************************************************************
+*
+* Summary:
+*  This routine logs one sensor period, overwriting the oldest record once
+*  the log is full. Only fresh readings are logged as such, a period with a
+*  failed read is logged with the no-data values. Each record keeps the
+*  seconds since the one before it, the log keeps the time of its oldest
+*  record, in uncorrected clock seconds.
+*
+* Parameters:
+*  int16 temperatureX10: Temperature x 10
+*  uint16 humidityX10: Humidity x 10
+*  uint8 status: ADVFMT_FLAG_x describing the reading
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void HistLog_Add(int16 temperatureX10, uint16 humidityX10, uint8 status)
+{
+    HISTLOG_RECORD_T* record = &histLog[histLogNext % HISTLOG_DEPTH];
+    uint32 now = (uint32)(Rtc_GetTicks() / RTC_TICKS_PER_S);
+    uint32 delta = now - histLogLastTime;
+
+    if (histLogNext == 0u) {
+        histLogFirstTime = now;
+        delta = 0u;
+    }
+    record->delta = (delta > 0xFFFFu) ? 0xFFFFu : (uint16)delta;
+    histLogLastTime = now;
+
+    if (status == 0u) {
+        record->temperatureX10 = temperatureX10;
+        record->humidityX10 = humidityX10;
+    } else {
+        record->temperatureX10 = HISTFMT_TEMPERATURE_NO_DATA;
+        record->humidityX10 = HISTFMT_HUMIDITY_NO_DATA;
+    }
+    histLogNext++;
+
+    /* The record after the overwritten one is now the oldest */
+    if (histLogNext > HISTLOG_DEPTH) {
+        histLogFirstTime += histLog[histLogNext % HISTLOG_DEPTH].delta;
+    }
+}
+
+/*******************************************************************************
+* Function Name: HistLog_GetFirst
+********************************************************************************
+*
+* Summary:
+*  This routine returns the index of the oldest record still held.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32: Record index
+*
+*******************************************************************************/
+uint32 HistLog_GetFirst(void)
+{
+    return (histLogNext > HISTLOG_DEPTH) ? (histLogNext - HISTLOG_DEPTH) : 0u;
+}
+
+/*******************************************************************************
+* Function Name: HistLog_GetNext
+********************************************************************************
+*
+* Summary:
+*  This routine returns the index the next logged record will get. Records
+*  HistLog_GetFirst() to HistLog_GetNext() - 1 can be read.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32: Record index
+*
+*******************************************************************************/
+uint32 HistLog_GetNext(void)
+{
+    return histLogNext;
+}
+
+/*******************************************************************************
+* Function Name: HistLog_Read
+********************************************************************************
+*
+* Summary:
+*  This routine packs consecutive records in the HISTFMT record format.
+*
+* Parameters:
+*  uint32 index: Index of the first record, from HistLog_GetFirst()
+*  uint8* buffer: Destination, maxRecords * HISTFMT_RECORD_LEN bytes
+*  uint16 maxRecords: Number of records that fit the buffer
+*
+* Return:
+*  uint16: Number of records packed, 0 if index is not held
+*
+*******************************************************************************/
+uint16 HistLog_Read(uint32 index, uint8* buffer, uint16 maxRecords)
+{
+    uint16 count = 0u;
+
+    if (index < HistLog_GetFirst()) {
+        return 0u;
+    }
+
+    while ((count < maxRecords) && (index < histLogNext)) {
+        const HISTLOG_RECORD_T* record = &histLog[index % HISTLOG_DEPTH];
+
+        buffer[HISTFMT_TEMPERATURE_OFFSET] = LO8((uint16)record->temperatureX10);
+        buffer[HISTFMT_TEMPERATURE_OFFSET + 1u] = HI8((uint16)record->temperatureX10);
+        buffer[HISTFMT_HUMIDITY_OFFSET] = LO8(record->humidityX10);
+        buffer[HISTFMT_HUMIDITY_OFFSET + 1u] = HI8(record->humidityX10);
+        buffer[HISTFMT_DELTA_OFFSET] = LO8(record->delta);
+        buffer[HISTFMT_DELTA_OFFSET + 1u] = HI8(record->delta);
+
+        buffer += HISTFMT_RECORD_LEN;
+        index++;
+        count++;
+    }
+    return count;
+}
+
+/*******************************************************************************
+* Function Name: HistLog_ReadPacket
+********************************************************************************
+*
+* Summary:
+*  This routine builds a HISTFMT data packet from the cursor onwards, for any
+*  transport. A cursor older than the log is moved to the oldest record, so
+*  the packet index tells the reader which records were overwritten. A packet
+*  without records means the cursor has caught up with the log. The packet
+*  time is converted from clock seconds when the packet is built, so it
+*  includes every clock write up to now.
+*
+* Parameters:
+*  uint32* cursor: Next record to send, advanced past the packed records
+*  uint8* packet: Destination
+*  uint16 packetLen: Size of the destination, at least HISTFMT_PACKET_HEADER_LEN
+*
+* Return:
+*  uint16: Packet length
+*
+*******************************************************************************/
+uint16 HistLog_ReadPacket(uint32* cursor, uint8* packet, uint16 packetLen)
+{
+    uint16 count;
+    uint32 time;
+    uint32 index;
+
+    if (*cursor < HistLog_GetFirst()) {
+        *cursor = HistLog_GetFirst();
+    }
+    if (*cursor > histLogNext) {
+        *cursor = histLogNext;
+    }
+
+    count = HistLog_Read(*cursor, &packet[HISTFMT_PACKET_HEADER_LEN],
+                         (uint16)((packetLen - HISTFMT_PACKET_HEADER_LEN) / HISTFMT_RECORD_LEN));
+
+    packet[0] = LO8(LO16(*cursor));
+    packet[1] = HI8(LO16(*cursor));
+    packet[2] = LO8(HI16(*cursor));
+    packet[3] = HI8(HI16(*cursor));
+
+    if (count == 0u) {
+        time = Rtc_GetTime();
+    } else {
+        time = histLogFirstTime;
+        for (index = HistLog_GetFirst() + 1u; index <= *cursor; index++) {
+            time += histLog[index % HISTLOG_DEPTH].delta;
+        }
+        time = Rtc_ToTime((uint64)time * RTC_TICKS_PER_S, NULL);
+    }
+    packet[HISTFMT_PACKET_TIME_OFFSET] = LO8(LO16(time));
+    packet[HISTFMT_PACKET_TIME_OFFSET + 1u] = HI8(LO16(time));
+    packet[HISTFMT_PACKET_TIME_OFFSET + 2u] = LO8(HI16(time));
+    packet[HISTFMT_PACKET_TIME_OFFSET + 3u] = HI8(HI16(time));
+
+    *cursor += count;
+    return (uint16)(HISTFMT_PACKET_HEADER_LEN + (count * HISTFMT_RECORD_LEN));
+}
+
+/* [] END OF FILE */
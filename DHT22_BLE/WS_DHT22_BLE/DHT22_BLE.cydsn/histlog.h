@@ -0,0 +1,34 @@
+/* ========================================
+ * Filename:        histlog.h
+ * Description:     On-device reading history log header file
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+#include <project.h>
+
+#ifndef __HISTLOG_H
+#define __HISTLOG_H
+
+/***************************************
+*        API Constants
+***************************************/
+/* Records kept in RAM, HISTFMT_RECORD_LEN bytes each. At the 10s sensor
+ * period 256 records cover the last 42 minutes. A record's time delta
+ * saturates at 18 hours, far above the longest sensor period. */
+#define HISTLOG_DEPTH                               (256u)
+
+/***************************************
+*        Function Prototypes
+***************************************/
+    void    HistLog_Init(void);
+    void    HistLog_Add(int16 temperatureX10, uint16 humidityX10, uint8 status); // Log one sensor period, ADVFMT_FLAG_x status
+    uint32  HistLog_GetFirst(void);                                 // Index of the oldest record held
+    uint32  HistLog_GetNext(void);                                  // Index the next record will get
+    uint16  HistLog_Read(uint32 index, uint8* buffer, uint16 maxRecords); // Pack records from index, returns the count
+    uint16  HistLog_ReadPacket(uint32* cursor, uint8* packet, uint16 packetLen); // Build a HISTFMT data packet, advances the cursor
+#endif
+
+
+
+/* [] END OF FILE */
@@ -0,0 +1,245 @@
+/* ========================================
+ * Filename:        histxfer.c
+ * Description:     GATT history transfer service source file
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+
+#include "histxfer.h"
+#include "histlog.h"
+#include "histfmt.h"
+
+static uint8 histXferActive = 0u;
+static uint32 histXferCursor = 0u;                  /* Next record to send */
+static uint32 histXferPublished = UINT32_MAX;       /* HistLog_GetNext() in the control value */
+static uint8 histXferPacket[HISTXFER_PACKET_MAX_LEN];
+
+/*******************************************************************************
+* Function Name: HistXfer_Put32
+********************************************************************************
+*
+* Summary:
+*  This routine writes a little endian uint32.
+*
+* Parameters:
+*  uint8* buffer: Destination
+*  uint32 value: Value to write
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void HistXfer_Put32(uint8* buffer, uint32 value)
+{
+    buffer[0] = LO8(LO16(value));
+    buffer[1] = HI8(LO16(value));
+    buffer[2] = LO8(HI16(value));
+    buffer[3] = HI8(HI16(value));
+}
+
+/*******************************************************************************
+* Function Name: HistXfer_UpdateControl
+********************************************************************************
+*
+* Summary:
+*  This routine refreshes the record range a client reads from the control
+*  point, once per logged record.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void HistXfer_UpdateControl(void)
+{
+    CYBLE_GATT_HANDLE_VALUE_PAIR_T handleVal;
+    uint8 range[HISTFMT_CONTROL_READ_LEN];
+
+    if (histXferPublished == HistLog_GetNext()) {
+        return;
+    }
+    histXferPublished = HistLog_GetNext();
+
+    HistXfer_Put32(&range[0], HistLog_GetFirst());
+    HistXfer_Put32(&range[4], histXferPublished);
+    handleVal.attrHandle = HISTXFER_CONTROL_HANDLE;
+    handleVal.value.val = range;
+    handleVal.value.len = HISTFMT_CONTROL_READ_LEN;
+    (void)CyBle_GattsWriteAttributeValue(&handleVal, 0u, NULL, CYBLE_GATT_DB_LOCALLY_INITIATED);
+}
+
+/*******************************************************************************
+* Function Name: HistXfer_Init
+********************************************************************************
+*
+* Summary:
+*  This routine stops any transfer.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void HistXfer_Init(void)
+{
+    histXferActive = 0u;
+    histXferPublished = UINT32_MAX;
+}
+
+/*******************************************************************************
+* Function Name: HistXfer_WriteRequest
+********************************************************************************
+*
+* Summary:
+*  This routine handles a write request to the data CCCD or the control
+*  point. The caller sends the response.
+*
+* Parameters:
+*  CYBLE_GATTS_WRITE_REQ_PARAM_T* request: Write request from the client
+*
+* Return:
+*  CYBLE_GATT_ERR_CODE_T: CYBLE_GATT_ERR_ATTRIBUTE_NOT_FOUND if the handle is
+*                         not a history transfer handle
+*
+*******************************************************************************/
+CYBLE_GATT_ERR_CODE_T HistXfer_WriteRequest(CYBLE_GATTS_WRITE_REQ_PARAM_T* request)
+{
+    const uint8* value = request->handleValPair.value.val;
+
+    if (request->handleValPair.attrHandle == HISTXFER_DATA_CCCD_HANDLE) {
+        return CyBle_GattsWriteAttributeValue(&request->handleValPair, 0u,
+                    &request->connHandle, CYBLE_GATT_DB_PEER_INITIATED);
+    }
+
+    if (request->handleValPair.attrHandle != HISTXFER_CONTROL_HANDLE) {
+        return CYBLE_GATT_ERR_ATTRIBUTE_NOT_FOUND;
+    }
+
+    if (request->handleValPair.value.len != HISTFMT_CONTROL_WRITE_LEN) {
+        return CYBLE_GATT_ERR_INVALID_ATTRIBUTE_LEN;
+    }
+
+    switch (value[0]) {
+        case HISTFMT_OP_START:
+            histXferCursor = (uint32)value[1] | ((uint32)value[2] << 8u) |
+                             ((uint32)value[3] << 16u) | ((uint32)value[4] << 24u);
+            histXferActive = 1u;
+            break;
+
+        case HISTFMT_OP_STOP:
+            histXferActive = 0u;
+            break;
+
+        default:
+            return CYBLE_GATT_ERR_OUT_OF_RANGE;
+    }
+    return CYBLE_GATT_ERR_NONE;
+}
+
+/*******************************************************************************
+* Function Name: HistXfer_Process
+********************************************************************************
+*
+* Summary:
+*  This routine streams the log as packed notifications. Each packet is
+*  sized to the MTU negotiated by the client, and packets are queued until
+*  the stack reports it is busy, so several go out in every connection
+*  event. Records overwritten during the transfer are skipped; the packet
+*  index tells the client where the data resumes.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void HistXfer_Process(void)
+{
+    CYBLE_GATT_HANDLE_VALUE_PAIR_T handleVal;
+    uint16 mtu = CYBLE_GATT_DEFAULT_MTU;
+
+    HistXfer_UpdateControl();
+
+    if ((histXferActive == 0u) || (CyBle_GetState() != CYBLE_STATE_CONNECTED) ||
+        (!CYBLE_IS_NOTIFICATION_ENABLED(HISTXFER_DATA_CCCD_HANDLE))) {
+        return;
+    }
+
+    (void)CyBle_GattGetMtuSize(&mtu);
+    if (mtu > CYBLE_GATT_MTU) {
+        mtu = CYBLE_GATT_MTU;
+    }
+
+    handleVal.attrHandle = HISTXFER_DATA_HANDLE;
+    handleVal.value.val = histXferPacket;
+
+    while ((histXferActive != 0u) && (CyBle_GattGetBusyStatus() == CYBLE_STACK_STATE_FREE)) {
+        uint32 cursor = histXferCursor;
+
+        handleVal.value.len = HistLog_ReadPacket(&cursor, histXferPacket, mtu - 3u);
+        if (CyBle_GattsNotification(cyBle_connHandle, &handleVal) != CYBLE_ERROR_OK) {
+            break;
+        }
+
+        /* An empty packet ends the transfer */
+        histXferCursor = cursor;
+        if (handleVal.value.len == HISTFMT_PACKET_HEADER_LEN) {
+            histXferActive = 0u;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: HistXfer_IsActive
+********************************************************************************
+*
+* Summary:
+*  This routine reports whether a transfer is in progress.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint8_t: 1 = transfer in progress
+*
+*******************************************************************************/
+uint8_t HistXfer_IsActive(void)
+{
+    return histXferActive;
+}
+
+/*******************************************************************************
+* Function Name: HistXfer_OnDisconnect
+********************************************************************************
+*
+* Summary:
+*  This routine stops the transfer and clears the CCCD. The client resumes
+*  on the next connection from the last index it received.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void HistXfer_OnDisconnect(void)
+{
+    CYBLE_GATT_HANDLE_VALUE_PAIR_T handleVal;
+    uint8 cccd[CYBLE_CCCD_LEN] = { 0u, 0u };
+
+    histXferActive = 0u;
+
+    handleVal.attrHandle = HISTXFER_DATA_CCCD_HANDLE;
+    handleVal.value.val = cccd;
+    handleVal.value.len = CYBLE_CCCD_LEN;
+    (void)CyBle_GattsWriteAttributeValue(&handleVal, 0u, NULL, CYBLE_GATT_DB_LOCALLY_INITIATED);
+}
+
+/* [] END OF FILE */
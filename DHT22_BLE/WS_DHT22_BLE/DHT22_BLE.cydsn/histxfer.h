@@ -0,0 +1,38 @@
+/* ========================================
+ * Filename:        histxfer.h
+ * Description:     GATT history transfer service header file
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+#include <project.h>
+
+#ifndef __HISTXFER_H
+#define __HISTXFER_H
+
+/***************************************
+*        API Constants
+***************************************/
+/* Attribute handles, from the History Transfer custom service in the BLE
+ * component (TopDesign.cysch). UUIDs: service
+ * B1E70001-6A2C-4B9D-8F3E-5D2A7C4E9F10, data ...0002, control ...0003 */
+#define HISTXFER_DATA_HANDLE                        (CYBLE_HISTORY_TRANSFER_HISTORY_DATA_CHAR_HANDLE)
+#define HISTXFER_DATA_CCCD_HANDLE                   (CYBLE_HISTORY_TRANSFER_HISTORY_DATA_CLIENT_CHARACTERISTIC_CONFIGURATION_DESC_HANDLE)
+#define HISTXFER_CONTROL_HANDLE                     (CYBLE_HISTORY_TRANSFER_HISTORY_CONTROL_CHAR_HANDLE)
+
+/* Largest data packet, one notification at the largest MTU */
+#define HISTXFER_PACKET_MAX_LEN                     (CYBLE_GATT_MTU - 3u)
+
+/***************************************
+*        Function Prototypes
+***************************************/
+    void    HistXfer_Init(void);
+    CYBLE_GATT_ERR_CODE_T HistXfer_WriteRequest(CYBLE_GATTS_WRITE_REQ_PARAM_T* request); // ATTRIBUTE_NOT_FOUND if not a history handle
+    void    HistXfer_Process(void);                                 // Queue data packets while the stack has room, call from the main loop
+    uint8_t HistXfer_IsActive(void);                                // 1 = transfer in progress
+    void    HistXfer_OnDisconnect(void);                            // Stop the transfer and clear the CCCD
+#endif
+
+
+
+/* [] END OF FILE */
@@ -0,0 +1,285 @@
+/* ========================================
+ * Filename:        led.c
+ * Description:     LED activity policy source file
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+
+#include "led.h"
+#include "sched.h"
+#include "energy.h"
+
+/***************************************
+*        API Constants
+***************************************/
+#define LED_ON                                      (0u)
+#define LED_OFF                                     (1u)
+
+static LED_MODE_T ledMode = LED_DEFAULT_MODE;
+static uint32 ledHeartbeatPeriod = LED_HEARTBEAT_PERIOD_MS;
+static uint8_t ledFaults = 0u;
+static uint8_t ledPulsesLeft = 0u;
+static uint8_t ledIsOn = 0u;
+
+/*******************************************************************************
+* Function Name: LED_Write
+********************************************************************************
+*
+* Summary:
+*  This routine drives LED_R and accounts its on-time.
+*
+* Parameters:
+*  uint8_t on: 1 = LED on, 0 = LED off
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void LED_Write(uint8_t on)
+{
+    ledIsOn = on;
+    
+    if (on != 0u)
+    {
+        LED_R_Write(LED_ON);
+        Energy_LoadOn(ENERGY_LOAD_LED);
+    }
+    else
+    {
+        LED_R_Write(LED_OFF);
+        Energy_LoadOff(ENERGY_LOAD_LED);
+    }
+}
+
+/*******************************************************************************
+* Function Name: LED_StartSequence
+********************************************************************************
+*
+* Summary:
+*  This routine works out the pulses of the next period and schedules the
+*  first one. Faults take precedence over the heartbeat.
+*
+* Parameters:
+*  uint32 delayMs: Delay until the first pulse
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void LED_StartSequence(uint32 delayMs)
+{
+    ledPulsesLeft = 0u;
+    
+    if ((ledMode != LED_MODE_OFF) && (ledFaults != 0u))
+    {
+        ledPulsesLeft = ledFaults;
+    }
+    else if (ledMode == LED_MODE_HEARTBEAT)
+    {
+        ledPulsesLeft = 1u;
+    }
+    else
+    {
+        /* Nothing to show */
+    }
+    
+    if (ledPulsesLeft != 0u)
+    {
+        Sched_Start(SCHED_TASK_LED, delayMs, 0u);
+    }
+    else
+    {
+        Sched_Stop(SCHED_TASK_LED);
+    }
+}
+
+/*******************************************************************************
+* Function Name: LED_Init
+********************************************************************************
+*
+* Summary:
+*  This routine registers the LED task and lights the LED for the startup
+*  indication. The indication ends asynchronously, the BLE stack keeps
+*  running meanwhile.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void LED_Init(void)
+{
+    Sched_Register(SCHED_TASK_LED, &LED_Task);
+    
+    if (ledMode != LED_MODE_OFF)
+    {
+        LED_Write(1u);
+        ledPulsesLeft = 1u;
+        Sched_Start(SCHED_TASK_LED, LED_STARTUP_MS, 0u);
+    }
+    else
+    {
+        LED_Write(0u);
+    }
+}
+
+/*******************************************************************************
+* Function Name: LED_SetMode
+********************************************************************************
+*
+* Summary:
+*  This routine changes the LED policy. Takes effect immediately.
+*
+* Parameters:
+*  LED_MODE_T mode: New LED policy
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void LED_SetMode(LED_MODE_T mode)
+{
+    if (mode < LED_MODE_COUNT)
+    {
+        ledMode = mode;
+        LED_Write(0u);
+        LED_StartSequence(0u);
+    }
+}
+
+/*******************************************************************************
+* Function Name: LED_GetMode
+********************************************************************************
+*
+* Summary:
+*  This routine returns the current LED policy.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  LED_MODE_T mode: Current LED policy
+*
+*******************************************************************************/
+LED_MODE_T LED_GetMode(void)
+{
+    return ledMode;
+}
+
+/*******************************************************************************
+* Function Name: LED_SetHeartbeatPeriod
+********************************************************************************
+*
+* Summary:
+*  This routine changes the heartbeat period, applied from the next period.
+*
+* Parameters:
+*  uint32 periodMs: Heartbeat period in ms
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void LED_SetHeartbeatPeriod(uint32 periodMs)
+{
+    ledHeartbeatPeriod = periodMs;
+}
+
+/*******************************************************************************
+* Function Name: LED_SetFault
+********************************************************************************
+*
+* Summary:
+*  This routine raises a fault. The blink code starts right away if the LED
+*  is idle.
+*
+* Parameters:
+*  uint8_t fault: LED_FAULT_x mask
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void LED_SetFault(uint8_t fault)
+{
+    uint8_t previous = ledFaults;
+    
+    ledFaults |= fault;
+    
+    if ((ledFaults != previous) && (ledIsOn == 0u))
+    {
+        LED_StartSequence(0u);
+    }
+}
+
+/*******************************************************************************
+* Function Name: LED_ClearFault
+********************************************************************************
+*
+* Summary:
+*  This routine clears a fault, applied from the next period.
+*
+* Parameters:
+*  uint8_t fault: LED_FAULT_x mask
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void LED_ClearFault(uint8_t fault)
+{
+    ledFaults &= (uint8_t)~fault;
+    
+    if ((ledMode == LED_MODE_ERROR_ONLY) && (ledFaults == 0u) && (ledIsOn == 0u))
+    {
+        Sched_Stop(SCHED_TASK_LED);
+    }
+}
+
+/*******************************************************************************
+* Function Name: LED_Task
+********************************************************************************
+*
+* Summary:
+*  This routine is run by the scheduler at every LED edge. A lit LED is
+*  switched off and the next pulse or the next period is scheduled, a dark
+*  LED is lit for LED_PULSE_MS.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void LED_Task(void)
+{
+    if (ledIsOn != 0u)
+    {
+        LED_Write(0u);
+        
+        if (ledPulsesLeft > 0u)
+        {
+            ledPulsesLeft--;
+        }
+        
+        if (ledPulsesLeft > 0u)
+        {
+            Sched_Start(SCHED_TASK_LED, LED_GAP_MS, 0u);
+        }
+        else
+        {
+            LED_StartSequence((ledFaults != 0u) ? LED_ERROR_PERIOD_MS : ledHeartbeatPeriod);
+        }
+    }
+    else
+    {
+        LED_Write(1u);
+        Sched_Start(SCHED_TASK_LED, LED_PULSE_MS, 0u);
+    }
+}
+
+/* [] END OF FILE */
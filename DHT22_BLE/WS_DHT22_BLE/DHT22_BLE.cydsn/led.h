@@ -0,0 +1,49 @@
+/* ========================================
+ * Filename:        led.h
+ * Description:     LED activity policy header file
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+#include <project.h>
+
+#ifndef __LED_H
+#define __LED_H
+
+/***************************************
+*        API Constants
+***************************************/
+#define LED_STARTUP_MS                              (500u)    /* Startup indication length */
+#define LED_PULSE_MS                                (5u)      /* On-time of a heartbeat or blink code pulse */
+#define LED_GAP_MS                                  (300u)    /* Off-time between blink code pulses */
+#define LED_HEARTBEAT_PERIOD_MS                     (10000u)  /* Default heartbeat period */
+#define LED_ERROR_PERIOD_MS                         (5000u)   /* Blink code repeat period */
+#define LED_DEFAULT_MODE                            (LED_MODE_HEARTBEAT)
+
+typedef enum
+{
+    LED_MODE_OFF = 0u,                              /* LED never lit */
+    LED_MODE_HEARTBEAT,                             /* One short pulse per period, blink codes on faults */
+    LED_MODE_ERROR_ONLY,                            /* Blink codes on faults only */
+    LED_MODE_COUNT
+} LED_MODE_T;
+
+/* Faults are a bitmask, the blink code shows the mask value as pulse count */
+#define LED_FAULT_SENSOR                            (0x01u)   /* DHT22 read failed */
+#define LED_FAULT_BLE                               (0x02u)   /* BLE stack or advertising error */
+
+/***************************************
+*        Function Prototypes
+***************************************/
+    void    LED_Init(void);                         // Show the startup indication, then run the policy
+    void    LED_SetMode(LED_MODE_T mode);
+    LED_MODE_T LED_GetMode(void);
+    void    LED_SetHeartbeatPeriod(uint32 periodMs);
+    void    LED_SetFault(uint8_t fault);
+    void    LED_ClearFault(uint8_t fault);
+    void    LED_Task(void);                         // Scheduler task, do not call directly
+#endif
+
+
+
+/* [] END OF FILE */
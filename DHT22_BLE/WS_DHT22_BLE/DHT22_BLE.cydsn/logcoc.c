@@ -0,0 +1,303 @@
+/* ========================================
+ * Filename:        logcoc.c
+ * Description:     L2CAP credit based channel log export source file
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+
+#include "logcoc.h"
+#include "histlog.h"
+#include "histfmt.h"
+
+/***************************************
+*        API Constants
+***************************************/
+#define LOGCOC_NO_CHANNEL                           (0u)
+#define LOGCOC_SDU_LEN_LEN                          (2u)     /* SDU length field of the first frame */
+
+static uint16 logCocCid = LOGCOC_NO_CHANNEL;        /* Local CID of the open channel */
+static uint16 logCocPeerMtu;                        /* Largest SDU the client accepts */
+static uint16 logCocPeerMps;                        /* Largest frame payload the client accepts */
+static uint16 logCocTxCredits;                      /* Frames the client can still take */
+static uint8 logCocActive = 0u;
+static uint8 logCocWritePending = 0u;               /* Waiting for CYBLE_EVT_L2CAP_CBFC_DATA_WRITE_IND */
+static uint32 logCocCursor = 0u;                    /* Next record to send */
+static uint8 logCocPacket[LOGCOC_SDU_MAX_LEN];
+
+/*******************************************************************************
+* Function Name: LogCoc_Close
+********************************************************************************
+*
+* Summary:
+*  This routine forgets the channel and stops the export.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void LogCoc_Close(void)
+{
+    logCocCid = LOGCOC_NO_CHANNEL;
+    logCocActive = 0u;
+    logCocWritePending = 0u;
+}
+
+/*******************************************************************************
+* Function Name: LogCoc_Command
+********************************************************************************
+*
+* Summary:
+*  This routine runs a command SDU, the same [opcode][uint32 cursor] as the
+*  history control point. Malformed commands are ignored.
+*
+* Parameters:
+*  const uint8* data: SDU
+*  uint16 len: SDU length
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void LogCoc_Command(const uint8* data, uint16 len)
+{
+    if (len != HISTFMT_CONTROL_WRITE_LEN) {
+        return;
+    }
+
+    if (data[0] == HISTFMT_OP_START) {
+        logCocCursor = (uint32)data[1] | ((uint32)data[2] << 8u) |
+                       ((uint32)data[3] << 16u) | ((uint32)data[4] << 24u);
+        logCocActive = 1u;
+    } else if (data[0] == HISTFMT_OP_STOP) {
+        logCocActive = 0u;
+    } else {
+        /* Unknown opcode */
+    }
+}
+
+/*******************************************************************************
+* Function Name: LogCoc_Start
+********************************************************************************
+*
+* Summary:
+*  This routine registers the log export LE_PSM, so a connected client can
+*  open the channel.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  CYBLE_API_RESULT_T: Result of the PSM registration
+*
+*******************************************************************************/
+CYBLE_API_RESULT_T LogCoc_Start(void)
+{
+    LogCoc_Close();
+    return CyBle_L2capCbfcRegisterPsm(HISTFMT_LE_PSM, LOGCOC_RX_CREDIT_LWM);
+}
+
+/*******************************************************************************
+* Function Name: LogCoc_EventHandler
+********************************************************************************
+*
+* Summary:
+*  This routine handles the L2CAP channel events. One channel is accepted at
+*  a time. Transmit credits from the client are counted here, receive
+*  credits are topped up whenever the stack reports the low mark.
+*
+* Parameters:
+*  uint32 event: CYBLE_EVT_L2CAP_CBFC_x event
+*  void* eventParam: Event parameter
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void LogCoc_EventHandler(uint32 event, void* eventParam)
+{
+    switch (event) {
+        case CYBLE_EVT_L2CAP_CBFC_CONN_IND:
+        {
+            CYBLE_L2CAP_CBFC_CONN_IND_PARAM_T* ind = (CYBLE_L2CAP_CBFC_CONN_IND_PARAM_T*)eventParam;
+            CYBLE_L2CAP_CBFC_CONNECT_PARAM_T param;
+
+            param.mtu = CYBLE_L2CAP_MTU;
+            param.mps = CYBLE_L2CAP_MPS;
+            param.credit = LOGCOC_RX_CREDITS;
+
+            if ((ind->psm != HISTFMT_LE_PSM) || (logCocCid != LOGCOC_NO_CHANNEL)) {
+                (void)CyBle_L2capCbfcConnectRsp(ind->lCid, CYBLE_L2CAP_CONNECTION_REFUSED_NO_RESOURCE, &param);
+            } else if (CyBle_L2capCbfcConnectRsp(ind->lCid, CYBLE_L2CAP_CONNECTION_SUCCESSFUL, &param) == CYBLE_ERROR_OK) {
+                logCocCid = ind->lCid;
+                logCocPeerMtu = ind->connParam.mtu;
+                logCocPeerMps = ind->connParam.mps;
+                logCocTxCredits = ind->connParam.credit;
+                logCocActive = 0u;
+                logCocWritePending = 0u;
+            } else {
+                /* Stays closed, the client retries */
+            }
+            break;
+        }
+
+        case CYBLE_EVT_L2CAP_CBFC_DISCONN_IND:
+            if (*(uint16*)eventParam == logCocCid) {
+                LogCoc_Close();
+            }
+            break;
+
+        case CYBLE_EVT_L2CAP_CBFC_DISCONN_CNF:
+            if (((CYBLE_L2CAP_CBFC_DISCONN_CNF_PARAM_T*)eventParam)->lCid == logCocCid) {
+                LogCoc_Close();
+            }
+            break;
+
+        case CYBLE_EVT_L2CAP_CBFC_DATA_READ:
+        {
+            CYBLE_L2CAP_CBFC_RX_PARAM_T* rx = (CYBLE_L2CAP_CBFC_RX_PARAM_T*)eventParam;
+
+            if ((rx->lCid == logCocCid) && (rx->result == CYBLE_L2CAP_RESULT_SUCCESS)) {
+                LogCoc_Command(rx->rxData, rx->rxDataLength);
+            }
+            break;
+        }
+
+        case CYBLE_EVT_L2CAP_CBFC_RX_CREDIT_IND:
+        {
+            CYBLE_L2CAP_CBFC_LOW_RX_CREDIT_PARAM_T* low = (CYBLE_L2CAP_CBFC_LOW_RX_CREDIT_PARAM_T*)eventParam;
+
+            if (low->lCid == logCocCid) {
+                (void)CyBle_L2capCbfcSendFlowControlCredit(logCocCid, LOGCOC_RX_CREDITS - low->credit);
+            }
+            break;
+        }
+
+        case CYBLE_EVT_L2CAP_CBFC_TX_CREDIT_IND:
+        {
+            CYBLE_L2CAP_CBFC_LOW_TX_CREDIT_PARAM_T* credit = (CYBLE_L2CAP_CBFC_LOW_TX_CREDIT_PARAM_T*)eventParam;
+
+            if (credit->lCid != logCocCid) {
+                break;
+            }
+            if (credit->result == CYBLE_L2CAP_RESULT_SUCCESS) {
+                logCocTxCredits += credit->credit;
+            } else {
+                /* Credit overflow, the specification requires a disconnect */
+                (void)CyBle_L2capDisconnectReq(logCocCid);
+                LogCoc_Close();
+            }
+            break;
+        }
+
+        case CYBLE_EVT_L2CAP_CBFC_DATA_WRITE_IND:
+            if (((CYBLE_L2CAP_CBFC_DATA_WRITE_PARAM_T*)eventParam)->lCid == logCocCid) {
+                logCocWritePending = 0u;
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+/*******************************************************************************
+* Function Name: LogCoc_Process
+********************************************************************************
+*
+* Summary:
+*  This routine sends the next data packet as one SDU, as large as both
+*  MTUs and the client's credits allow, so the stack never holds part of it
+*  back. The next one waits for the stack to report the previous one
+*  written.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void LogCoc_Process(void)
+{
+    uint32 cursor = logCocCursor;
+    uint16 sduLen = LOGCOC_SDU_MAX_LEN;
+    uint16 frames;
+    uint16 len;
+
+    if ((logCocCid == LOGCOC_NO_CHANNEL) || (logCocActive == 0u) || (logCocWritePending != 0u) ||
+        (CyBle_GattGetBusyStatus() != CYBLE_STACK_STATE_FREE)) {
+        return;
+    }
+
+    if (logCocTxCredits == 0u) {
+        return;
+    }
+
+    /* Shrink the SDU to the frames the client has given credits for, so a
+     * small credit window slows the export down instead of stalling it. The
+     * first frame also carries the SDU length. */
+    if (logCocPeerMtu < sduLen) {
+        sduLen = logCocPeerMtu;
+    }
+    if (((uint32)logCocTxCredits * logCocPeerMps) - LOGCOC_SDU_LEN_LEN < sduLen) {
+        sduLen = (uint16)(((uint32)logCocTxCredits * logCocPeerMps) - LOGCOC_SDU_LEN_LEN);
+    }
+    len = HistLog_ReadPacket(&cursor, logCocPacket, sduLen);
+    frames = (uint16)((len + LOGCOC_SDU_LEN_LEN + logCocPeerMps - 1u) / logCocPeerMps);
+
+    if (CyBle_L2capChannelDataWrite(cyBle_connHandle.bdHandle, logCocCid, logCocPacket, len) == CYBLE_ERROR_OK) {
+        logCocTxCredits -= frames;
+        logCocWritePending = 1u;
+        logCocCursor = cursor;
+
+        /* An empty packet ends the export */
+        if (len == HISTFMT_PACKET_HEADER_LEN) {
+            logCocActive = 0u;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: LogCoc_IsActive
+********************************************************************************
+*
+* Summary:
+*  This routine reports whether an export is in progress.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint8_t: 1 = export in progress
+*
+*******************************************************************************/
+uint8_t LogCoc_IsActive(void)
+{
+    return logCocActive;
+}
+
+/*******************************************************************************
+* Function Name: LogCoc_OnDisconnect
+********************************************************************************
+*
+* Summary:
+*  This routine closes the channel when the link drops. The client resumes
+*  on the next connection from the last index it received.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void LogCoc_OnDisconnect(void)
+{
+    LogCoc_Close();
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,39 @@
+/* ========================================
+ * Filename:        logcoc.h
+ * Description:     L2CAP credit based channel log export header file
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+#include <project.h>
+
+#ifndef __LOGCOC_H
+#define __LOGCOC_H
+
+/***************************************
+*        API Constants
+***************************************/
+/* Credits given to the client for command SDUs. The client only sends a
+ * few commands, so a small window that is topped up at the low mark is
+ * enough. */
+#define LOGCOC_RX_CREDITS                           (4u)
+#define LOGCOC_RX_CREDIT_LWM                        (1u)
+
+/* Largest SDU sent. The first frame of an SDU also carries the 2-byte SDU
+ * length, so an SDU of MPS - 2 bytes is one 131-byte frame; with its 4-byte
+ * L2CAP header that fills exactly five 27-byte LL PDUs. */
+#define LOGCOC_SDU_MAX_LEN                          (CYBLE_L2CAP_MPS - 2u)
+
+/***************************************
+*        Function Prototypes
+***************************************/
+    CYBLE_API_RESULT_T LogCoc_Start(void);                          // Register the LE_PSM, call after CYBLE_EVT_STACK_ON
+    void    LogCoc_EventHandler(uint32 event, void* eventParam);    // CYBLE_EVT_L2CAP_CBFC_x events
+    void    LogCoc_Process(void);                                   // Send the next SDU when credits allow, call from the main loop
+    uint8_t LogCoc_IsActive(void);                                  // 1 = export in progress
+    void    LogCoc_OnDisconnect(void);                              // The channel closes with the link
+#endif
+
+
+
+/* [] END OF FILE */
@@ -8,19 +8,43 @@
 
 #include <project.h>
 #include "dht22.h"
+#include "advupdate.h"
+#include "energy.h"
+#include "clkgov.h"
+#include "sched.h"
+#include "nvstore.h"
+#include "led.h"
+#include "advenc.h"
+#include "stats.h"
+#include "scanrsp.h"
+#include "advrate.h"
+#include "radio.h"
+#include "advauth.h"
+#include "ess.h"
+#include "histlog.h"
+#include "histxfer.h"
+#include "logcoc.h"
+#include "connparam.h"
+#include "batch.h"
+#include "config.h"
+#include "rtc.h"
+#include "diag.h"
+#include "status.h"
 
 /***************************************
 *        API Constants
 ***************************************/
-#define LED_ON                                      (0u)
-#define LED_OFF                                     (1u)
-
 #define LOOP_DELAY                                  (1u)  /* How often would you like to update the ADV payload */
 
-/* ADV payload dta structure */   
-#define advPayload                                  (cyBle_discoveryModeInfo.advData->advData) /* DHT22 xx.xC xx%*/
-#define TEMPERATURE_INDEX                           (11u) /* 11 - 14 */
-#define HUMIDITY_INDEX                              (17u) /* 17 - 18 */
+#define DHT22_POWERUP_MS                            (1000u)   /* DHT22 ignores commands for 1s after power-up */
+#define NV_READING_SAVE_INTERVAL                    (30u)     /* Save every n-th valid reading to flash */
+#define SENSOR_MIN_GAP_MS                           (2000u)   /* DHT22 needs 2s between reads */
+
+/* On-demand read requested through the Immediate Alert Service */
+#define SAMPLE_NOW_IDLE                             (0u)
+#define SAMPLE_NOW_READ                             (1u)      /* Out-of-cycle read scheduled */
+#define SAMPLE_NOW_ADVERTISE                        (2u)      /* Read done while connected, burst once disconnected */
+
 
 /***************************************
 *        Function Prototypes
@@ -28,58 +52,232 @@
 void InitializeSystem(void);
 void StackEventHandler(uint32 event, void* eventParam);
 void EnterLowPowerMode(void);
-void DynamicADVPayloadUpdate(int16_t temperature, uint16_t humidity);
+void DynamicADVPayloadUpdate(int16_t temperature, uint16_t humidity, uint8_t status);
+void SensorTask(void);
+void GattWriteRequest(CYBLE_GATTS_WRITE_REQ_PARAM_T* request);
+void IasEventHandler(uint32 event, void* eventParam);
+void SampleNow(void);
+
+/* Last valid reading, advertised with ADVFMT_FLAG_SENSOR_ERROR when a read fails */
+static int16_t lastTemperatureX10 = ADVFMT_TEMPERATURE_NO_DATA;
+static uint16_t lastHumidityX10 = ADVFMT_HUMIDITY_NO_DATA;
+static uint8_t lastStatus = ADVFMT_FLAG_NO_DATA;
+
+static uint32 sensorLastTicks = 0u;                 /* Scheduler time of the last read */
+static uint8_t sensorReadDone = 0u;                 /* 1 once the sensor has been read */
+static uint8_t sampleNowState = SAMPLE_NOW_IDLE;
+static uint8_t nvRecordValid = 0u;                  /* 1 = the boot count continues a stored record */
 
 int main (void)
 {
-    uint8_t sleep_counter = 10;
-    
+#if (ADVRATE_MODE == ADVRATE_MODE_CONNECTABLE)
+    /* Before anything else runs, so the stack high-water mark covers it all */
+    Diag_Init();
+#endif /* (ADVRATE_MODE == ADVRATE_MODE_CONNECTABLE) */
     InitializeSystem();
     
-    /* Flash LED on startup */
-    LED_R_Write(LED_ON);
-    CyDelay(500);
-    LED_R_Write(LED_OFF);
+    /* Flash LED on startup, then run the LED policy from the scheduler */
+    LED_Init();
+    
+    /* Read the sensor as soon as its power-up time has elapsed */
+    Sched_Register(SCHED_TASK_SENSOR, &SensorTask);
+    Sched_Start(SCHED_TASK_SENSOR, DHT22_POWERUP_MS, Config_GetSensorPeriodMs());
     
     for(;;)
     {
+        ClkGov_SetLevel(CLKGOV_LEVEL_MEDIUM);
+        
         /* Single API call to service all the BLE stack events. Must be
          * called at least once in a BLE connection interval */
+        Energy_BeginTask(ENERGY_TASK_BLE);
         CyBle_ProcessEvents();
+#if (ADVRATE_MODE == ADVRATE_MODE_CONNECTABLE)
+        HistXfer_Process();
+        LogCoc_Process();
+        Batch_Process();
+        ConnParam_SetBulk(HistXfer_IsActive() | LogCoc_IsActive());
+#endif /* (ADVRATE_MODE == ADVRATE_MODE_CONNECTABLE) */
+        Energy_EndTask(ENERGY_TASK_BLE);
+        ClkGov_SetLevel(CLKGOV_LEVEL_LOW);
         
-        uint8_t dht22_data[5] = { 0 };
-
-        // Read the sensor every x seconds
-        if (sleep_counter > 9) {
-            sleep_counter = 0;
-            
-            // Read the sensor and store in an array
-            if (DHT22_Read_Data(dht22_data) != 0) {
-                dht22_data[0] = 9;
-                dht22_data[1] = 9;
-                dht22_data[2] = 9;
-                dht22_data[3] = 9;
-            }
-            
-            // Extract the sensor data from the array
-            int16_t temperatureX100 = DHT22_getTemperatureX100(dht22_data);
-            uint16_t humidityX10 = DHT22_getHumidityX10(dht22_data);
-            
-            // Update the advertized device name
-            DynamicADVPayloadUpdate(temperatureX100, humidityX10);
+        /* Commit a staged ADV payload once the current ADV event has closed */
+        Energy_BeginTask(ENERGY_TASK_ADV);
+        ADV_ProcessPendingUpdate();
+        Energy_EndTask(ENERGY_TASK_ADV);
+        
+        /* A boot count epoch started at a sequence wrap may be signed once it is in flash */
+        if((NV_ProcessPendingSave() != 0u) && (nvRecordValid != 0u))
+        {
+            AdvAuth_SetEpoch(NV_GetData()->bootCount);
         }
-                
-        LED_R_Write(LED_OFF);
+#if (ADVRATE_MODE == ADVRATE_MODE_CONNECTABLE)
+        Config_Process();
+#endif /* (ADVRATE_MODE == ADVRATE_MODE_CONNECTABLE) */
+        
+        /* Run the sensor read, LED policy and any other task that is due */
+        Sched_Dispatch();
         
         /* Configure the system in lowest possible power modes during and between BLE ADV events */
+        Energy_BeginTask(ENERGY_TASK_SLEEP);
         EnterLowPowerMode();
+        Energy_EndTask(ENERGY_TASK_SLEEP);
+    }
+}
+
+/*******************************************************************************
+* Function Name: SensorTask
+********************************************************************************
+*
+* Summary:
+*  This routine reads the DHT22 and stages an ADV payload update. Every
+*  NV_READING_SAVE_INTERVAL-th valid reading, and the first one after boot,
+*  is saved so it can be advertised right after the next power-up.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void SensorTask(void)
+{
+    static uint8_t save_counter = 0;
+    uint8_t dht22_data[5] = { 0 };
+    uint8_t status;
+    
+    // Read the sensor and store in an array, the bit timing needs the full clock
+    sensorLastTicks = Sched_GetTicks();
+    sensorReadDone = 1u;
+    ClkGov_SetLevel(CLKGOV_LEVEL_HIGH);
+    Energy_BeginTask(ENERGY_TASK_SENSOR);
+    uint8_t dht22_error = DHT22_Read_Data(dht22_data);
+    Energy_EndTask(ENERGY_TASK_SENSOR);
+    ClkGov_SetLevel(CLKGOV_LEVEL_LOW);
+    
+    // Extract the sensor data from the array, or flag the last valid reading as stale
+    if (dht22_error != 0) {
+        LED_SetFault(LED_FAULT_SENSOR);
+        status = lastStatus | ADVFMT_FLAG_SENSOR_ERROR;
+    } else {
+        lastTemperatureX10 = DHT22_getTemperatureX10(dht22_data);
+        lastHumidityX10 = DHT22_getHumidityX10(dht22_data);
+        lastStatus = 0u;
+        status = 0u;
+#if (ADVRATE_MODE != ADVRATE_MODE_BROADCAST)
+        Stats_Add(lastTemperatureX10, lastHumidityX10);
+#endif /* (ADVRATE_MODE != ADVRATE_MODE_BROADCAST) */
+    }
+    
+    // Update the advertised reading, and the scan response statistics if they moved
+    Energy_BeginTask(ENERGY_TASK_ADV);
+    DynamicADVPayloadUpdate(lastTemperatureX10, lastHumidityX10, status);
+#if (ADVRATE_MODE != ADVRATE_MODE_BROADCAST)
+    (void)ScanRsp_Update();
+#endif /* (ADVRATE_MODE != ADVRATE_MODE_BROADCAST) */
+    Energy_EndTask(ENERGY_TASK_ADV);
+    
+    // Push the reading to a connected client if it moved past the trigger,
+    // queue it for batch notifications, and keep it for a later history download
+#if (ADVRATE_MODE == ADVRATE_MODE_CONNECTABLE)
+    Ess_Update(lastTemperatureX10, lastHumidityX10, status);
+    Batch_Add(lastTemperatureX10, lastHumidityX10, status);
+    HistLog_Add(lastTemperatureX10, lastHumidityX10, status);
+#endif /* (ADVRATE_MODE == ADVRATE_MODE_CONNECTABLE) */
+    
+    // Advertise fast for a moment if the reading changed significantly
+    if (dht22_error == 0) {
+        AdvRate_OnReading(lastTemperatureX10, lastHumidityX10);
+    }
+    
+    // Keep the last valid reading for the fast-boot path
+    if (dht22_error == 0) {
+        LED_ClearFault(LED_FAULT_SENSOR);
         
-        sleep_counter += 1;
+        if (save_counter == 0) {
+            NV_DATA_T* nv = NV_GetData();
+            nv->temperatureX10 = lastTemperatureX10;
+            nv->humidityX10 = lastHumidityX10;
+            nv->readingValid = 1u;
+            NV_RequestSave();
+        }
         
-        LED_R_Write(LED_ON);
+        save_counter += 1;
+        if (save_counter >= NV_READING_SAVE_INTERVAL) {
+            save_counter = 0;
+        }
+    }
+    
+    // Advertise an on-demand reading fast. A connected client reads it over
+    // GATT, scanners get the burst once it has disconnected.
+    if (sampleNowState == SAMPLE_NOW_READ) {
+        if (CyBle_GetState() == CYBLE_STATE_CONNECTED) {
+            sampleNowState = SAMPLE_NOW_ADVERTISE;
+        } else {
+            sampleNowState = SAMPLE_NOW_IDLE;
+            AdvRate_Burst();
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: SampleNow
+********************************************************************************
+*
+* Summary:
+*  This routine moves the next sensor read forward to now, or to as soon as
+*  the DHT22 allows, and restarts the sensor period from there. A gateway
+*  asks for fresh data this way instead of every node sampling fast.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void SampleNow(void)
+{
+    uint32 elapsedMs = (uint32)(((uint64)(Sched_GetTicks() - sensorLastTicks) * 1000u) >> 15u);
+    
+    sampleNowState = SAMPLE_NOW_READ;
+    
+    /* Before the first read the power-up delay is still running */
+    if (sensorReadDone == 0u) {
+        return;
     }
+    
+    Sched_Start(SCHED_TASK_SENSOR,
+                (elapsedMs < SENSOR_MIN_GAP_MS) ? (SENSOR_MIN_GAP_MS - elapsedMs) : 0u,
+                Config_GetSensorPeriodMs());
 }
 
+#if (ADVRATE_MODE == ADVRATE_MODE_CONNECTABLE)
+/*******************************************************************************
+* Function Name: IasEventHandler
+********************************************************************************
+*
+* Summary:
+*  This routine handles writes to the Immediate Alert Service Alert Level.
+*  Any level other than No Alert asks for an on-demand reading.
+*
+* Parameters:
+*  uint32 event: CYBLE_EVT_IASS_x event
+*  void* eventParam: Event parameter
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void IasEventHandler(uint32 event, void* eventParam)
+{
+    CYBLE_IAS_CHAR_VALUE_T* param = (CYBLE_IAS_CHAR_VALUE_T*)eventParam;
+    
+    if ((event == (uint32)CYBLE_EVT_IASS_WRITE_CHAR_CMD) && (param->value->val[0] != CYBLE_NO_ALERT)) {
+        SampleNow();
+    }
+}
+#endif /* (ADVRATE_MODE == ADVRATE_MODE_CONNECTABLE) */
 
 /*******************************************************************************
 * Function Name: InitializeSystem
@@ -98,10 +296,60 @@ int main (void)
 void InitializeSystem(void)
 {
     CYBLE_API_RESULT_T apiResult;
+    uint8_t nvError;
 
     CyGlobalIntEnable;
     
     //DHT22_Init();
+    
+    /* Load the ADV layout of the selected encoder */
+    AdvEnc_Init(cyBle_discoveryModeInfo.advData);
+    AdvAuth_Init();
+    
+    /* Publish rolling statistics in the scan response, active scanners fetch it anyway.
+     * Non-connectable advertising has no scan response. */
+#if (ADVRATE_MODE != ADVRATE_MODE_BROADCAST)
+    Stats_Init();
+    ScanRsp_Init(cyBle_discoveryModeInfo.scanRspData);
+#endif /* (ADVRATE_MODE != ADVRATE_MODE_BROADCAST) */
+    
+    AdvRate_Init();
+    Radio_Init(RADIO_DEFAULT_PROFILE);
+    
+    /* GATT services and the log channel, a broadcaster build leaves them out */
+#if (ADVRATE_MODE == ADVRATE_MODE_CONNECTABLE)
+    ConnParam_Init();
+    Ess_Init();
+    Rtc_Init();
+    HistLog_Init();
+    HistXfer_Init();
+    Batch_Init();
+#endif /* (ADVRATE_MODE == ADVRATE_MODE_CONNECTABLE) */
+    
+    /* Count boots so scanners can tell a reset sequence counter from lost samples.
+     * The boot count is part of the signing nonce, so it is saved before anything
+     * is signed. Without a valid record it may restart at a count used before,
+     * so nothing is signed until the next boot. */
+    nvError = NV_Init();
+    NV_GetData()->bootCount += 1u;
+    if ((NV_Save() == 0u) && (nvError == 0u)) {
+        nvRecordValid = 1u;
+        AdvAuth_SetEpoch(NV_GetData()->bootCount);
+    }
+#if (ADVRATE_MODE == ADVRATE_MODE_CONNECTABLE)
+    Status_Init(NV_GetData()->bootCount);
+#endif /* (ADVRATE_MODE == ADVRATE_MODE_CONNECTABLE) */
+    
+    /* Replace the compile-time defaults with the settings a client stored */
+    Config_Init();
+    
+    /* Restore the last reading, it is advertised from CYBLE_EVT_STACK_ON on. With
+     * no saved reading the encoder's placeholder is advertised until the first read */
+    if ((nvError == 0) && (NV_GetData()->readingValid != 0u)) {
+        lastTemperatureX10 = NV_GetData()->temperatureX10;
+        lastHumidityX10 = NV_GetData()->humidityX10;
+        lastStatus = ADVFMT_FLAG_RESTORED;
+    }
 
     apiResult = CyBle_Start(StackEventHandler); /* Init the BLE stack and register an applicaiton callback */
 
@@ -111,11 +359,22 @@ void InitializeSystem(void)
         CYASSERT(0);
     }
     
+#if defined(CYBLE_IAS_SERVER) && (ADVRATE_MODE == ADVRATE_MODE_CONNECTABLE)
+    CyBle_IasRegisterAttrCallback(&IasEventHandler);
+#endif /* defined(CYBLE_IAS_SERVER) && (ADVRATE_MODE == ADVRATE_MODE_CONNECTABLE) */
+    
     /* Set XTAL divider to 3MHz mode */
     CySysClkWriteEcoDiv(CY_SYS_CLK_ECO_DIV8); 
     
     /* ILO is no longer required, shut it down */
     CySysClkIloStop();
+    
+    /* Start the LFCLK timebase, then the SysTick timebase used for energy accounting */
+    Sched_Init();
+    Energy_Init();
+    
+    /* Run from a divided SYSCLK unless timing-critical work needs more */
+    ClkGov_Init();
 }
 
 /*******************************************************************************
@@ -151,7 +410,18 @@ void EnterLowPowerMode(void)
     if(blessState == CYBLE_BLESS_STATE_ECO_ON || 
         blessState == CYBLE_BLESS_STATE_DEEPSLEEP)
     {
+        Sched_PrepareSleep();
+        Energy_EnterLowPower(ENERGY_MODE_DEEPSLEEP);
         CySysPmDeepSleep();
+        Energy_ExitLowPower();
+    }
+    else if(blessState != CYBLE_BLESS_STATE_EVENT_CLOSE)
+    {
+        /* The radio is busy, stop the CPU until its next interrupt. During
+         * event close CyBle_ProcessEvents() has to run first */
+        Energy_EnterLowPower(ENERGY_MODE_SLEEP);
+        CySysPmSleep();
+        Energy_ExitLowPower();
     }
     else
     {
@@ -181,57 +451,224 @@ void EnterLowPowerMode(void)
 *******************************************************************************/
 void StackEventHandler(uint32 event, void *eventParam)
 {
+    uint8 startFault;
+    
     switch(event)
     {
         /* Mandatory events to be handled by Find Me Target design */
         case CYBLE_EVT_STACK_ON:
+            /* Start with a short fast advertising burst so scanners pick up
+             * the restored reading right after power-up. It is encoded only now,
+             * once the AES engine can sign it. */
+            Radio_Apply();
+            (void)AdvAuth_Start();
+            if((sensorReadDone == 0u) && (lastStatus == ADVFMT_FLAG_RESTORED))
+            {
+                DynamicADVPayloadUpdate(lastTemperatureX10, lastHumidityX10, lastStatus);
+                ADV_ProcessPendingUpdate();
+            }
+#if (ADVRATE_MODE == ADVRATE_MODE_CONNECTABLE)
+            Ess_Publish();
+            Config_Publish();
+            Status_Publish();
+#endif /* (ADVRATE_MODE == ADVRATE_MODE_CONNECTABLE) */
+            AdvRate_Burst();
+            startFault = (AdvRate_Start() != CYBLE_ERROR_OK) ? 1u : 0u;
+#if (ADVRATE_MODE == ADVRATE_MODE_CONNECTABLE)
+            /* Register the PSM even when advertising failed to start */
+            if(LogCoc_Start() != CYBLE_ERROR_OK)
+            {
+                startFault = 1u;
+            }
+#endif /* (ADVRATE_MODE == ADVRATE_MODE_CONNECTABLE) */
+            if(startFault != 0u)
+            {
+                LED_SetFault(LED_FAULT_BLE);
+            }
+          break;
+          
+#if (ADVRATE_MODE == ADVRATE_MODE_CONNECTABLE)
+        case CYBLE_EVT_GAP_DEVICE_CONNECTED:
+            ConnParam_OnConnect((CYBLE_GAP_CONN_PARAM_UPDATED_IN_CONTROLLER_T*)eventParam);
+            break;
+            
+        case CYBLE_EVT_GAP_CONNECTION_UPDATE_COMPLETE:
+            ConnParam_OnUpdate((CYBLE_GAP_CONN_PARAM_UPDATED_IN_CONTROLLER_T*)eventParam);
+            break;
+            
+        case CYBLE_EVT_L2CAP_CONN_PARAM_UPDATE_RSP:
+            ConnParam_OnResponse(*(uint16*)eventParam);
+            break;
+            
         case CYBLE_EVT_GAP_DEVICE_DISCONNECTED:
-            CyBle_GappStartAdvertisement(CYBLE_ADVERTISING_SLOW);
+            ConnParam_OnDisconnect();
+            Ess_OnDisconnect();
+            Rtc_OnDisconnect();
+            HistXfer_OnDisconnect();
+            Batch_OnDisconnect();
+            if(sampleNowState == SAMPLE_NOW_ADVERTISE)
+            {
+                sampleNowState = SAMPLE_NOW_IDLE;
+                AdvRate_Burst();
+            }
+            LogCoc_OnDisconnect();
+            if(AdvRate_Start() != CYBLE_ERROR_OK)
+            {
+                LED_SetFault(LED_FAULT_BLE);
+            }
           break;
+#endif /* (ADVRATE_MODE == ADVRATE_MODE_CONNECTABLE) */
 
         case CYBLE_EVT_GAPP_ADVERTISEMENT_START_STOP:
             if(CyBle_GetState() == CYBLE_STATE_DISCONNECTED)
             {
-
+                /* Stopped to change the interval, restart at the new level */
+                if(AdvRate_Start() != CYBLE_ERROR_OK)
+                {
+                    LED_SetFault(LED_FAULT_BLE);
+                }
+            }
+            else if(CyBle_GetState() == CYBLE_STATE_ADVERTISING)
+            {
+                LED_ClearFault(LED_FAULT_BLE);
             }
             break;
+            
+#if (ADVRATE_MODE == ADVRATE_MODE_CONNECTABLE)
+        case CYBLE_EVT_GATTS_WRITE_REQ:
+            GattWriteRequest((CYBLE_GATTS_WRITE_REQ_PARAM_T*)eventParam);
+            break;
+            
+        /* Values computed when read */
+        case CYBLE_EVT_GATTS_READ_CHAR_VAL_ACCESS_REQ:
+            Rtc_ReadRequest((CYBLE_GATTS_CHAR_VAL_READ_REQ_T*)eventParam);
+            Diag_ReadRequest((CYBLE_GATTS_CHAR_VAL_READ_REQ_T*)eventParam);
+            break;
+            
+        /* Log export channel */
+        case CYBLE_EVT_L2CAP_CBFC_CONN_IND:
+        case CYBLE_EVT_L2CAP_CBFC_DISCONN_IND:
+        case CYBLE_EVT_L2CAP_CBFC_DISCONN_CNF:
+        case CYBLE_EVT_L2CAP_CBFC_DATA_READ:
+        case CYBLE_EVT_L2CAP_CBFC_RX_CREDIT_IND:
+        case CYBLE_EVT_L2CAP_CBFC_TX_CREDIT_IND:
+        case CYBLE_EVT_L2CAP_CBFC_DATA_WRITE_IND:
+            LogCoc_EventHandler(event, eventParam);
+            break;
+#endif /* (ADVRATE_MODE == ADVRATE_MODE_CONNECTABLE) */
+            
+        case CYBLE_EVT_HARDWARE_ERROR:
+            LED_SetFault(LED_FAULT_BLE);
+            break;
 
         default:
         break;
     }
 }
 
+#if (ADVRATE_MODE == ADVRATE_MODE_CONNECTABLE)
 /*******************************************************************************
-* Function Name: DynamicADVPayloadUpdate
+* Function Name: GattWriteRequest
 ********************************************************************************
 *
 * Summary:
-*  This routine dynamically updates the BLE advertisement packet
+*  This routine hands a write request the BLE Component did not handle to the
+*  service that owns the attribute, and sends the response.
 *
 * Parameters:
-*  None
+*  CYBLE_GATTS_WRITE_REQ_PARAM_T* request: Write request from the client
 *
 * Return:
 *  None
 *
 *******************************************************************************/
-void DynamicADVPayloadUpdate(int16_t temperature, uint16_t humidity)
+void GattWriteRequest(CYBLE_GATTS_WRITE_REQ_PARAM_T* request)
 {
-    if(CyBle_GetBleSsState() == CYBLE_BLESS_STATE_EVENT_CLOSE)
-    {   
-        /* Once the system enters Sleep/Deepsleep mode during advertisement, the source of wake-up is the next  
-         * advertisement interval which has a wakeup interval of 1 advertisement (ADV) interval (100ms). 
-         * LOOP_DELAY * ADV interval is the interval after which ADV data is updated in this firmware.*/
-        
-        advPayload[TEMPERATURE_INDEX] = ('0' + (uint8_t)(temperature / 100));
-        advPayload[TEMPERATURE_INDEX + 1] = ('0' + (uint8_t)((temperature / 10) % 10));
-        advPayload[TEMPERATURE_INDEX + 3] = ('0' + (uint8_t)(temperature % 10));
-        
-        advPayload[HUMIDITY_INDEX] = ('0' + (uint8_t)((humidity / 100) % 10));
-        advPayload[HUMIDITY_INDEX + 1] = ('0' + (uint8_t)((humidity / 10) % 10));
+    CYBLE_GATT_ERR_CODE_T gattErr;
+    
+    gattErr = Ess_WriteRequest(request);
+    if(gattErr == CYBLE_GATT_ERR_ATTRIBUTE_NOT_FOUND)
+    {
+        gattErr = HistXfer_WriteRequest(request);
+    }
+    if(gattErr == CYBLE_GATT_ERR_ATTRIBUTE_NOT_FOUND)
+    {
+        gattErr = Batch_WriteRequest(request);
+    }
+    if(gattErr == CYBLE_GATT_ERR_ATTRIBUTE_NOT_FOUND)
+    {
+        gattErr = Config_WriteRequest(request);
+    }
+    if(gattErr == CYBLE_GATT_ERR_ATTRIBUTE_NOT_FOUND)
+    {
+        gattErr = Rtc_WriteRequest(request);
+    }
+    
+    if(gattErr == CYBLE_GATT_ERR_NONE)
+    {
+        (void)CyBle_GattsWriteRsp(request->connHandle);
+    }
+    else
+    {
+        CYBLE_GATTS_ERR_PARAM_T errParam;
         
-        CyBle_GapUpdateAdvData(cyBle_discoveryModeInfo.advData, cyBle_discoveryModeInfo.scanRspData);
+        errParam.opcode = (uint8)CYBLE_GATT_WRITE_REQ;
+        errParam.attrHandle = request->handleValPair.attrHandle;
+        errParam.errorCode = gattErr;
+        (void)CyBle_GattsErrorRsp(request->connHandle, &errParam);
     }
 }
+#endif /* (ADVRATE_MODE == ADVRATE_MODE_CONNECTABLE) */
+
+/*******************************************************************************
+* Function Name: DynamicADVPayloadUpdate
+********************************************************************************
+*
+* Summary:
+*  This routine stages a BLE advertisement packet update. The staged payload
+*  is committed by ADV_ProcessPendingUpdate() at the next BLESS event-close,
+*  so every sample reaches the air within one advertisement interval.
+*
+* Parameters:
+*  int16_t temperature: Temperature x 10
+*  uint16_t humidity: Humidity x 10
+*  uint8_t status: ADVFMT_FLAG_x describing the reading
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void DynamicADVPayloadUpdate(int16_t temperature, uint16_t humidity, uint8_t status)
+{
+    static uint32 sampleCount = 0u;
+    ADV_SAMPLE_T sample;
+    uint32 superseded;
+    
+    sample.temperatureX10 = temperature;
+    sample.humidityX10 = humidity;
+    /* Start a new boot count epoch when the 16-bit sequence wraps, so
+     * (boot count, sequence) never repeats */
+    sampleCount += 1u;
+    if (LO16(sampleCount) == 0u) {
+        NV_GetData()->bootCount += 1u;
+        NV_RequestSave();
+        sampleCount += 1u;
+    }
+    
+    sample.sampleCount = sampleCount;
+    sample.uptimeDs = (uint32)((Sched_GetTicks64() * 10u) >> 15u);
+    ADV_GetUpdateCounts(&sample.advCount, &superseded);
+    sample.status = status;
+    sample.bootCount = NV_GetData()->bootCount;
+    
+    /* The payload layout comes from the encoder selected with ADV_ENCODER */
+    AdvEnc_Encode(ADV_BeginUpdate(), &sample);
+    ADV_EndUpdate();
+    
+#if (ADVRATE_MODE == ADVRATE_MODE_CONNECTABLE)
+    /* The same sample for clients reading it in one ATT request */
+    Status_Update(&sample);
+#endif /* (ADVRATE_MODE == ADVRATE_MODE_CONNECTABLE) */
+}
 
 /* [] END OF FILE */
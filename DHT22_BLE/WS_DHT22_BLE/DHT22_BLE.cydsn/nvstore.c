@@ -0,0 +1,231 @@
+/* ========================================
+ * Filename:        nvstore.c
+ * Description:     Non-volatile storage in emulated EEPROM source file
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+
+#include "nvstore.h"
+#include <string.h>
+
+/* Emulated EEPROM storage in user flash, must be flash row aligned */
+#if defined (__ICCARM__)
+    #pragma data_alignment = CY_EM_EEPROM_FLASH_SIZEOF_ROW
+    const uint8 nvEeprom[NV_PHYSICAL_SIZE] = {0u};
+#else
+    const uint8 nvEeprom[NV_PHYSICAL_SIZE] CY_ALIGN(CY_EM_EEPROM_FLASH_SIZEOF_ROW) = {0u};
+#endif /* (__ICCARM__) */
+
+static cy_stc_eeprom_context_t nvContext;
+static NV_DATA_T nvData;
+static volatile uint8_t savePending = 0u;
+
+/*******************************************************************************
+* Function Name: NV_Init
+********************************************************************************
+*
+* Summary:
+*  This routine initializes the emulated EEPROM and loads the record into RAM.
+*  A blank or corrupted record is replaced by a zeroed one.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint8_t error: 1 = no valid record found, 0 = record loaded
+*
+*******************************************************************************/
+uint8_t NV_Init(void)
+{
+    cy_stc_eeprom_config_t config;
+    
+    config.eepromSize = NV_EEPROM_SIZE;
+    config.wearLevelingFactor = NV_WEAR_LEVELING;
+    config.redundantCopy = 0u;
+    config.blockingWrite = 1u;
+    config.userFlashStartAddr = (uint32)nvEeprom;
+    
+    if ((Cy_Em_EEPROM_Init(&config, &nvContext) == CY_EM_EEPROM_SUCCESS) &&
+        (Cy_Em_EEPROM_Read(NV_DATA_ADDR, &nvData, sizeof(nvData), &nvContext) == CY_EM_EEPROM_SUCCESS) &&
+        (nvData.magic == NV_MAGIC))
+    {
+        return 0;
+    }
+    
+    (void)memset(&nvData, 0, sizeof(nvData));
+    nvData.magic = NV_MAGIC;
+    return 1;
+}
+
+/*******************************************************************************
+* Function Name: NV_GetData
+********************************************************************************
+*
+* Summary:
+*  This routine returns the RAM copy of the record. Call NV_RequestSave()
+*  after modifying it.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  NV_DATA_T*: Pointer to the RAM copy of the record
+*
+*******************************************************************************/
+NV_DATA_T* NV_GetData(void)
+{
+    return &nvData;
+}
+
+/*******************************************************************************
+* Function Name: NV_RequestSave
+********************************************************************************
+*
+* Summary:
+*  This routine requests the RAM copy to be written to flash. The write is
+*  done by NV_ProcessPendingSave().
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void NV_RequestSave(void)
+{
+    savePending = 1u;
+}
+
+/*******************************************************************************
+* Function Name: NV_ProcessPendingSave
+********************************************************************************
+*
+* Summary:
+*  This routine writes a pending record to flash once NV_CanWrite() allows it.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint8_t written: 1 = record written, 0 = nothing written
+*
+*******************************************************************************/
+uint8_t NV_ProcessPendingSave(void)
+{
+    uint8_t written = 0u;
+    
+    if ((savePending != 0u) && (NV_CanWrite() != 0u))
+    {
+        if (NV_Write(NV_DATA_ADDR, &nvData, sizeof(nvData)) == 0u)
+        {
+            savePending = 0u;
+            written = 1u;
+        }
+    }
+    
+    return written;
+}
+
+/*******************************************************************************
+* Function Name: NV_Save
+********************************************************************************
+*
+* Summary:
+*  This routine writes the RAM copy to flash now and reads it back, for data
+*  that must be in flash before it is used. The caller makes sure
+*  NV_CanWrite() allows the write. A pending save is cleared.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint8_t error: 0 = written and read back, 1 = failed
+*
+*******************************************************************************/
+uint8_t NV_Save(void)
+{
+    NV_DATA_T check;
+    
+    if ((NV_Write(NV_DATA_ADDR, &nvData, sizeof(nvData)) != 0u) ||
+        (NV_Read(NV_DATA_ADDR, &check, sizeof(check)) != 0u) ||
+        (memcmp(&check, &nvData, sizeof(check)) != 0))
+    {
+        return 1u;
+    }
+    
+    savePending = 0u;
+    return 0u;
+}
+
+/*******************************************************************************
+* Function Name: NV_CanWrite
+********************************************************************************
+*
+* Summary:
+*  This routine tells whether a flash row write can start now. A write stalls
+*  the CPU for several ms, so while advertising or connected it is only
+*  started right after a BLESS event has closed.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint8_t: 1 = write now, 0 = wait for the next event close
+*
+*******************************************************************************/
+uint8_t NV_CanWrite(void)
+{
+    CYBLE_STATE_T state = CyBle_GetState();
+    
+    return ((((state != CYBLE_STATE_ADVERTISING) && (state != CYBLE_STATE_CONNECTED)) ||
+             (CyBle_GetBleSsState() == CYBLE_BLESS_STATE_EVENT_CLOSE)) ? 1u : 0u);
+}
+
+/*******************************************************************************
+* Function Name: NV_Read
+********************************************************************************
+*
+* Summary:
+*  This routine reads part of the emulated EEPROM, for records other than
+*  NV_DATA_T.
+*
+* Parameters:
+*  uint32 addr: Logical EEPROM address
+*  void* data: Destination
+*  uint32 len: Number of bytes
+*
+* Return:
+*  uint8_t error: 0 = read, 1 = failed
+*
+*******************************************************************************/
+uint8_t NV_Read(uint32 addr, void* data, uint32 len)
+{
+    return (Cy_Em_EEPROM_Read(addr, data, len, &nvContext) == CY_EM_EEPROM_SUCCESS) ? 0u : 1u;
+}
+
+/*******************************************************************************
+* Function Name: NV_Write
+********************************************************************************
+*
+* Summary:
+*  This routine writes part of the emulated EEPROM. Every write programs a
+*  whole flash row however few bytes it carries, so callers skip writes that
+*  change nothing, group changes, and only write when NV_CanWrite() allows it.
+*
+* Parameters:
+*  uint32 addr: Logical EEPROM address
+*  const void* data: Bytes to write
+*  uint32 len: Number of bytes
+*
+* Return:
+*  uint8_t error: 0 = written, 1 = failed
+*
+*******************************************************************************/
+uint8_t NV_Write(uint32 addr, const void* data, uint32 len)
+{
+    return (Cy_Em_EEPROM_Write(addr, (void*)data, len, &nvContext) == CY_EM_EEPROM_SUCCESS) ? 0u : 1u;
+}
+
+/* [] END OF FILE */
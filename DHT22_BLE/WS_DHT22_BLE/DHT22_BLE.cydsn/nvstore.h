@@ -0,0 +1,53 @@
+/* ========================================
+ * Filename:        nvstore.h
+ * Description:     Non-volatile storage in emulated EEPROM header file
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+#include <project.h>
+
+#ifndef __NVSTORE_H
+#define __NVSTORE_H
+
+/***************************************
+*        API Constants
+***************************************/
+#define NV_MAGIC                                    (0x4E563232u)  /* "NV22" */
+#define NV_EEPROM_SIZE                              (CY_EM_EEPROM_EEPROM_DATA_LEN)  /* Half a flash row */
+#define NV_WEAR_LEVELING                            (4u)
+#define NV_PHYSICAL_SIZE                            (NV_EEPROM_SIZE * 2u * NV_WEAR_LEVELING)
+
+/* Layout of the emulated EEPROM. NV_DATA_T at 0 must stay within
+ * NV_CONFIG_ADDR. */
+#define NV_DATA_ADDR                                (0u)
+#define NV_CONFIG_ADDR                              (32u)   /* Runtime configuration, see config.h */
+#define NV_CONFIG_SIZE                              (NV_EEPROM_SIZE - NV_CONFIG_ADDR)
+
+/* Record kept in emulated EEPROM. New fields are appended at the end so
+ * records written by older firmware stay readable. */
+typedef struct
+{
+    uint32  magic;                                  /* NV_MAGIC once the record has been written */
+    int16   temperatureX10;                         /* Last valid reading */
+    uint16  humidityX10;
+    uint8   readingValid;                           /* 1 = the reading above is valid */
+    uint16  bootCount;                              /* Incremented on every boot, wraps */
+} NV_DATA_T;
+
+/***************************************
+*        Function Prototypes
+***************************************/
+    uint8_t NV_Init(void);                          // Load the record into RAM
+    NV_DATA_T* NV_GetData(void);                    // RAM copy of the record
+    void    NV_RequestSave(void);                   // Write the RAM copy at the next safe point
+    uint8_t NV_ProcessPendingSave(void);            // Write the record if the BLESS allows it
+    uint8_t NV_Save(void);                          // Write the record now and read it back, 0 = ok
+    uint8_t NV_CanWrite(void);                      // 1 = a flash write now does not disturb the radio
+    uint8_t NV_Read(uint32 addr, void* data, uint32 len);        // Read any part of the EEPROM, 0 = ok
+    uint8_t NV_Write(uint32 addr, const void* data, uint32 len); // Write any part of the EEPROM, 0 = ok
+#endif
+
+
+
+/* [] END OF FILE */
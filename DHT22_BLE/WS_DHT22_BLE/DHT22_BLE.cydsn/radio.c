@@ -0,0 +1,262 @@
+/* ========================================
+ * Filename:        radio.c
+ * Description:     TX power and advertising channel policy source file
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+
+#include "radio.h"
+
+typedef struct
+{
+    CYBLE_BLESS_PWR_LVL_T initial;
+    CYBLE_BLESS_PWR_LVL_T min;
+    CYBLE_BLESS_PWR_LVL_T max;
+} RADIO_PROFILE_DATA_T;
+
+static const RADIO_PROFILE_DATA_T radioProfiles[RADIO_PROFILE_COUNT] =
+{
+    { CYBLE_LL_PWR_LVL_NEG_12_DBM, CYBLE_LL_PWR_LVL_NEG_18_DBM, CYBLE_LL_PWR_LVL_NEG_6_DBM },
+    { CYBLE_LL_PWR_LVL_0_DBM,      CYBLE_LL_PWR_LVL_NEG_12_DBM, CYBLE_LL_PWR_LVL_0_DBM },
+    { CYBLE_LL_PWR_LVL_3_DBM,      CYBLE_LL_PWR_LVL_NEG_6_DBM,  CYBLE_LL_PWR_LVL_3_DBM }
+};
+
+static RADIO_PROFILE_T radioProfile = RADIO_DEFAULT_PROFILE;
+static CYBLE_BLESS_PWR_LVL_T radioTxPower = CYBLE_LL_PWR_LVL_0_DBM;
+static uint8 radioChannelMap = RADIO_CHANNELS_ALL;
+static uint8 radioLowPriorityChannelMap = RADIO_CHANNELS_LOW_PRIORITY;
+
+/*******************************************************************************
+* Function Name: Radio_Init
+********************************************************************************
+*
+* Summary:
+*  This routine selects the deployment profile. The BLESS is only written by
+*  Radio_Apply() once the stack is on.
+*
+* Parameters:
+*  RADIO_PROFILE_T profile: Deployment profile
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Radio_Init(RADIO_PROFILE_T profile)
+{
+    radioProfile = profile;
+    radioTxPower = radioProfiles[profile].initial;
+}
+
+/*******************************************************************************
+* Function Name: Radio_Apply
+********************************************************************************
+*
+* Summary:
+*  This routine writes the TX power to the advertising and data channel groups.
+*  The stack writes the customizer's TX power at CYBLE_EVT_STACK_ON, so this
+*  must be called from that event and is skipped until the stack is on.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Radio_Apply(void)
+{
+    CYBLE_BLESS_PWR_IN_DB_T power;
+    CYBLE_STATE_T state = CyBle_GetState();
+    
+    if ((state == CYBLE_STATE_STOPPED) || (state == CYBLE_STATE_INITIALIZING)) {
+        return;
+    }
+    
+    power.blePwrLevelInDbm = radioTxPower;
+    power.bleSsChId = CYBLE_LL_ADV_CH_TYPE;
+    (void)CyBle_SetTxPowerLevel(&power);
+    power.bleSsChId = CYBLE_LL_CONN_CH_TYPE;
+    (void)CyBle_SetTxPowerLevel(&power);
+}
+
+/*******************************************************************************
+* Function Name: Radio_SetProfile
+********************************************************************************
+*
+* Summary:
+*  This routine changes the deployment profile and resets the TX power to the
+*  profile's initial level.
+*
+* Parameters:
+*  RADIO_PROFILE_T profile: Deployment profile
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Radio_SetProfile(RADIO_PROFILE_T profile)
+{
+    Radio_Init(profile);
+    Radio_Apply();
+}
+
+/*******************************************************************************
+* Function Name: Radio_GetProfile
+********************************************************************************
+*
+* Summary:
+*  This routine returns the deployment profile.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  RADIO_PROFILE_T: Current profile
+*
+*******************************************************************************/
+RADIO_PROFILE_T Radio_GetProfile(void)
+{
+    return radioProfile;
+}
+
+/*******************************************************************************
+* Function Name: Radio_SetTxPower
+********************************************************************************
+*
+* Summary:
+*  This routine sets the TX power, clamped to the range of the profile.
+*
+* Parameters:
+*  CYBLE_BLESS_PWR_LVL_T level: TX power
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Radio_SetTxPower(CYBLE_BLESS_PWR_LVL_T level)
+{
+    const RADIO_PROFILE_DATA_T* profile = &radioProfiles[radioProfile];
+    
+    if (level < profile->min) {
+        level = profile->min;
+    } else if (level > profile->max) {
+        level = profile->max;
+    }
+    
+    if (level != radioTxPower) {
+        radioTxPower = level;
+        Radio_Apply();
+    }
+}
+
+/*******************************************************************************
+* Function Name: Radio_GetTxPower
+********************************************************************************
+*
+* Summary:
+*  This routine returns the TX power.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  CYBLE_BLESS_PWR_LVL_T: Current TX power
+*
+*******************************************************************************/
+CYBLE_BLESS_PWR_LVL_T Radio_GetTxPower(void)
+{
+    return radioTxPower;
+}
+
+/*******************************************************************************
+* Function Name: Radio_IsTxPowerValid
+********************************************************************************
+*
+* Summary:
+*  This routine tells whether a TX power is within the range of a profile.
+*
+* Parameters:
+*  RADIO_PROFILE_T profile: Deployment profile
+*  CYBLE_BLESS_PWR_LVL_T level: TX power
+*
+* Return:
+*  uint8: 1 = within the range
+*
+*******************************************************************************/
+uint8 Radio_IsTxPowerValid(RADIO_PROFILE_T profile, CYBLE_BLESS_PWR_LVL_T level)
+{
+    return ((level >= radioProfiles[profile].min) && (level <= radioProfiles[profile].max)) ? 1u : 0u;
+}
+
+/*******************************************************************************
+* Function Name: Radio_OnGatewayRssi
+********************************************************************************
+*
+* Summary:
+*  This routine steps the TX power one level towards the target, based on the
+*  RSSI a gateway reports for this node. One step per report keeps a single
+*  faded packet from swinging the power.
+*
+* Parameters:
+*  int8 rssi: RSSI seen by the gateway, dBm
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Radio_OnGatewayRssi(int8 rssi)
+{
+    if (rssi < RADIO_TARGET_RSSI) {
+        Radio_SetTxPower((CYBLE_BLESS_PWR_LVL_T)(radioTxPower + 1u));
+    } else if (rssi > (RADIO_TARGET_RSSI + RADIO_RSSI_HYSTERESIS)) {
+        Radio_SetTxPower((CYBLE_BLESS_PWR_LVL_T)(radioTxPower - 1u));
+    } else {
+        /* Within the target band */
+    }
+}
+
+/*******************************************************************************
+* Function Name: Radio_SetChannelMaps
+********************************************************************************
+*
+* Summary:
+*  This routine sets the advertising channel maps. They are used from the next
+*  advertising start. An empty map falls back to all channels.
+*
+* Parameters:
+*  uint8 normal: Channel map for normal advertising
+*  uint8 lowPriority: Channel map for low-priority advertising
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Radio_SetChannelMaps(uint8 normal, uint8 lowPriority)
+{
+    normal &= RADIO_CHANNELS_ALL;
+    lowPriority &= RADIO_CHANNELS_ALL;
+    radioChannelMap = (normal != 0u) ? normal : RADIO_CHANNELS_ALL;
+    radioLowPriorityChannelMap = (lowPriority != 0u) ? lowPriority : RADIO_CHANNELS_ALL;
+}
+
+/*******************************************************************************
+* Function Name: Radio_GetChannelMap
+********************************************************************************
+*
+* Summary:
+*  This routine returns the advertising channel map to use.
+*
+* Parameters:
+*  uint8 lowPriority: 1 = low-priority advertising, 0 = normal advertising
+*
+* Return:
+*  uint8: Advertising channel map
+*
+*******************************************************************************/
+uint8 Radio_GetChannelMap(uint8 lowPriority)
+{
+    return (lowPriority != 0u) ? radioLowPriorityChannelMap : radioChannelMap;
+}
+
+/* [] END OF FILE */
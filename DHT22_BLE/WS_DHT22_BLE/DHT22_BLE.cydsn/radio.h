@@ -0,0 +1,52 @@
+/* ========================================
+ * Filename:        radio.h
+ * Description:     TX power and advertising channel policy header file
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+#include <project.h>
+
+#ifndef __RADIO_H
+#define __RADIO_H
+
+/***************************************
+*        API Constants
+***************************************/
+#define RADIO_DEFAULT_PROFILE                       (RADIO_PROFILE_DEFAULT)
+
+/* Advertising channel maps, bit 0 = channel 37 */
+#define RADIO_CHANNELS_ALL                          (0x07u)
+#define RADIO_CHANNELS_LOW_PRIORITY                 (0x01u)  /* Channel 37 only */
+
+/* Gateway feedback: the RSSI the gateway sees is kept between
+ * RADIO_TARGET_RSSI and RADIO_TARGET_RSSI + RADIO_RSSI_HYSTERESIS */
+#define RADIO_TARGET_RSSI                           (-80)    /* dBm */
+#define RADIO_RSSI_HYSTERESIS                       (10)     /* dB */
+
+typedef enum
+{
+    RADIO_PROFILE_NEAR = 0u,                        /* Gateway in the same room, -12dBm, -18..-6dBm */
+    RADIO_PROFILE_DEFAULT,                          /* 0dBm, -12..0dBm */
+    RADIO_PROFILE_FAR,                              /* Long range or lossy install, 3dBm, -6..3dBm */
+    RADIO_PROFILE_COUNT
+} RADIO_PROFILE_T;
+
+/***************************************
+*        Function Prototypes
+***************************************/
+    void    Radio_Init(RADIO_PROFILE_T profile);                    // Select a profile, applied by Radio_Apply()
+    void    Radio_Apply(void);                                      // Write the TX power to the BLESS, call after CYBLE_EVT_STACK_ON
+    void    Radio_SetProfile(RADIO_PROFILE_T profile);              // Reset the TX power to the profile default
+    RADIO_PROFILE_T Radio_GetProfile(void);
+    void    Radio_SetTxPower(CYBLE_BLESS_PWR_LVL_T level);          // Clamped to the profile range
+    CYBLE_BLESS_PWR_LVL_T Radio_GetTxPower(void);
+    uint8   Radio_IsTxPowerValid(RADIO_PROFILE_T profile, CYBLE_BLESS_PWR_LVL_T level); // 1 = within the profile range
+    void    Radio_OnGatewayRssi(int8 rssi);                         // Step the TX power towards the target RSSI
+    void    Radio_SetChannelMaps(uint8 normal, uint8 lowPriority);
+    uint8   Radio_GetChannelMap(uint8 lowPriority);                 // Channel map for normal or low-priority advertising
+#endif
+
+
+
+/* [] END OF FILE */
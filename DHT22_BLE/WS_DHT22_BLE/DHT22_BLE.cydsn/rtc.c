@@ -0,0 +1,443 @@
+/* ========================================
+ * Filename:        rtc.c
+ * Description:     LFCLK real-time clock and Current Time Service source file
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+
+#include "rtc.h"
+#include "sched.h"
+#include <string.h>
+
+/***************************************
+*        API Constants
+***************************************/
+#define RTC_TICKS_PER_FRACTION                      (128u)    /* LFCLK ticks per 1/256s */
+#define RTC_DAY_S                                   (86400u)
+#define RTC_EPOCH_DAY_OF_WEEK                       (2u)      /* 2020-01-01 was a Wednesday, 0 = Monday */
+
+static const uint8 rtcMonthDays[12] = { 31u, 28u, 31u, 30u, 31u, 30u, 31u, 31u, 30u, 31u, 30u, 31u };
+
+static uint8 rtcSynced = 0u;
+static uint64 rtcSyncTicks = 0u;                    /* Ticks at the last clock write */
+static uint64 rtcSyncTime = 0u;                     /* 1/256s since the epoch at the last clock write */
+
+static uint8 rtcRefValid = 0u;
+static uint64 rtcRefTicks = 0u;                     /* Clock write the drift is measured from */
+static uint64 rtcRefTime = 0u;
+static uint8 rtcDriftValid = 0u;
+static int32 rtcDriftPpb = 0;
+
+/*******************************************************************************
+* Function Name: Rtc_IsLeapYear
+********************************************************************************
+*
+* Summary:
+*  This routine tells whether a year has a 29th of February, good for
+*  RTC_YEAR_MIN to RTC_YEAR_MAX.
+*
+* Parameters:
+*  uint16 year: Year
+*
+* Return:
+*  uint8: 1 = leap year
+*
+*******************************************************************************/
+static uint8 Rtc_IsLeapYear(uint16 year)
+{
+    return ((year % 4u) == 0u) ? 1u : 0u;
+}
+
+/*******************************************************************************
+* Function Name: Rtc_MonthDays
+********************************************************************************
+*
+* Summary:
+*  This routine returns the length of a month.
+*
+* Parameters:
+*  uint16 year: Year
+*  uint8 month: Month, 1 to 12
+*
+* Return:
+*  uint8: Days in the month
+*
+*******************************************************************************/
+static uint8 Rtc_MonthDays(uint16 year, uint8 month)
+{
+    return ((month == 2u) && (Rtc_IsLeapYear(year) != 0u)) ? 29u : rtcMonthDays[month - 1u];
+}
+
+/*******************************************************************************
+* Function Name: Rtc_Init
+********************************************************************************
+*
+* Summary:
+*  This routine forgets the clock setting and the drift estimate.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Rtc_Init(void)
+{
+    rtcSynced = 0u;
+    rtcRefValid = 0u;
+    rtcDriftValid = 0u;
+    rtcDriftPpb = 0;
+}
+
+/*******************************************************************************
+* Function Name: Rtc_GetTicks
+********************************************************************************
+*
+* Summary:
+*  This routine returns the LFCLK ticks since Sched_Init(). Timestamps
+*  are taken as tick counts and converted with Rtc_ToTime() when sent, so
+*  a clock write never makes stored readings jump.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint64: RTC_TICKS_PER_S ticks
+*
+*******************************************************************************/
+uint64 Rtc_GetTicks(void)
+{
+    return Sched_GetTicks64();
+}
+
+/*******************************************************************************
+* Function Name: Rtc_ToTime
+********************************************************************************
+*
+* Summary:
+*  This routine converts a tick count to a timestamp. Once the clock is set,
+*  the ticks since the last clock write are corrected for the measured
+*  drift and added to the written time; ticks from before the write are
+*  taken back the same way.
+*
+* Parameters:
+*  uint64 ticks: Rtc_GetTicks() value
+*  uint8* fraction256: Fractions of 1/256s, NULL if not wanted
+*
+* Return:
+*  uint32: HISTFMT timestamp
+*
+*******************************************************************************/
+uint32 Rtc_ToTime(uint64 ticks, uint8* fraction256)
+{
+    int64 dt;
+    int64 time;
+
+    if (rtcSynced == 0u) {
+        if (fraction256 != NULL) {
+            *fraction256 = (uint8)((ticks % RTC_TICKS_PER_S) / RTC_TICKS_PER_FRACTION);
+        }
+        return (uint32)(ticks / RTC_TICKS_PER_S) | HISTFMT_TIME_UNSYNCED;
+    }
+
+    dt = (int64)(ticks - rtcSyncTicks);
+    dt += ((dt / 1000) * rtcDriftPpb) / 1000000;
+    time = (int64)rtcSyncTime + (dt / (int64)RTC_TICKS_PER_FRACTION);
+    if (time < 0) {
+        time = 0;
+    }
+
+    if (fraction256 != NULL) {
+        *fraction256 = (uint8)time;
+    }
+    return (uint32)((uint64)time >> 8u) & ~HISTFMT_TIME_UNSYNCED;
+}
+
+/*******************************************************************************
+* Function Name: Rtc_GetTime
+********************************************************************************
+*
+* Summary:
+*  This routine returns the timestamp of now.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32: HISTFMT timestamp
+*
+*******************************************************************************/
+uint32 Rtc_GetTime(void)
+{
+    return Rtc_ToTime(Rtc_GetTicks(), NULL);
+}
+
+/*******************************************************************************
+* Function Name: Rtc_IsSynced
+********************************************************************************
+*
+* Summary:
+*  This routine tells whether a client has set the clock since boot.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint8: 1 = set
+*
+*******************************************************************************/
+uint8 Rtc_IsSynced(void)
+{
+    return rtcSynced;
+}
+
+/*******************************************************************************
+* Function Name: Rtc_GetDriftPpb
+********************************************************************************
+*
+* Summary:
+*  This routine returns the LFCLK drift measured between clock writes.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  int32: Drift in parts per billion, + = LFCLK runs slow, 0 until measured
+*
+*******************************************************************************/
+int32 Rtc_GetDriftPpb(void)
+{
+    return rtcDriftPpb;
+}
+
+/*******************************************************************************
+* Function Name: Rtc_Set
+********************************************************************************
+*
+* Summary:
+*  This routine sets the clock. When the last write the drift is measured
+*  from is at least RTC_DRIFT_MIN_INTERVAL_S old, the LFCLK ticks since then
+*  are compared with the time that really passed. Each measurement is
+*  averaged with the estimate so far; one beyond RTC_DRIFT_MAX_PPB is taken
+*  as a bad clock on the client and ignored.
+*
+* Parameters:
+*  uint64 time: 1/256s since the epoch
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Rtc_Set(uint64 time)
+{
+    uint64 ticks = Rtc_GetTicks();
+
+    if ((rtcRefValid != 0u) && (time > rtcRefTime) &&
+        ((ticks - rtcRefTicks) >= ((uint64)RTC_DRIFT_MIN_INTERVAL_S * RTC_TICKS_PER_S))) {
+        int64 raw = (int64)(ticks - rtcRefTicks);
+        int64 error = ((int64)(time - rtcRefTime) * (int64)RTC_TICKS_PER_FRACTION) - raw;
+        int64 limit = ((raw / 1000) * RTC_DRIFT_MAX_PPB) / 1000000;
+
+        /* Bounded before scaling, so a bad client clock cannot overflow it.
+         * raw is at least RTC_DRIFT_MIN_INTERVAL_S of ticks, dividing it by
+         * 1000 costs well below 1ppb. */
+        if ((error <= limit) && (error >= -limit)) {
+            int64 measured = (error * 1000000) / (raw / 1000);
+
+            rtcDriftPpb = (rtcDriftValid != 0u) ? (int32)((rtcDriftPpb + measured) / 2) : (int32)measured;
+            rtcDriftValid = 1u;
+        }
+        rtcRefTicks = ticks;
+        rtcRefTime = time;
+    } else if ((rtcRefValid == 0u) || (time <= rtcRefTime)) {
+        rtcRefValid = 1u;
+        rtcRefTicks = ticks;
+        rtcRefTime = time;
+    }
+
+    rtcSyncTicks = ticks;
+    rtcSyncTime = time;
+    rtcSynced = 1u;
+}
+
+/*******************************************************************************
+* Function Name: Rtc_Publish
+********************************************************************************
+*
+* Summary:
+*  This routine writes the current time to the GATT database.
+*
+* Parameters:
+*  uint8 adjustReason: Adjust reason field, RTC_ADJUST_x bits
+*  CYBLE_GATT_HANDLE_VALUE_PAIR_T* handleVal: Filled with the value written,
+*                                             valid while value is in scope
+*  uint8* value: RTC_CURRENT_TIME_LEN bytes of storage for the value
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Rtc_Publish(uint8 adjustReason, CYBLE_GATT_HANDLE_VALUE_PAIR_T* handleVal, uint8* value)
+{
+    uint8 fraction;
+    uint32 time;
+    uint32 days;
+    uint32 seconds;
+    uint16 year = RTC_YEAR_MIN;
+    uint8 month = 1u;
+
+    (void)memset(value, 0, RTC_CURRENT_TIME_LEN);
+
+    if (rtcSynced != 0u) {
+        time = Rtc_ToTime(Rtc_GetTicks(), &fraction);
+        days = time / RTC_DAY_S;
+        seconds = time % RTC_DAY_S;
+
+        value[7] = (uint8)(((days + RTC_EPOCH_DAY_OF_WEEK) % 7u) + 1u);
+        while (days >= ((Rtc_IsLeapYear(year) != 0u) ? 366u : 365u)) {
+            days -= (Rtc_IsLeapYear(year) != 0u) ? 366u : 365u;
+            year++;
+        }
+        while (days >= Rtc_MonthDays(year, month)) {
+            days -= Rtc_MonthDays(year, month);
+            month++;
+        }
+
+        value[0] = LO8(year);
+        value[1] = HI8(year);
+        value[2] = month;
+        value[3] = (uint8)(days + 1u);
+        value[4] = (uint8)(seconds / 3600u);
+        value[5] = (uint8)((seconds / 60u) % 60u);
+        value[6] = (uint8)(seconds % 60u);
+        value[8] = fraction;
+        value[9] = adjustReason;
+    }
+
+    handleVal->attrHandle = RTC_CURRENT_TIME_HANDLE;
+    handleVal->value.val = value;
+    handleVal->value.len = RTC_CURRENT_TIME_LEN;
+    (void)CyBle_GattsWriteAttributeValue(handleVal, 0u, NULL, CYBLE_GATT_DB_LOCALLY_INITIATED);
+}
+
+/*******************************************************************************
+* Function Name: Rtc_WriteRequest
+********************************************************************************
+*
+* Summary:
+*  This routine handles a write to the Current Time characteristic or its
+*  CCCD. The day of week and adjust reason are ignored. A new time is
+*  notified with the manual update adjust reason if the client subscribed.
+*  The caller sends the response.
+*
+* Parameters:
+*  CYBLE_GATTS_WRITE_REQ_PARAM_T* request: Write request from the client
+*
+* Return:
+*  CYBLE_GATT_ERR_CODE_T: CYBLE_GATT_ERR_ATTRIBUTE_NOT_FOUND if the handle is
+*                         not the current time or its CCCD
+*
+*******************************************************************************/
+CYBLE_GATT_ERR_CODE_T Rtc_WriteRequest(CYBLE_GATTS_WRITE_REQ_PARAM_T* request)
+{
+    const uint8* value = request->handleValPair.value.val;
+    CYBLE_GATT_HANDLE_VALUE_PAIR_T handleVal;
+    uint8 notifyValue[RTC_CURRENT_TIME_LEN];
+    uint16 year;
+    uint32 days;
+    uint16 y;
+    uint8 m;
+
+    if (request->handleValPair.attrHandle == RTC_CURRENT_TIME_CCCD_HANDLE) {
+        return CyBle_GattsWriteAttributeValue(&request->handleValPair, 0u,
+                    &request->connHandle, CYBLE_GATT_DB_PEER_INITIATED);
+    }
+    if (request->handleValPair.attrHandle != RTC_CURRENT_TIME_HANDLE) {
+        return CYBLE_GATT_ERR_ATTRIBUTE_NOT_FOUND;
+    }
+    if (request->handleValPair.value.len != RTC_CURRENT_TIME_LEN) {
+        return CYBLE_GATT_ERR_INVALID_ATTRIBUTE_LEN;
+    }
+
+    year = (uint16)value[0] | ((uint16)value[1] << 8u);
+    if ((year < RTC_YEAR_MIN) || (year > RTC_YEAR_MAX) || (value[2] < 1u) || (value[2] > 12u) ||
+        (value[3] < 1u) || (value[3] > Rtc_MonthDays(year, value[2])) ||
+        (value[4] > 23u) || (value[5] > 59u) || (value[6] > 59u)) {
+        return CYBLE_GATT_ERR_OUT_OF_RANGE;
+    }
+
+    days = value[3] - 1u;
+    for (y = RTC_YEAR_MIN; y < year; y++) {
+        days += (Rtc_IsLeapYear(y) != 0u) ? 366u : 365u;
+    }
+    for (m = 1u; m < value[2]; m++) {
+        days += Rtc_MonthDays(year, m);
+    }
+
+    Rtc_Set((((uint64)days * RTC_DAY_S + (uint32)value[4] * 3600u + (uint32)value[5] * 60u + value[6]) << 8u) |
+            value[8]);
+
+    Rtc_Publish(RTC_ADJUST_MANUAL, &handleVal, notifyValue);
+    if (CYBLE_IS_NOTIFICATION_ENABLED(RTC_CURRENT_TIME_CCCD_HANDLE)) {
+        (void)CyBle_GattsNotification(request->connHandle, &handleVal);
+    }
+    return CYBLE_GATT_ERR_NONE;
+}
+
+/*******************************************************************************
+* Function Name: Rtc_ReadRequest
+********************************************************************************
+*
+* Summary:
+*  This routine writes the current time to the GATT database when a client
+*  is about to read it.
+*
+* Parameters:
+*  CYBLE_GATTS_CHAR_VAL_READ_REQ_T* request: Read access event parameter
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Rtc_ReadRequest(CYBLE_GATTS_CHAR_VAL_READ_REQ_T* request)
+{
+    CYBLE_GATT_HANDLE_VALUE_PAIR_T handleVal;
+    uint8 value[RTC_CURRENT_TIME_LEN];
+
+    if (request->attrHandle != RTC_CURRENT_TIME_HANDLE) {
+        return;
+    }
+
+    Rtc_Publish(0u, &handleVal, value);
+}
+
+/*******************************************************************************
+* Function Name: Rtc_OnDisconnect
+********************************************************************************
+*
+* Summary:
+*  This routine clears the Current Time CCCD when the client disconnects.
+*  Without bonding the subscription does not carry over to the next
+*  connection.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Rtc_OnDisconnect(void)
+{
+    CYBLE_GATT_HANDLE_VALUE_PAIR_T handleVal;
+    uint8 cccd[CYBLE_CCCD_LEN] = { 0u, 0u };
+
+    handleVal.attrHandle = RTC_CURRENT_TIME_CCCD_HANDLE;
+    handleVal.value.val = cccd;
+    handleVal.value.len = CYBLE_CCCD_LEN;
+    (void)CyBle_GattsWriteAttributeValue(&handleVal, 0u, NULL, CYBLE_GATT_DB_LOCALLY_INITIATED);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,55 @@
+/* ========================================
+ * Filename:        rtc.h
+ * Description:     LFCLK real-time clock and Current Time Service header file
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+#include <project.h>
+#include "histfmt.h"
+
+#ifndef __RTC_H
+#define __RTC_H
+
+/***************************************
+*        API Constants
+***************************************/
+/* Attribute handle, from the Current Time custom service in the BLE
+ * component (TopDesign.cysch) */
+#define RTC_CURRENT_TIME_HANDLE                     (CYBLE_CURRENT_TIME_CURRENT_TIME_CHAR_HANDLE)
+#define RTC_CURRENT_TIME_CCCD_HANDLE                (CYBLE_CURRENT_TIME_CURRENT_TIME_CLIENT_CHARACTERISTIC_CONFIGURATION_DESC_HANDLE)
+
+/* Current Time characteristic value, as in the Current Time Service:
+ * uint16 year, month, day, hours, minutes, seconds, day of week (1 = Monday),
+ * fractions of 1/256s, adjust reason. Reads return year 0 until the clock
+ * has been set. A write is the only way the clock changes, so it is notified
+ * to a subscribed client even though that client made it. */
+#define RTC_CURRENT_TIME_LEN                        (10u)
+#define RTC_ADJUST_MANUAL                           (0x01u)   /* Adjust reason: manual time update */
+#define RTC_YEAR_MIN                                (2020u)   /* HISTFMT_TIME_EPOCH_UNIX */
+#define RTC_YEAR_MAX                                (2087u)   /* Last full year in 31 bits */
+
+#define RTC_TICKS_PER_S                             (32768u)  /* LFCLK from the WCO */
+
+/* Drift is only measured over clock writes at least this far apart, so the
+ * client's own latency of a few 10ms stays below a few ppm */
+#define RTC_DRIFT_MIN_INTERVAL_S                    (14400u)  /* 4h */
+#define RTC_DRIFT_MAX_PPB                           (500000)  /* Larger measurements are taken as a bad write */
+
+/***************************************
+*        Function Prototypes
+***************************************/
+    void    Rtc_Init(void);                                         // Clock not set, drift unknown
+    uint64  Rtc_GetTicks(void);                                     // LFCLK ticks since Sched_Init(), never wraps
+    uint32  Rtc_ToTime(uint64 ticks, uint8* fraction256);           // HISTFMT timestamp of an Rtc_GetTicks() value
+    uint32  Rtc_GetTime(void);                                      // HISTFMT timestamp of now
+    uint8   Rtc_IsSynced(void);
+    int32   Rtc_GetDriftPpb(void);                                  // + = LFCLK runs slow
+    CYBLE_GATT_ERR_CODE_T Rtc_WriteRequest(CYBLE_GATTS_WRITE_REQ_PARAM_T* request); // ATTRIBUTE_NOT_FOUND if not the current time
+    void    Rtc_ReadRequest(CYBLE_GATTS_CHAR_VAL_READ_REQ_T* request); // Refresh the current time before the stack reads it
+    void    Rtc_OnDisconnect(void);                                 // Clear the CCCD, no bonding to keep it
+#endif
+
+
+
+/* [] END OF FILE */
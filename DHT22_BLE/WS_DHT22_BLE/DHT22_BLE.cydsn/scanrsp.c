@@ -0,0 +1,168 @@
+/* ========================================
+ * Filename:        scanrsp.c
+ * Description:     Scan response statistics payload source file
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+
+#include "scanrsp.h"
+#include "advfmt.h"
+#include "advupdate.h"
+#include "stats.h"
+#include "fmt.h"
+#include <string.h>
+
+/***************************************
+*        API Constants
+***************************************/
+/* Scan response data structure: manufacturer specific data with one statistics
+ * extension per window (see advfmt.h) */
+#define SCANRSP_DATA_OFFSET                         (4u)
+#define SCANRSP_EXT_LEN                             (ADVFMT_EXT_HEADER_LEN + ADVFMT_EXT_STATS_LEN)
+#define SCANRSP_LEN                                 (SCANRSP_DATA_OFFSET + ADVFMT_SCAN_RSP_EXT_OFFSET + (STATS_WINDOW_COUNT * SCANRSP_EXT_LEN))
+
+static const uint8 scanRspExtType[STATS_WINDOW_COUNT] =
+{
+    ADVFMT_EXT_STATS_SHORT,
+    ADVFMT_EXT_STATS_LONG
+};
+
+/*******************************************************************************
+* Function Name: ScanRsp_Humidity
+********************************************************************************
+*
+* Summary:
+*  This routine converts humidity from 0.1%RH to 0.5%RH.
+*
+* Parameters:
+*  int16 humidityX10: Humidity x 10
+*
+* Return:
+*  uint8: Humidity x 2
+*
+*******************************************************************************/
+static uint8 ScanRsp_Humidity(int16 humidityX10)
+{
+    uint32 value = FMT_DIV10((uint16)humidityX10 << 1u);
+    
+    return (value < ADVFMT_STATS_HUMIDITY_NO_DATA) ? (uint8)value : (ADVFMT_STATS_HUMIDITY_NO_DATA - 1u);
+}
+
+/*******************************************************************************
+* Function Name: ScanRsp_Build
+********************************************************************************
+*
+* Summary:
+*  This routine writes the current statistics into a scan response payload.
+*
+* Parameters:
+*  uint8* dst: Payload buffer, at least SCANRSP_LEN bytes
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void ScanRsp_Build(uint8* dst)
+{
+    uint8* ext = &dst[SCANRSP_DATA_OFFSET + ADVFMT_SCAN_RSP_EXT_OFFSET];
+    uint8 window;
+    
+    dst[0] = SCANRSP_LEN - 1u;
+    dst[1] = ADVFMT_AD_TYPE;
+    dst[2] = LO8(ADVFMT_COMPANY_ID);
+    dst[3] = HI8(ADVFMT_COMPANY_ID);
+    dst[SCANRSP_DATA_OFFSET] = ADVFMT_VERSION;
+    
+    for (window = 0u; window < STATS_WINDOW_COUNT; window++) {
+        STATS_RESULT_T t;
+        STATS_RESULT_T h;
+        uint8* data = &ext[ADVFMT_EXT_HEADER_LEN];
+        uint16 minutes = Stats_GetWindow((STATS_WINDOW_T)window);
+        
+        ext[0] = scanRspExtType[window];
+        ext[1] = ADVFMT_EXT_STATS_LEN;
+        data[ADVFMT_STATS_WINDOW_OFFSET] = LO8(minutes);
+        data[ADVFMT_STATS_WINDOW_OFFSET + 1u] = HI8(minutes);
+        
+        if ((Stats_Get((STATS_WINDOW_T)window, STATS_CHANNEL_TEMPERATURE, &t) == 0u) &&
+            (Stats_Get((STATS_WINDOW_T)window, STATS_CHANNEL_HUMIDITY, &h) == 0u)) {
+            data[ADVFMT_STATS_TEMPERATURE_OFFSET] = LO8(t.min);
+            data[ADVFMT_STATS_TEMPERATURE_OFFSET + 1u] = HI8(t.min);
+            data[ADVFMT_STATS_TEMPERATURE_OFFSET + 2u] = LO8(t.max);
+            data[ADVFMT_STATS_TEMPERATURE_OFFSET + 3u] = HI8(t.max);
+            data[ADVFMT_STATS_TEMPERATURE_OFFSET + 4u] = LO8(t.mean);
+            data[ADVFMT_STATS_TEMPERATURE_OFFSET + 5u] = HI8(t.mean);
+            data[ADVFMT_STATS_HUMIDITY_OFFSET] = ScanRsp_Humidity(h.min);
+            data[ADVFMT_STATS_HUMIDITY_OFFSET + 1u] = ScanRsp_Humidity(h.max);
+            data[ADVFMT_STATS_HUMIDITY_OFFSET + 2u] = ScanRsp_Humidity(h.mean);
+        } else {
+            for (uint8 i = 0u; i < 6u; i += 2u) {
+                data[ADVFMT_STATS_TEMPERATURE_OFFSET + i] = LO8(ADVFMT_TEMPERATURE_NO_DATA);
+                data[ADVFMT_STATS_TEMPERATURE_OFFSET + i + 1u] = HI8(ADVFMT_TEMPERATURE_NO_DATA);
+            }
+            (void)memset(&data[ADVFMT_STATS_HUMIDITY_OFFSET], ADVFMT_STATS_HUMIDITY_NO_DATA, 3u);
+        }
+        
+        ext += SCANRSP_EXT_LEN;
+    }
+}
+
+/*******************************************************************************
+* Function Name: ScanRsp_Init
+********************************************************************************
+*
+* Summary:
+*  This routine loads the statistics layout into the scan response data. The
+*  windows are advertised without data until the first reading.
+*
+* Parameters:
+*  CYBLE_GAPP_SCAN_RSP_DATA_T* scanRspData: Scan response data to initialize
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void ScanRsp_Init(CYBLE_GAPP_SCAN_RSP_DATA_T* scanRspData)
+{
+    ScanRsp_Build(scanRspData->scanRspData);
+    scanRspData->scanRspDataLen = SCANRSP_LEN;
+}
+
+/*******************************************************************************
+* Function Name: ScanRsp_Update
+********************************************************************************
+*
+* Summary:
+*  This routine rebuilds the statistics payload and stages it only if it
+*  differs from the scan response currently advertised or staged. Mean, min
+*  and max change far less often than the readings themselves, so most
+*  samples leave the scan response alone.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint8_t staged: 1 = new scan response staged, 0 = unchanged
+*
+*******************************************************************************/
+uint8_t ScanRsp_Update(void)
+{
+    uint8 payload[SCANRSP_LEN];
+    CYBLE_GAPP_SCAN_RSP_DATA_T* scanRspData;
+    
+    ScanRsp_Build(payload);
+    scanRspData = ADV_BeginScanRspUpdate();
+    
+    if ((scanRspData->scanRspDataLen == SCANRSP_LEN) &&
+        (memcmp(scanRspData->scanRspData, payload, SCANRSP_LEN) == 0)) {
+        return 0;
+    }
+    
+    (void)memcpy(scanRspData->scanRspData, payload, SCANRSP_LEN);
+    scanRspData->scanRspDataLen = SCANRSP_LEN;
+    ADV_EndScanRspUpdate();
+    return 1;
+}
+
+/* [] END OF FILE */
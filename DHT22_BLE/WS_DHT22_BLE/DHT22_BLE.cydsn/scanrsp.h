@@ -0,0 +1,22 @@
+/* ========================================
+ * Filename:        scanrsp.h
+ * Description:     Scan response statistics payload header file
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+#include <project.h>
+
+#ifndef __SCANRSP_H
+#define __SCANRSP_H
+
+/***************************************
+*        Function Prototypes
+***************************************/
+    void    ScanRsp_Init(CYBLE_GAPP_SCAN_RSP_DATA_T* scanRspData);  // Load the statistics layout with no data
+    uint8_t ScanRsp_Update(void);                                    // Stage the statistics if they changed, 1 = staged
+#endif
+
+
+
+/* [] END OF FILE */
@@ -0,0 +1,332 @@
+/* ========================================
+ * Filename:        sched.c
+ * Description:     LFCLK based cooperative scheduler source file
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+
+#include "sched.h"
+
+/***************************************
+*        API Constants
+***************************************/
+#define SCHED_MAX_WAKEUP_TICKS                      (0xFF00u)  /* Keep clear of the 16-bit counter wrap */
+#define SCHED_MIN_WAKEUP_TICKS                      (4u)       /* Match register needs 3 LFCLK cycles to sync */
+
+typedef struct
+{
+    SCHED_FUNC_T func;
+    uint32 due;                                     /* LFCLK tick the task is due at */
+    uint32 period;                                  /* Reload in ticks, 0 = one-shot */
+    uint8_t running;
+} SCHED_ENTRY_T;
+
+static SCHED_ENTRY_T schedTasks[SCHED_TASK_COUNT];
+static uint32 schedLate = 0u;                       /* Runs more than SCHED_LATE_TICKS after the due tick */
+static uint32 schedOverruns = 0u;                   /* Periodic runs that were a whole period or more behind */
+static uint64 schedTicks = 0u;                      /* LFCLK ticks since Sched_Init() */
+static uint32 schedLastTicks = 0u;                  /* Timebase at the last extension */
+static uint8 schedStarted = 0u;
+
+/*******************************************************************************
+* Function Name: Sched_WakeupIsr
+********************************************************************************
+*
+* Summary:
+*  WDT counter 0 match callback. Nothing to do here, the interrupt only has to
+*  wake the CPU so the main loop can dispatch the due task.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Sched_WakeupIsr(void)
+{
+}
+
+/*******************************************************************************
+* Function Name: Sched_Init
+********************************************************************************
+*
+* Summary:
+*  This routine starts WDT counter 2 as a free-running LFCLK timebase and WDT
+*  counter 0 as the wakeup source for Deep-Sleep.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Sched_Init(void)
+{
+    CySysWdtSetMode(SCHED_LFCLK_COUNTER, CY_SYS_WDT_MODE_NONE);
+    CySysWdtEnable(SCHED_LFCLK_COUNTER_MASK);
+    
+    CySysWdtSetMode(SCHED_WAKEUP_COUNTER, CY_SYS_WDT_MODE_INT);
+    CySysWdtSetClearOnMatch(SCHED_WAKEUP_COUNTER, 0u);
+    (void)CySysWdtSetInterruptCallback(SCHED_WAKEUP_COUNTER, &Sched_WakeupIsr);
+    CySysWdtEnableCounterIsr(SCHED_WAKEUP_COUNTER);
+    CySysWdtEnable(SCHED_WAKEUP_COUNTER_MASK);
+    
+    schedTicks = 0u;
+    schedLastTicks = Sched_GetTicks();
+    schedStarted = 1u;
+}
+
+/*******************************************************************************
+* Function Name: Sched_Register
+********************************************************************************
+*
+* Summary:
+*  This routine binds a function to a task slot.
+*
+* Parameters:
+*  SCHED_TASK_T task: Task slot
+*  SCHED_FUNC_T func: Function to run when the task is due
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Sched_Register(SCHED_TASK_T task, SCHED_FUNC_T func)
+{
+    schedTasks[task].func = func;
+}
+
+/*******************************************************************************
+* Function Name: Sched_Start
+********************************************************************************
+*
+* Summary:
+*  This routine (re)starts a task. Restarting a running task moves its due
+*  time.
+*
+* Parameters:
+*  SCHED_TASK_T task: Task slot
+*  uint32 delayMs: Delay until the first run
+*  uint32 periodMs: Period of the following runs, 0 = run once
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Sched_Start(SCHED_TASK_T task, uint32 delayMs, uint32 periodMs)
+{
+    schedTasks[task].due = Sched_GetTicks() + SCHED_MS_TO_TICKS(delayMs);
+    schedTasks[task].period = SCHED_MS_TO_TICKS(periodMs);
+    schedTasks[task].running = 1u;
+}
+
+/*******************************************************************************
+* Function Name: Sched_Stop
+********************************************************************************
+*
+* Summary:
+*  This routine stops a task.
+*
+* Parameters:
+*  SCHED_TASK_T task: Task slot
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Sched_Stop(SCHED_TASK_T task)
+{
+    schedTasks[task].running = 0u;
+}
+
+/*******************************************************************************
+* Function Name: Sched_IsRunning
+********************************************************************************
+*
+* Summary:
+*  This routine checks if a task is started.
+*
+* Parameters:
+*  SCHED_TASK_T task: Task slot
+*
+* Return:
+*  uint8_t running: 1 = started, 0 = stopped
+*
+*******************************************************************************/
+uint8_t Sched_IsRunning(SCHED_TASK_T task)
+{
+    return schedTasks[task].running;
+}
+
+/*******************************************************************************
+* Function Name: Sched_GetTicks
+********************************************************************************
+*
+* Summary:
+*  This routine returns the free-running LFCLK timebase.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32 ticks: 32.768kHz ticks, wraps after 36 hours
+*
+*******************************************************************************/
+uint32 Sched_GetTicks(void)
+{
+    return CySysWdtGetCount(SCHED_LFCLK_COUNTER);
+}
+
+/*******************************************************************************
+* Function Name: Sched_GetTicks64
+********************************************************************************
+*
+* Summary:
+*  This routine extends the timebase, which wraps after 36 hours, to 64 bits.
+*  Sched_Dispatch() calls it after every wakeup, at most SCHED_MAX_WAKEUP_TICKS
+*  apart, so no wrap is missed in any build mode.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint64 ticks: 32.768kHz ticks since Sched_Init(), 0 before it
+*
+*******************************************************************************/
+uint64 Sched_GetTicks64(void)
+{
+    uint32 ticks;
+    
+    if (schedStarted == 0u)
+    {
+        return 0u;
+    }
+    
+    ticks = Sched_GetTicks();
+    schedTicks += ticks - schedLastTicks;
+    schedLastTicks = ticks;
+    return schedTicks;
+}
+
+/*******************************************************************************
+* Function Name: Sched_Dispatch
+********************************************************************************
+*
+* Summary:
+*  This routine runs every task that is due. Periodic tasks are reloaded
+*  relative to their due time so they do not drift. A periodic task still
+*  due after the reload has missed a period and counts as an overrun; it
+*  runs again on the next call to catch up. Must be called from the main
+*  loop after every wakeup.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Sched_Dispatch(void)
+{
+    (void)Sched_GetTicks64();
+    
+    for (uint8_t task = 0u; task < (uint8_t)SCHED_TASK_COUNT; task++)
+    {
+        SCHED_ENTRY_T *entry = &schedTasks[task];
+        uint32 now = Sched_GetTicks();
+        
+        if ((entry->running != 0u) && ((int32)(now - entry->due) >= 0))
+        {
+            if ((now - entry->due) > SCHED_LATE_TICKS)
+            {
+                schedLate++;
+            }
+            
+            if (entry->period != 0u)
+            {
+                entry->due += entry->period;
+                if ((int32)(now - entry->due) >= 0)
+                {
+                    schedOverruns++;
+                }
+            }
+            else
+            {
+                entry->running = 0u;
+            }
+            
+            if (entry->func != NULL)
+            {
+                entry->func();
+            }
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: Sched_PrepareSleep
+********************************************************************************
+*
+* Summary:
+*  This routine programs the WDT counter 0 match for the earliest due task so
+*  Deep-Sleep is left in time even when no BLE event is pending. Wakeups
+*  further away than the 16-bit counter range are split into several.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Sched_PrepareSleep(void)
+{
+    uint32 now = Sched_GetTicks();
+    uint32 next = SCHED_MAX_WAKEUP_TICKS;
+    
+    for (uint8_t task = 0u; task < (uint8_t)SCHED_TASK_COUNT; task++)
+    {
+        if (schedTasks[task].running != 0u)
+        {
+            int32 remaining = (int32)(schedTasks[task].due - now);
+            
+            if (remaining < (int32)SCHED_MIN_WAKEUP_TICKS)
+            {
+                remaining = (int32)SCHED_MIN_WAKEUP_TICKS;
+            }
+            if ((uint32)remaining < next)
+            {
+                next = (uint32)remaining;
+            }
+        }
+    }
+    
+    CySysWdtSetMatch(SCHED_WAKEUP_COUNTER, 
+        (CySysWdtGetCount(SCHED_WAKEUP_COUNTER) + next) & 0xFFFFu);
+}
+
+/*******************************************************************************
+* Function Name: Sched_GetCounts
+********************************************************************************
+*
+* Summary:
+*  This routine returns the timing counters since boot.
+*
+* Parameters:
+*  uint32* late: Task runs more than SCHED_LATE_TICKS after the due tick
+*  uint32* overruns: Periodic task runs a whole period or more behind
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Sched_GetCounts(uint32* late, uint32* overruns)
+{
+    *late = schedLate;
+    *overruns = schedOverruns;
+}
+
+/* [] END OF FILE */
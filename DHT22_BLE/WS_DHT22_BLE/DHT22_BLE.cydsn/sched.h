@@ -0,0 +1,57 @@
+/* ========================================
+ * Filename:        sched.h
+ * Description:     LFCLK based cooperative scheduler header file
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+#include <project.h>
+
+#ifndef __SCHED_H
+#define __SCHED_H
+
+/***************************************
+*        API Constants
+***************************************/
+#define SCHED_LFCLK_COUNTER                         (CY_SYS_WDT_COUNTER2)  /* Free-running 32-bit timebase */
+#define SCHED_LFCLK_COUNTER_MASK                    (CY_SYS_WDT_COUNTER2_MASK)
+#define SCHED_WAKEUP_COUNTER                        (CY_SYS_WDT_COUNTER0)  /* 16-bit match counter for wakeups */
+#define SCHED_WAKEUP_COUNTER_MASK                   (CY_SYS_WDT_COUNTER0_MASK)
+
+/* 32.768 ticks per ms, 32.768 = 33554 / 1024 */
+#define SCHED_MS_TO_TICKS(ms)                       ((uint32)(((uint64)(ms) * 33554u) >> 10u))
+
+/* A task run more than this after its due tick counts as late */
+#define SCHED_LATE_TICKS                            (SCHED_MS_TO_TICKS(10u))
+
+typedef void (*SCHED_FUNC_T)(void);
+
+typedef enum
+{
+    SCHED_TASK_SENSOR = 0u,                         /* DHT22 read and ADV update */
+    SCHED_TASK_LED,                                 /* LED activity policy */
+    SCHED_TASK_ADVRATE,                             /* Advertising interval decay */
+    SCHED_TASK_CONNPARAM,                           /* Connection parameter requests */
+    SCHED_TASK_BATCH,                               /* Batch notification deadline */
+    SCHED_TASK_CONFIG,                              /* Deferred configuration save */
+    SCHED_TASK_COUNT
+} SCHED_TASK_T;
+
+/***************************************
+*        Function Prototypes
+***************************************/
+    void    Sched_Init(void);                                           // Start the timebase and wakeup counter
+    void    Sched_Register(SCHED_TASK_T task, SCHED_FUNC_T func);       // Bind a function to a task slot
+    void    Sched_Start(SCHED_TASK_T task, uint32 delayMs, uint32 periodMs); // periodMs = 0 for one-shot
+    void    Sched_Stop(SCHED_TASK_T task);
+    uint8_t Sched_IsRunning(SCHED_TASK_T task);
+    uint32  Sched_GetTicks(void);                                       // LFCLK timebase, wraps after 36h
+    uint64  Sched_GetTicks64(void);                                     // LFCLK ticks since Sched_Init(), never wraps
+    void    Sched_Dispatch(void);                                       // Run all due tasks
+    void    Sched_PrepareSleep(void);                                   // Arm a wakeup for the next due task
+    void    Sched_GetCounts(uint32* late, uint32* overruns);            // Timing counters since boot
+#endif
+
+
+
+/* [] END OF FILE */
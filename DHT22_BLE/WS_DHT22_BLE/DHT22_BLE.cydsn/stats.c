@@ -0,0 +1,338 @@
+/* ========================================
+ * Filename:        stats.c
+ * Description:     Rolling reading statistics source file
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+
+#include "stats.h"
+#include "sched.h"
+
+/***************************************
+*        API Constants
+***************************************/
+#define STATS_MAX_BUCKET_SAMPLES                    (UINT16_MAX / (STATS_BUCKETS + 1u))
+#define STATS_TICKS_PER_MIN                         (60u * 32768u)  /* LFCLK */
+
+/* Aggregate of a run of samples of one channel */
+typedef struct
+{
+    int16   min;
+    int16   max;
+    int32   sum;
+    uint16  samples;
+} STATS_AGG_T;
+
+typedef struct
+{
+    STATS_AGG_T bucket[STATS_BUCKETS][STATS_CHANNEL_COUNT];  /* Closed buckets, ring */
+    STATS_AGG_T current[STATS_CHANNEL_COUNT];               /* Bucket being filled */
+    STATS_AGG_T closed[STATS_CHANNEL_COUNT];                /* All closed buckets combined */
+    uint64  bucketEnd;                                       /* Sched_GetTicks64() the current bucket closes at */
+    uint64  bucketTicks;                                     /* Bucket length */
+    uint16  minutes;
+    uint8   head;                                            /* Next bucket slot to overwrite */
+} STATS_WINDOW_DATA_T;
+
+static STATS_WINDOW_DATA_T statsWindows[STATS_WINDOW_COUNT];
+
+/*******************************************************************************
+* Function Name: Stats_Clear
+********************************************************************************
+*
+* Summary:
+*  This routine empties an aggregate.
+*
+* Parameters:
+*  STATS_AGG_T* agg: Aggregate to clear
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Stats_Clear(STATS_AGG_T* agg)
+{
+    agg->min = INT16_MAX;
+    agg->max = INT16_MIN;
+    agg->sum = 0;
+    agg->samples = 0u;
+}
+
+/*******************************************************************************
+* Function Name: Stats_Merge
+********************************************************************************
+*
+* Summary:
+*  This routine adds one aggregate to another.
+*
+* Parameters:
+*  STATS_AGG_T* dst: Aggregate to add to
+*  const STATS_AGG_T* src: Aggregate to add
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Stats_Merge(STATS_AGG_T* dst, const STATS_AGG_T* src)
+{
+    if (src->min < dst->min) {
+        dst->min = src->min;
+    }
+    if (src->max > dst->max) {
+        dst->max = src->max;
+    }
+    dst->sum += src->sum;
+    dst->samples += src->samples;
+}
+
+/*******************************************************************************
+* Function Name: Stats_CloseBucket
+********************************************************************************
+*
+* Summary:
+*  This routine moves the current bucket into the ring, dropping the oldest
+*  one, and rebuilds the combined closed aggregate. This is O(STATS_BUCKETS)
+*  once per bucket, i.e. O(1) per sample.
+*
+* Parameters:
+*  STATS_WINDOW_DATA_T* w: Window
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Stats_CloseBucket(STATS_WINDOW_DATA_T* w)
+{
+    uint8 ch;
+    uint8 i;
+    
+    for (ch = 0u; ch < STATS_CHANNEL_COUNT; ch++) {
+        w->bucket[w->head][ch] = w->current[ch];
+        Stats_Clear(&w->current[ch]);
+        Stats_Clear(&w->closed[ch]);
+        for (i = 0u; i < STATS_BUCKETS; i++) {
+            Stats_Merge(&w->closed[ch], &w->bucket[i][ch]);
+        }
+    }
+    
+    w->head = (w->head == (STATS_BUCKETS - 1u)) ? 0u : (w->head + 1u);
+}
+
+/*******************************************************************************
+* Function Name: Stats_Reset
+********************************************************************************
+*
+* Summary:
+*  This routine empties a window and starts its first bucket now.
+*
+* Parameters:
+*  STATS_WINDOW_DATA_T* w: Window
+*  uint64 now: Sched_GetTicks64()
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Stats_Reset(STATS_WINDOW_DATA_T* w, uint64 now)
+{
+    uint8 ch;
+    uint8 i;
+    
+    w->bucketEnd = now + w->bucketTicks;
+    w->head = 0u;
+    for (ch = 0u; ch < STATS_CHANNEL_COUNT; ch++) {
+        Stats_Clear(&w->current[ch]);
+        Stats_Clear(&w->closed[ch]);
+        for (i = 0u; i < STATS_BUCKETS; i++) {
+            Stats_Clear(&w->bucket[i][ch]);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: Stats_Advance
+********************************************************************************
+*
+* Summary:
+*  This routine closes every bucket whose time is over, empty ones included,
+*  so failed or extra reads do not stretch or shrink the window. After a
+*  whole window without a call the window is simply emptied.
+*
+* Parameters:
+*  STATS_WINDOW_DATA_T* w: Window
+*  uint64 now: Sched_GetTicks64()
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void Stats_Advance(STATS_WINDOW_DATA_T* w, uint64 now)
+{
+    if (now >= (w->bucketEnd + (w->bucketTicks * STATS_BUCKETS))) {
+        Stats_Reset(w, now);
+        return;
+    }
+    while (now >= w->bucketEnd) {
+        Stats_CloseBucket(w);
+        w->bucketEnd += w->bucketTicks;
+    }
+}
+
+/*******************************************************************************
+* Function Name: Stats_Init
+********************************************************************************
+*
+* Summary:
+*  This routine clears all windows and sets them to their default lengths.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Stats_Init(void)
+{
+    Stats_SetWindow(STATS_WINDOW_SHORT, STATS_SHORT_WINDOW_MIN);
+    Stats_SetWindow(STATS_WINDOW_LONG, STATS_LONG_WINDOW_MIN);
+}
+
+/*******************************************************************************
+* Function Name: Stats_SetWindow
+********************************************************************************
+*
+* Summary:
+*  This routine changes the length of a window and clears it. Buckets close
+*  on LFCLK time, so the window covers the given minutes whatever the
+*  sensor period.
+*
+* Parameters:
+*  STATS_WINDOW_T window: Window to change
+*  uint16 minutes: New window length, at least 1
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Stats_SetWindow(STATS_WINDOW_T window, uint16 minutes)
+{
+    STATS_WINDOW_DATA_T* w = &statsWindows[window];
+    
+    if (minutes == 0u) {
+        minutes = 1u;
+    }
+    w->minutes = minutes;
+    w->bucketTicks = ((uint64)minutes * STATS_TICKS_PER_MIN) / STATS_BUCKETS;
+    Stats_Reset(w, Sched_GetTicks64());
+}
+
+/*******************************************************************************
+* Function Name: Stats_GetWindow
+********************************************************************************
+*
+* Summary:
+*  This routine returns the length of a window.
+*
+* Parameters:
+*  STATS_WINDOW_T window: Window
+*
+* Return:
+*  uint16: Window length in minutes
+*
+*******************************************************************************/
+uint16 Stats_GetWindow(STATS_WINDOW_T window)
+{
+    return statsWindows[window].minutes;
+}
+
+/*******************************************************************************
+* Function Name: Stats_Add
+********************************************************************************
+*
+* Summary:
+*  This routine adds a valid reading to every window. A bucket stops taking
+*  samples at STATS_MAX_BUCKET_SAMPLES, so a full window's count fits in
+*  16 bits.
+*
+* Parameters:
+*  int16 temperatureX10: Temperature x 10
+*  uint16 humidityX10: Humidity x 10
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Stats_Add(int16 temperatureX10, uint16 humidityX10)
+{
+    int16 values[STATS_CHANNEL_COUNT];
+    uint64 now = Sched_GetTicks64();
+    uint8 window;
+    uint8 ch;
+    
+    values[STATS_CHANNEL_TEMPERATURE] = temperatureX10;
+    values[STATS_CHANNEL_HUMIDITY] = (int16)humidityX10;
+    
+    for (window = 0u; window < STATS_WINDOW_COUNT; window++) {
+        STATS_WINDOW_DATA_T* w = &statsWindows[window];
+        
+        Stats_Advance(w, now);
+        if (w->current[0].samples >= STATS_MAX_BUCKET_SAMPLES) {
+            continue;
+        }
+        for (ch = 0u; ch < STATS_CHANNEL_COUNT; ch++) {
+            STATS_AGG_T* agg = &w->current[ch];
+            
+            if (values[ch] < agg->min) {
+                agg->min = values[ch];
+            }
+            if (values[ch] > agg->max) {
+                agg->max = values[ch];
+            }
+            agg->sum += values[ch];
+            agg->samples += 1u;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: Stats_Get
+********************************************************************************
+*
+* Summary:
+*  This routine returns the min, max and mean of a channel over a window.
+*
+* Parameters:
+*  STATS_WINDOW_T window: Window
+*  STATS_CHANNEL_T channel: Channel
+*  STATS_RESULT_T* result: Statistics, untouched if there is no data
+*
+* Return:
+*  uint8_t error: 1 = no samples in the window, 0 = result valid
+*
+*******************************************************************************/
+uint8_t Stats_Get(STATS_WINDOW_T window, STATS_CHANNEL_T channel, STATS_RESULT_T* result)
+{
+    STATS_WINDOW_DATA_T* w = &statsWindows[window];
+    STATS_AGG_T agg;
+    int32 half;
+    
+    Stats_Advance(w, Sched_GetTicks64());
+    agg = w->closed[channel];
+    Stats_Merge(&agg, &w->current[channel]);
+    if (agg.samples == 0u) {
+        return 1;
+    }
+    
+    /* Round the mean to nearest */
+    half = (int32)(agg.samples >> 1u);
+    result->mean = (int16)((agg.sum >= 0) ? ((agg.sum + half) / agg.samples)
+                                          : -((-agg.sum + half) / agg.samples));
+    result->min = agg.min;
+    result->max = agg.max;
+    result->samples = agg.samples;
+    return 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,58 @@
+/* ========================================
+ * Filename:        stats.h
+ * Description:     Rolling reading statistics header file
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+#include <project.h>
+
+#ifndef __STATS_H
+#define __STATS_H
+
+/***************************************
+*        API Constants
+***************************************/
+/* Each window is kept as STATS_BUCKETS buckets of equal LFCLK time. The
+ * window slides one bucket at a time, so it covers between STATS_BUCKETS and
+ * STATS_BUCKETS + 1 buckets of time, however many reads succeeded in it. */
+#define STATS_BUCKETS                               (12u)
+
+#define STATS_SHORT_WINDOW_MIN                      (60u)    /* Default short window, 1h */
+#define STATS_LONG_WINDOW_MIN                       (1440u)  /* Default long window, 24h */
+
+typedef enum
+{
+    STATS_WINDOW_SHORT = 0u,
+    STATS_WINDOW_LONG,
+    STATS_WINDOW_COUNT
+} STATS_WINDOW_T;
+
+typedef enum
+{
+    STATS_CHANNEL_TEMPERATURE = 0u,                 /* 0.1C */
+    STATS_CHANNEL_HUMIDITY,                         /* 0.1%RH */
+    STATS_CHANNEL_COUNT
+} STATS_CHANNEL_T;
+
+typedef struct
+{
+    int16   min;
+    int16   max;
+    int16   mean;
+    uint16  samples;                                /* Samples in the window, 0 = no data */
+} STATS_RESULT_T;
+
+/***************************************
+*        Function Prototypes
+***************************************/
+    void    Stats_Init(void);                                               // Clear all windows, set the default lengths
+    void    Stats_SetWindow(STATS_WINDOW_T window, uint16 minutes);         // Change a window length, clears the window
+    uint16  Stats_GetWindow(STATS_WINDOW_T window);                         // Window length in minutes
+    void    Stats_Add(int16 temperatureX10, uint16 humidityX10);           // Add a valid reading to every window
+    uint8_t Stats_Get(STATS_WINDOW_T window, STATS_CHANNEL_T channel, STATS_RESULT_T* result);  // 1 = no data
+#endif
+
+
+
+/* [] END OF FILE */
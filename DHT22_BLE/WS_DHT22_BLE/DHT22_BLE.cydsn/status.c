@@ -0,0 +1,117 @@
+/* ========================================
+ * Filename:        status.c
+ * Description:     Packed status characteristic source file
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+
+#include "status.h"
+#include "rtc.h"
+
+static uint8 statusRecord[STATUS_RECORD_LEN] = {
+    ADVFMT_FLAG_NO_DATA,
+    LO8(ADVFMT_TEMPERATURE_NO_DATA), HI8(ADVFMT_TEMPERATURE_NO_DATA),
+    LO8(ADVFMT_HUMIDITY_NO_DATA), HI8(ADVFMT_HUMIDITY_NO_DATA),
+    STATUS_BATTERY_UNKNOWN,
+    0u, 0u,                                         /* Boot count, set by Status_Init() */
+    0u, 0u,
+    LO8(HISTFMT_TIME_UNSYNCED), HI8(HISTFMT_TIME_UNSYNCED),
+    LO8(HI16(HISTFMT_TIME_UNSYNCED)), HI8(HI16(HISTFMT_TIME_UNSYNCED))
+};
+static uint8 statusPublished = 0u;
+
+/*******************************************************************************
+* Function Name: Status_Init
+********************************************************************************
+*
+* Summary:
+*  This routine sets the boot count, so a client reading the record before
+*  the first reading sees the boot it belongs to.
+*
+* Parameters:
+*  uint16 bootCount: Boot count of this boot
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Status_Init(uint16 bootCount)
+{
+    statusRecord[STATUS_BOOT_COUNT_OFFSET] = LO8(bootCount);
+    statusRecord[STATUS_BOOT_COUNT_OFFSET + 1u] = HI8(bootCount);
+}
+
+/*******************************************************************************
+* Function Name: Status_Publish
+********************************************************************************
+*
+* Summary:
+*  This routine writes the record to the GATT database. The value is kept
+*  current there instead of being built on a read access event, so the
+*  stack answers Read and Read Multiple requests on its own within the
+*  connection event that carries them.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Status_Publish(void)
+{
+    CYBLE_GATT_HANDLE_VALUE_PAIR_T handleVal;
+
+    statusPublished = 1u;
+    handleVal.attrHandle = STATUS_VALUE_HANDLE;
+    handleVal.value.val = statusRecord;
+    handleVal.value.len = STATUS_RECORD_LEN;
+    (void)CyBle_GattsWriteAttributeValue(&handleVal, 0u, NULL, CYBLE_GATT_DB_LOCALLY_INITIATED);
+}
+
+/*******************************************************************************
+* Function Name: Status_Update
+********************************************************************************
+*
+* Summary:
+*  This routine packs a sample into the record, and into the GATT database
+*  once the stack is on.
+*
+* Parameters:
+*  const ADV_SAMPLE_T* sample: Sample handed to the ADV encoder
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void Status_Update(const ADV_SAMPLE_T* sample)
+{
+    uint32 time = HISTFMT_TIME_UNSYNCED;
+
+    /* The restored reading is packed before Sched_Init() starts the clock */
+    if (statusPublished != 0u) {
+        time = Rtc_GetTime();
+    }
+
+    statusRecord[STATUS_FLAGS_OFFSET] = sample->status;
+    statusRecord[STATUS_TEMPERATURE_OFFSET] = LO8(sample->temperatureX10);
+    statusRecord[STATUS_TEMPERATURE_OFFSET + 1u] = HI8(sample->temperatureX10);
+    statusRecord[STATUS_HUMIDITY_OFFSET] = LO8(sample->humidityX10);
+    statusRecord[STATUS_HUMIDITY_OFFSET + 1u] = HI8(sample->humidityX10);
+    statusRecord[STATUS_BATTERY_OFFSET] = STATUS_BATTERY_UNKNOWN;
+    statusRecord[STATUS_BOOT_COUNT_OFFSET] = LO8(sample->bootCount);
+    statusRecord[STATUS_BOOT_COUNT_OFFSET + 1u] = HI8(sample->bootCount);
+    statusRecord[STATUS_SEQUENCE_OFFSET] = LO8(LO16(sample->sampleCount));
+    statusRecord[STATUS_SEQUENCE_OFFSET + 1u] = HI8(LO16(sample->sampleCount));
+    statusRecord[STATUS_TIME_OFFSET] = LO8(time);
+    statusRecord[STATUS_TIME_OFFSET + 1u] = HI8(time);
+    statusRecord[STATUS_TIME_OFFSET + 2u] = LO8(HI16(time));
+    statusRecord[STATUS_TIME_OFFSET + 3u] = HI8(HI16(time));
+
+    if (statusPublished != 0u) {
+        Status_Publish();
+    }
+}
+
+/* [] END OF FILE */
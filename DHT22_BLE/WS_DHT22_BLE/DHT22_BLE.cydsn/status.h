@@ -0,0 +1,46 @@
+/* ========================================
+ * Filename:        status.h
+ * Description:     Packed status characteristic header file
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+#include <project.h>
+#include "advenc.h"
+
+#ifndef __STATUS_H
+#define __STATUS_H
+
+/***************************************
+*        API Constants
+***************************************/
+/* Attribute handle, from the Status custom service in the BLE component
+ * (TopDesign.cysch). Service ...0030, characteristic ...0031. */
+#define STATUS_VALUE_HANDLE                         (CYBLE_STATUS_SERVICE_STATUS_CHAR_HANDLE)
+
+/* Status record, the sample last advertised. Little-endian and fixed
+ * length, so it can be read alone or anywhere in a Read Multiple request.
+ * ADVFMT_TEMPERATURE_NO_DATA, ADVFMT_HUMIDITY_NO_DATA and
+ * HISTFMT_TIME_UNSYNCED until the first reading. */
+#define STATUS_FLAGS_OFFSET                         (0u)   /* uint8 ADVFMT_FLAG_x */
+#define STATUS_TEMPERATURE_OFFSET                   (1u)   /* int16 0.1C */
+#define STATUS_HUMIDITY_OFFSET                      (3u)   /* uint16 0.1%RH */
+#define STATUS_BATTERY_OFFSET                       (5u)   /* uint8 %, STATUS_BATTERY_UNKNOWN */
+#define STATUS_BOOT_COUNT_OFFSET                    (6u)   /* uint16, as in ADVFMT_EXT_SEQUENCE */
+#define STATUS_SEQUENCE_OFFSET                      (8u)   /* uint16 sample sequence */
+#define STATUS_TIME_OFFSET                          (10u)  /* uint32 HISTFMT timestamp of the reading */
+#define STATUS_RECORD_LEN                           (14u)
+
+#define STATUS_BATTERY_UNKNOWN                      (0xFFu)  /* No supply measurement on this board */
+
+/***************************************
+*        Function Prototypes
+***************************************/
+    void    Status_Init(uint16 bootCount);                          // Call once the boot count is saved
+    void    Status_Publish(void);                                   // Write the record to the GATT database, call once the stack is on
+    void    Status_Update(const ADV_SAMPLE_T* sample);              // Record the sample being advertised
+#endif
+
+
+
+/* [] END OF FILE */
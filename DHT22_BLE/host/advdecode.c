@@ -0,0 +1,478 @@
+/* ========================================
+ * Filename:        advdecode.c
+ * Description:     Host reference decoder for the binary manufacturer ADV data source file
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+
+#include "advdecode.h"
+#include "aes128.h"
+#include <string.h>
+
+#define GET_LE16(p)                                 ((uint16_t)((p)[0] | ((uint16_t)(p)[1] << 8)))
+
+/*******************************************************************************
+* Function Name: AdvDecode_FindManufacturerData
+********************************************************************************
+*
+* Summary:
+*  This routine walks the AD structures of an ADV or scan response payload and
+*  returns the manufacturer data that follows our company ID.
+*
+* Parameters:
+*  const uint8_t* adv: Raw ADV payload
+*  uint8_t advLen: Payload length
+*  const uint8_t** data: Set to the first byte after the company ID
+*  uint8_t* len: Set to the number of bytes after the company ID
+*
+* Return:
+*  ADVDECODE_OK, ADVDECODE_NOT_FOUND or ADVDECODE_TRUNCATED
+*
+*******************************************************************************/
+int AdvDecode_FindManufacturerData(const uint8_t* adv, uint8_t advLen, const uint8_t** data, uint8_t* len)
+{
+    uint8_t i = 0u;
+    
+    while (i < advLen) {
+        uint8_t adLen = adv[i];
+        
+        if (adLen == 0u) {
+            break;  /* Early termination, the rest is padding */
+        }
+        if ((uint16_t)i + 1u + adLen > advLen) {
+            return ADVDECODE_TRUNCATED;
+        }
+        if ((adv[i + 1u] == ADVFMT_AD_TYPE) && (adLen >= 3u) &&
+            (GET_LE16(&adv[i + 2u]) == ADVFMT_COMPANY_ID)) {
+            *data = &adv[i + 4u];
+            *len = adLen - 3u;
+            return ADVDECODE_OK;
+        }
+        i += adLen + 1u;
+    }
+    
+    return ADVDECODE_NOT_FOUND;
+}
+
+/*******************************************************************************
+* Function Name: AdvDecode_Reading
+********************************************************************************
+*
+* Summary:
+*  This routine decodes the fixed fields of the manufacturer data. Extensions
+*  are returned as a raw TLV block for AdvDecode_FindExtension().
+*
+* Parameters:
+*  const uint8_t* data: Manufacturer data following the company ID
+*  uint8_t len: Data length
+*  ADVDECODE_READING_T* reading: Decoded reading
+*
+* Return:
+*  ADVDECODE_OK, ADVDECODE_TRUNCATED or ADVDECODE_BAD_VERSION
+*
+*******************************************************************************/
+int AdvDecode_Reading(const uint8_t* data, uint8_t len, ADVDECODE_READING_T* reading)
+{
+    if (len < 1u) {
+        return ADVDECODE_TRUNCATED;
+    }
+    if (data[ADVFMT_VERSION_OFFSET] != ADVFMT_VERSION) {
+        return ADVDECODE_BAD_VERSION;
+    }
+    if (len < ADVFMT_CORE_LEN) {
+        return ADVDECODE_TRUNCATED;
+    }
+    
+    reading->version = data[ADVFMT_VERSION_OFFSET];
+    reading->flags = data[ADVFMT_FLAGS_OFFSET];
+    reading->temperatureX100 = (int16_t)GET_LE16(&data[ADVFMT_TEMPERATURE_OFFSET]);
+    reading->humidityX10 = GET_LE16(&data[ADVFMT_HUMIDITY_OFFSET]);
+    reading->ext = &data[ADVFMT_EXT_OFFSET];
+    reading->extLen = len - ADVFMT_EXT_OFFSET;
+    
+    return ADVDECODE_OK;
+}
+
+/*******************************************************************************
+* Function Name: AdvDecode_FindExtension
+********************************************************************************
+*
+* Summary:
+*  This routine locates an extension by type. Unknown types are skipped using
+*  their length, so older decoders keep working with newer firmware.
+*
+* Parameters:
+*  const ADVDECODE_READING_T* reading: Reading returned by AdvDecode_Reading()
+*  uint8_t type: Extension type
+*  const uint8_t** ext: Set to the extension data
+*  uint8_t* len: Set to the extension data length
+*
+* Return:
+*  ADVDECODE_OK, ADVDECODE_NOT_FOUND or ADVDECODE_TRUNCATED
+*
+*******************************************************************************/
+int AdvDecode_FindExtension(const ADVDECODE_READING_T* reading, uint8_t type, const uint8_t** ext, uint8_t* len)
+{
+    uint8_t i = 0u;
+    
+    while (i < reading->extLen) {
+        uint8_t extLen;
+        
+        if ((uint16_t)i + ADVFMT_EXT_HEADER_LEN > reading->extLen) {
+            return ADVDECODE_TRUNCATED;
+        }
+        extLen = reading->ext[i + 1u];
+        if ((uint16_t)i + ADVFMT_EXT_HEADER_LEN + extLen > reading->extLen) {
+            return ADVDECODE_TRUNCATED;
+        }
+        if (reading->ext[i] == type) {
+            *ext = &reading->ext[i + ADVFMT_EXT_HEADER_LEN];
+            *len = extLen;
+            return ADVDECODE_OK;
+        }
+        i += ADVFMT_EXT_HEADER_LEN + extLen;
+    }
+    
+    return ADVDECODE_NOT_FOUND;
+}
+
+/*******************************************************************************
+* Function Name: AdvDecode_Sequence
+********************************************************************************
+*
+* Summary:
+*  This routine reads the boot count and sample sequence extension.
+*
+* Parameters:
+*  const ADVDECODE_READING_T* reading: Reading returned by AdvDecode_Reading()
+*  uint16_t* bootCount: Set to the node's boot count
+*  uint16_t* sequence: Set to the sample sequence number within the boot
+*
+* Return:
+*  ADVDECODE_OK, ADVDECODE_NOT_FOUND or ADVDECODE_TRUNCATED
+*
+*******************************************************************************/
+int AdvDecode_Sequence(const ADVDECODE_READING_T* reading, uint16_t* bootCount, uint16_t* sequence)
+{
+    const uint8_t* ext;
+    uint8_t len;
+    int result = AdvDecode_FindExtension(reading, ADVFMT_EXT_SEQUENCE, &ext, &len);
+    
+    if (result != ADVDECODE_OK) {
+        return result;
+    }
+    if (len < ADVFMT_EXT_SEQUENCE_LEN) {
+        return ADVDECODE_TRUNCATED;
+    }
+    
+    *bootCount = GET_LE16(&ext[0]);
+    *sequence = GET_LE16(&ext[2]);
+    return ADVDECODE_OK;
+}
+
+/*******************************************************************************
+* Function Name: AdvDecode_History
+********************************************************************************
+*
+* Summary:
+*  This routine reconstructs the previous readings from the history extension.
+*  Each entry holds deltas against the current reading and belongs to the
+*  sequence number one lower than the entry before it.
+*
+* Parameters:
+*  const ADVDECODE_READING_T* reading: Reading returned by AdvDecode_Reading()
+*  ADVDECODE_SAMPLE_T* samples: Reconstructed samples, newest first
+*  uint8_t maxSamples: Size of samples
+*
+* Return:
+*  int: Number of samples, or ADVDECODE_NOT_FOUND / ADVDECODE_TRUNCATED
+*
+*******************************************************************************/
+int AdvDecode_History(const ADVDECODE_READING_T* reading, ADVDECODE_SAMPLE_T* samples, uint8_t maxSamples)
+{
+    const uint8_t* ext;
+    uint8_t len;
+    uint16_t bootCount;
+    uint16_t sequence;
+    uint8_t count;
+    uint8_t i;
+    int result = AdvDecode_Sequence(reading, &bootCount, &sequence);
+    
+    if (result == ADVDECODE_OK) {
+        result = AdvDecode_FindExtension(reading, ADVFMT_EXT_HISTORY, &ext, &len);
+    }
+    if (result != ADVDECODE_OK) {
+        return result;
+    }
+    
+    count = len / ADVFMT_HISTORY_ENTRY_LEN;
+    if (count > maxSamples) {
+        count = maxSamples;
+    }
+    
+    for (i = 0u; i < count; i++) {
+        uint8_t dt = ext[i * ADVFMT_HISTORY_ENTRY_LEN];
+        uint8_t dh = ext[i * ADVFMT_HISTORY_ENTRY_LEN + 1u];
+        
+        samples[i].sequence = (uint16_t)(sequence - 1u - i);
+        samples[i].valid = ((dt != ADVFMT_HISTORY_MISSING) && (dh != ADVFMT_HISTORY_MISSING) &&
+                            ((reading->flags & ADVFMT_FLAG_NO_DATA) == 0u)) ? 1u : 0u;
+        if (samples[i].valid != 0u) {
+            /* Deltas have the sensor's 0.1 resolution */
+            int32_t temperatureX10 = reading->temperatureX100 / 10 + (int8_t)dt;
+            samples[i].temperatureX100 = (int16_t)(temperatureX10 * 10);
+            samples[i].humidityX10 = (uint16_t)(reading->humidityX10 + (int8_t)dh);
+        } else {
+            samples[i].temperatureX100 = ADVFMT_TEMPERATURE_NO_DATA;
+            samples[i].humidityX10 = ADVFMT_HUMIDITY_NO_DATA;
+        }
+    }
+    
+    return count;
+}
+
+/*******************************************************************************
+* Function Name: AdvDecode_Stats
+********************************************************************************
+*
+* Summary:
+*  This routine decodes one statistics window from the scan response. Use
+*  AdvDecode_FindManufacturerData() on the scan response payload first.
+*
+* Parameters:
+*  const uint8_t* data: Scan response manufacturer data following the company ID
+*  uint8_t len: Data length
+*  uint8_t type: ADVFMT_EXT_STATS_SHORT or ADVFMT_EXT_STATS_LONG
+*  ADVDECODE_STATS_T* stats: Decoded statistics
+*
+* Return:
+*  ADVDECODE_OK, ADVDECODE_NOT_FOUND, ADVDECODE_TRUNCATED or ADVDECODE_BAD_VERSION
+*
+*******************************************************************************/
+int AdvDecode_Stats(const uint8_t* data, uint8_t len, uint8_t type, ADVDECODE_STATS_T* stats)
+{
+    ADVDECODE_READING_T reading;
+    const uint8_t* ext;
+    uint8_t extLen;
+    int result;
+    
+    if (len < ADVFMT_SCAN_RSP_EXT_OFFSET) {
+        return ADVDECODE_TRUNCATED;
+    }
+    if (data[ADVFMT_VERSION_OFFSET] != ADVFMT_VERSION) {
+        return ADVDECODE_BAD_VERSION;
+    }
+    
+    reading.ext = &data[ADVFMT_SCAN_RSP_EXT_OFFSET];
+    reading.extLen = len - ADVFMT_SCAN_RSP_EXT_OFFSET;
+    result = AdvDecode_FindExtension(&reading, type, &ext, &extLen);
+    if (result != ADVDECODE_OK) {
+        return result;
+    }
+    if (extLen < ADVFMT_EXT_STATS_LEN) {
+        return ADVDECODE_TRUNCATED;
+    }
+    
+    stats->minutes = GET_LE16(&ext[ADVFMT_STATS_WINDOW_OFFSET]);
+    stats->temperatureMinX10 = (int16_t)GET_LE16(&ext[ADVFMT_STATS_TEMPERATURE_OFFSET]);
+    stats->temperatureMaxX10 = (int16_t)GET_LE16(&ext[ADVFMT_STATS_TEMPERATURE_OFFSET + 2u]);
+    stats->temperatureMeanX10 = (int16_t)GET_LE16(&ext[ADVFMT_STATS_TEMPERATURE_OFFSET + 4u]);
+    stats->humidityMinX10 = (uint16_t)(ext[ADVFMT_STATS_HUMIDITY_OFFSET] * 5u);
+    stats->humidityMaxX10 = (uint16_t)(ext[ADVFMT_STATS_HUMIDITY_OFFSET + 1u] * 5u);
+    stats->humidityMeanX10 = (uint16_t)(ext[ADVFMT_STATS_HUMIDITY_OFFSET + 2u] * 5u);
+    stats->valid = (ext[ADVFMT_STATS_HUMIDITY_OFFSET] != ADVFMT_STATS_HUMIDITY_NO_DATA) ? 1u : 0u;
+    
+    return ADVDECODE_OK;
+}
+
+/*******************************************************************************
+* Function Name: AdvDecode_CcmMic
+********************************************************************************
+*
+* Summary:
+*  This routine computes an AES-CCM (RFC 3610) MIC with a 13-byte nonce, i.e.
+*  a 2-byte length field. Only the MIC is produced, not the ciphertext.
+*
+* Parameters:
+*  const uint8_t* key: AES128_KEY_LEN bytes key
+*  const uint8_t* nonce: 13 bytes nonce
+*  const uint8_t* aad: Additional authenticated data
+*  uint8_t aadLen: Additional data length, 0..14
+*  const uint8_t* msg: Message
+*  uint8_t msgLen: Message length
+*  uint8_t micLen: MIC length, 4..16 and even
+*  uint8_t* mic: micLen bytes MIC
+*
+* Return:
+*  ADVDECODE_OK or ADVDECODE_TRUNCATED on invalid lengths
+*
+*******************************************************************************/
+int AdvDecode_CcmMic(const uint8_t* key, const uint8_t* nonce, const uint8_t* aad, uint8_t aadLen,
+                     const uint8_t* msg, uint8_t msgLen, uint8_t micLen, uint8_t* mic)
+{
+    AES128_CTX_T ctx;
+    uint8_t x[AES128_BLOCK_LEN];
+    uint8_t a[AES128_BLOCK_LEN];
+    uint8_t i;
+    uint8_t j;
+    
+    if ((aadLen > (AES128_BLOCK_LEN - 2u)) || (micLen < 4u) || (micLen > AES128_BLOCK_LEN) || ((micLen & 1u) != 0u)) {
+        return ADVDECODE_TRUNCATED;
+    }
+    
+    AES128_Init(&ctx, key);
+    
+    /* CBC-MAC over B0, the additional data block and the message */
+    x[0] = (uint8_t)(((aadLen != 0u) ? 0x40u : 0x00u) | (((micLen - 2u) / 2u) << 3) | 0x01u);
+    (void)memcpy(&x[1], nonce, ADVFMT_AUTH_NONCE_LEN);
+    x[14] = 0u;
+    x[15] = msgLen;
+    AES128_Encrypt(&ctx, x, x);
+    
+    if (aadLen != 0u) {
+        x[1] ^= aadLen;
+        for (i = 0u; i < aadLen; i++) {
+            x[2u + i] ^= aad[i];
+        }
+        AES128_Encrypt(&ctx, x, x);
+    }
+    
+    for (i = 0u; i < msgLen; i += AES128_BLOCK_LEN) {
+        for (j = 0u; (j < AES128_BLOCK_LEN) && ((i + j) < msgLen); j++) {
+            x[j] ^= msg[i + j];
+        }
+        AES128_Encrypt(&ctx, x, x);
+    }
+    
+    /* Encrypt the tag with counter block A0 */
+    (void)memset(a, 0, sizeof(a));
+    a[0] = 0x01u;
+    (void)memcpy(&a[1], nonce, ADVFMT_AUTH_NONCE_LEN);
+    AES128_Encrypt(&ctx, a, a);
+    
+    for (i = 0u; i < micLen; i++) {
+        mic[i] = (uint8_t)(x[i] ^ a[i]);
+    }
+    
+    return ADVDECODE_OK;
+}
+
+/*******************************************************************************
+* Function Name: AdvDecode_VerifyAuth
+********************************************************************************
+*
+* Summary:
+*  This routine checks the MIC of an authenticated reading against the key
+*  shared with the node. The MIC covers the core fields and the sequence
+*  extension; the history is not covered.
+*
+* Parameters:
+*  const uint8_t* data: Manufacturer data following the company ID
+*  uint8_t len: Data length
+*  const uint8_t* key: AES128_KEY_LEN bytes key
+*  const uint8_t* address: Advertiser address, 6 bytes in over-the-air order
+*
+* Return:
+*  ADVDECODE_OK, ADVDECODE_BAD_MIC, ADVDECODE_NOT_FOUND (unauthenticated
+*  payload), ADVDECODE_TRUNCATED or ADVDECODE_BAD_VERSION
+*
+*******************************************************************************/
+int AdvDecode_VerifyAuth(const uint8_t* data, uint8_t len, const uint8_t* key, const uint8_t* address)
+{
+    ADVDECODE_READING_T reading;
+    const uint8_t* ext;
+    uint8_t extLen;
+    uint8_t nonce[ADVFMT_AUTH_NONCE_LEN];
+    uint8_t mic[ADVFMT_EXT_AUTH_LEN];
+    uint16_t bootCount;
+    uint16_t sequence;
+    uint8_t diff = 0u;
+    uint8_t i;
+    int result = AdvDecode_Reading(data, len, &reading);
+    
+    if (result == ADVDECODE_OK) {
+        result = AdvDecode_Sequence(&reading, &bootCount, &sequence);
+    }
+    if (result == ADVDECODE_OK) {
+        result = AdvDecode_FindExtension(&reading, ADVFMT_EXT_AUTH, &ext, &extLen);
+    }
+    if (result != ADVDECODE_OK) {
+        return result;
+    }
+    if ((extLen < ADVFMT_EXT_AUTH_LEN) || (len < ADVFMT_AUTH_DATA_LEN)) {
+        return ADVDECODE_TRUNCATED;
+    }
+    
+    (void)memcpy(&nonce[ADVFMT_AUTH_NONCE_ADDR_OFFSET], address, 6u);
+    nonce[ADVFMT_AUTH_NONCE_BOOT_OFFSET] = (uint8_t)bootCount;
+    nonce[ADVFMT_AUTH_NONCE_BOOT_OFFSET + 1u] = (uint8_t)(bootCount >> 8);
+    nonce[ADVFMT_AUTH_NONCE_SEQUENCE_OFFSET] = (uint8_t)sequence;
+    nonce[ADVFMT_AUTH_NONCE_SEQUENCE_OFFSET + 1u] = (uint8_t)(sequence >> 8);
+    nonce[ADVFMT_AUTH_NONCE_DOMAIN_OFFSET] = (uint8_t)ADVFMT_COMPANY_ID;
+    nonce[ADVFMT_AUTH_NONCE_DOMAIN_OFFSET + 1u] = (uint8_t)(ADVFMT_COMPANY_ID >> 8);
+    nonce[ADVFMT_AUTH_NONCE_DOMAIN_OFFSET + 2u] = ADVFMT_VERSION;
+    
+    /* The node signs with no additional data, see ADVFMT_AUTH_AAD_LEN */
+    (void)AdvDecode_CcmMic(key, nonce, NULL, ADVFMT_AUTH_AAD_LEN, data, ADVFMT_AUTH_DATA_LEN,
+                           ADVFMT_EXT_AUTH_LEN, mic);
+    
+    /* Constant time compare */
+    for (i = 0u; i < ADVFMT_EXT_AUTH_LEN; i++) {
+        diff |= (uint8_t)(mic[i] ^ ext[i]);
+    }
+    
+    return (diff == 0u) ? ADVDECODE_OK : ADVDECODE_BAD_MIC;
+}
+
+/*******************************************************************************
+* Function Name: AdvDecode_Track
+********************************************************************************
+*
+* Summary:
+*  This routine drops repeated advertisements of the same sample and works
+*  out how many of the samples missed since the last report can be filled in
+*  from the report's history. The rest are counted as lost. A new boot count
+*  restarts the sequence; sequence numbers older than the last one are
+*  treated as repeats.
+*
+*  Typical use per report:
+*      n = AdvDecode_History(&reading, history, ADVDECODE_MAX_HISTORY);
+*      k = AdvDecode_Track(&tracker, boot, seq, (n > 0) ? n : 0);
+*      if (k >= 0) store history[k - 1] ... history[0], then the reading
+*
+* Parameters:
+*  ADVDECODE_TRACKER_T* tracker: Tracker of the node, zero initialized
+*  uint16_t bootCount: Boot count from AdvDecode_Sequence()
+*  uint16_t sequence: Sequence number from AdvDecode_Sequence()
+*  uint8_t history: Number of past samples the report carries
+*
+* Return:
+*  int: Number of history samples to backfill, oldest is history[n - 1],
+*       -1 = repeat
+*
+*******************************************************************************/
+int AdvDecode_Track(ADVDECODE_TRACKER_T* tracker, uint16_t bootCount, uint16_t sequence, uint8_t history)
+{
+    uint16_t delta = (uint16_t)(sequence - tracker->sequence);
+    uint16_t backfill = 0u;
+    
+    if ((tracker->valid == 0u) || (bootCount != tracker->bootCount)) {
+        tracker->valid = 1u;
+        tracker->bootCount = bootCount;
+    } else if ((delta == 0u) || (delta >= 0x8000u)) {
+        return -1;
+    } else {
+        backfill = delta - 1u;
+        if (backfill > history) {
+            tracker->lost += backfill - history;
+            backfill = history;
+        }
+    }
+    
+    tracker->sequence = sequence;
+    tracker->received += 1u + backfill;
+    return (int)backfill;
+}
+
+/* [] END OF FILE */
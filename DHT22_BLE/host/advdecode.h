@@ -0,0 +1,87 @@
+/* ========================================
+ * Filename:        advdecode.h
+ * Description:     Host reference decoder for the binary manufacturer ADV data header file
+ *                  Portable C99, no PSoC dependencies. Build together with
+ *                  advdecode.c and the firmware's advfmt.h on the include path.
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+#include <stdint.h>
+#include "advfmt.h"
+
+#ifndef __ADVDECODE_H
+#define __ADVDECODE_H
+
+/***************************************
+*        API Constants
+***************************************/
+#define ADVDECODE_OK                                (0)
+#define ADVDECODE_NOT_FOUND                         (-1)  /* No manufacturer data with our company ID */
+#define ADVDECODE_TRUNCATED                         (-2)  /* AD structure or field runs past the end */
+#define ADVDECODE_BAD_VERSION                       (-3)  /* Unknown format version */
+#define ADVDECODE_BAD_MIC                           (-4)  /* Authentication failed */
+
+#define ADVDECODE_MAX_HISTORY                       (15u)  /* Most history entries a 31-byte ADV payload can hold */
+
+/* Decoded reading */
+typedef struct
+{
+    uint8_t         version;
+    uint8_t         flags;                          /* ADVFMT_FLAG_x */
+    int16_t         temperatureX100;                /* 0.01C */
+    uint16_t        humidityX10;                    /* 0.1%RH */
+    const uint8_t*  ext;                            /* Extension TLVs, points into the input */
+    uint8_t         extLen;
+} ADVDECODE_READING_T;
+
+/* Past sample reconstructed from the history extension */
+typedef struct
+{
+    uint16_t        sequence;
+    int16_t         temperatureX100;                /* 0.01C */
+    uint16_t        humidityX10;                    /* 0.1%RH */
+    uint8_t         valid;                          /* 0 = no valid reading for this sequence */
+} ADVDECODE_SAMPLE_T;
+
+/* Window statistics from the scan response */
+typedef struct
+{
+    uint16_t        minutes;                        /* Window length */
+    int16_t         temperatureMinX10;              /* 0.1C */
+    int16_t         temperatureMaxX10;
+    int16_t         temperatureMeanX10;
+    uint16_t        humidityMinX10;                 /* 0.1%RH, 0.5%RH resolution */
+    uint16_t        humidityMaxX10;
+    uint16_t        humidityMeanX10;
+    uint8_t         valid;                          /* 0 = no samples in the window yet */
+} ADVDECODE_STATS_T;
+
+/* Per-node sample tracker for dedupe and loss counting */
+typedef struct
+{
+    uint8_t         valid;                          /* 0 until the first sample has been seen */
+    uint16_t        bootCount;
+    uint16_t        sequence;
+    uint32_t        received;                       /* Distinct samples */
+    uint32_t        lost;                           /* Sequence gaps within a boot not covered by the history */
+} ADVDECODE_TRACKER_T;
+
+/***************************************
+*        Function Prototypes
+***************************************/
+    int     AdvDecode_FindManufacturerData(const uint8_t* adv, uint8_t advLen, const uint8_t** data, uint8_t* len);  // Locate our manufacturer data in an ADV/scan response payload
+    int     AdvDecode_Reading(const uint8_t* data, uint8_t len, ADVDECODE_READING_T* reading);                       // Decode manufacturer data following the company ID
+    int     AdvDecode_FindExtension(const ADVDECODE_READING_T* reading, uint8_t type, const uint8_t** ext, uint8_t* len);  // Locate an extension TLV by type
+    int     AdvDecode_Sequence(const ADVDECODE_READING_T* reading, uint16_t* bootCount, uint16_t* sequence);          // Read the sequence extension
+    int     AdvDecode_History(const ADVDECODE_READING_T* reading, ADVDECODE_SAMPLE_T* samples, uint8_t maxSamples);  // Reconstruct the previous readings, newest first
+    int     AdvDecode_Stats(const uint8_t* data, uint8_t len, uint8_t type, ADVDECODE_STATS_T* stats);               // Decode a statistics window from scan response manufacturer data
+    int     AdvDecode_VerifyAuth(const uint8_t* data, uint8_t len, const uint8_t* key, const uint8_t* address);     // Check the MIC of manufacturer data
+    int     AdvDecode_CcmMic(const uint8_t* key, const uint8_t* nonce, const uint8_t* aad, uint8_t aadLen,
+                             const uint8_t* msg, uint8_t msgLen, uint8_t micLen, uint8_t* mic);                 // AES-CCM MIC, 13-byte nonce
+    int     AdvDecode_Track(ADVDECODE_TRACKER_T* tracker, uint16_t bootCount, uint16_t sequence, uint8_t history);    // Samples to backfill from the history, -1 = repeat
+#endif
+
+
+
+/* [] END OF FILE */
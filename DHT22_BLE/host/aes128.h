@@ -0,0 +1,34 @@
+/* ========================================
+ * Filename:        aes128.h
+ * Description:     Portable AES-128 block encryption header file
+ *                  Used by the host decoder to verify authenticated payloads.
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+#include <stdint.h>
+
+#ifndef __AES128_H
+#define __AES128_H
+
+/***************************************
+*        API Constants
+***************************************/
+#define AES128_BLOCK_LEN                            (16u)
+#define AES128_KEY_LEN                              (16u)
+
+typedef struct
+{
+    uint8_t roundKey[176];                          /* 11 round keys */
+} AES128_CTX_T;
+
+/***************************************
+*        Function Prototypes
+***************************************/
+    void    AES128_Init(AES128_CTX_T* ctx, const uint8_t* key);                      // Expand the key
+    void    AES128_Encrypt(const AES128_CTX_T* ctx, const uint8_t* in, uint8_t* out);  // Encrypt one block
+#endif
+
+
+
+/* [] END OF FILE */
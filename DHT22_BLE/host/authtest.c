@@ -0,0 +1,350 @@
+/* ========================================
+ * Filename:        authtest.c
+ * Description:     Authenticated ADV payload test source file
+ *                  Checks AES128 against FIPS-197, AdvDecode_CcmMic against
+ *                  RFC 3610, then signs readings with the firmware's
+ *                  advenc_mfr.c and advauth.c and verifies them with
+ *                  AdvDecode_VerifyAuth. The BLESS AES engine is stood in for
+ *                  by AES128, in both byte orders AdvAuth_Start() accepts.
+ *
+ *                  cc -std=c99 -DADVAUTH_ENABLED=1u -I. -Ifwstub -I../WS_DHT22_BLE/DHT22_BLE.cydsn \
+ *                     authtest.c advdecode.c aes128.c \
+ *                     ../WS_DHT22_BLE/DHT22_BLE.cydsn/advenc_mfr.c ../WS_DHT22_BLE/DHT22_BLE.cydsn/advauth.c
+ *                  ./a.out
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+
+#include "advdecode.h"
+#include "aes128.h"
+#include "advenc.h"
+#include "advauth.h"
+#include <stdio.h>
+#include <string.h>
+
+/***************************************
+*        API Constants
+***************************************/
+#define AUTHTEST_ENGINE_FIPS                        (0u)
+#define AUTHTEST_ENGINE_REVERSED                    (1u)  /* As HCI LE Encrypt */
+#define AUTHTEST_ENGINE_BROKEN                      (2u)  /* Wrong cipher text in both orders */
+#define AUTHTEST_EPOCH                              (7u)
+
+#define AuthTest_Check(cond, what)                  AuthTest_Report((cond) ? 1u : 0u, (what))
+
+static const uint8_t authTestKey[AES128_KEY_LEN] = ADVAUTH_KEY;
+static uint8_t authTestEngine = AUTHTEST_ENGINE_FIPS;
+static uint32_t authTestFailures = 0u;
+
+/* Firmware globals and stack calls used by advauth.c */
+CYBLE_GAP_BD_ADDR_T cyBle_deviceAddress = { { 0x11u, 0x22u, 0x33u, 0x44u, 0x55u, 0x66u }, 0x00u };
+CYBLE_GAP_BD_ADDR_T *cyBle_sflashDeviceAddress = &cyBle_deviceAddress;
+
+/*******************************************************************************
+* Function Name: AuthTest_Reverse
+********************************************************************************
+*
+* Summary:
+*  This routine copies a block with its byte order reversed.
+*
+* Parameters:
+*  const uint8_t* in: AES128_BLOCK_LEN bytes
+*  uint8_t* out: AES128_BLOCK_LEN bytes
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void AuthTest_Reverse(const uint8_t* in, uint8_t* out)
+{
+    uint8_t i;
+
+    for (i = 0u; i < AES128_BLOCK_LEN; i++) {
+        out[i] = in[AES128_BLOCK_LEN - 1u - i];
+    }
+}
+
+/*******************************************************************************
+* Function Name: CyBle_AesEncrypt
+********************************************************************************
+*
+* Summary:
+*  This routine stands in for the BLESS AES engine, in the byte order
+*  selected by authTestEngine.
+*
+* Parameters:
+*  uint8* plainData: 16 bytes plain text
+*  uint8* aesKey: 16 bytes key
+*  uint8* encryptedData: 16 bytes cipher text
+*
+* Return:
+*  CYBLE_ERROR_OK
+*
+*******************************************************************************/
+CYBLE_API_RESULT_T CyBle_AesEncrypt(uint8 *plainData, uint8 *aesKey, uint8 *encryptedData)
+{
+    AES128_CTX_T ctx;
+    uint8_t key[AES128_KEY_LEN];
+    uint8_t block[AES128_BLOCK_LEN];
+
+    if (authTestEngine == AUTHTEST_ENGINE_REVERSED) {
+        AuthTest_Reverse(aesKey, key);
+        AuthTest_Reverse(plainData, block);
+    } else {
+        (void)memcpy(key, aesKey, AES128_KEY_LEN);
+        (void)memcpy(block, plainData, AES128_BLOCK_LEN);
+    }
+
+    AES128_Init(&ctx, key);
+    AES128_Encrypt(&ctx, block, block);
+
+    if (authTestEngine == AUTHTEST_ENGINE_REVERSED) {
+        AuthTest_Reverse(block, encryptedData);
+    } else {
+        (void)memcpy(encryptedData, block, AES128_BLOCK_LEN);
+    }
+    if (authTestEngine == AUTHTEST_ENGINE_BROKEN) {
+        encryptedData[0] ^= 0x01u;
+    }
+    return CYBLE_ERROR_OK;
+}
+
+/*******************************************************************************
+* Function Name: CyBle_IsDeviceAddressValid
+********************************************************************************
+*
+* Summary:
+*  This routine reports the SFLASH address as unset, so cyBle_deviceAddress
+*  is used.
+*
+* Parameters:
+*  const CYBLE_GAP_BD_ADDR_T* deviceAddress: Unused
+*
+* Return:
+*  uint8: 0
+*
+*******************************************************************************/
+uint8 CyBle_IsDeviceAddressValid(const CYBLE_GAP_BD_ADDR_T *deviceAddress)
+{
+    (void)deviceAddress;
+    return 0u;
+}
+
+/*******************************************************************************
+* Function Name: CySysTickGetValue
+********************************************************************************
+*
+* Summary:
+*  This routine stands in for the SysTick counter AdvAuth_Sign() times
+*  itself with.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32: 0
+*
+*******************************************************************************/
+uint32 CySysTickGetValue(void)
+{
+    return 0u;
+}
+
+/*******************************************************************************
+* Function Name: AuthTest_Report
+********************************************************************************
+*
+* Summary:
+*  This routine counts and reports a failed check.
+*
+* Parameters:
+*  uint8_t passed: 1 = the check passed
+*  const char* what: Check description
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void AuthTest_Report(uint8_t passed, const char* what)
+{
+    if (passed == 0u) {
+        printf("FAIL: %s\n", what);
+        authTestFailures++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: AuthTest_Vectors
+********************************************************************************
+*
+* Summary:
+*  This routine checks AES128 against FIPS-197 appendix C.1 and
+*  AdvDecode_CcmMic against RFC 3610 packet vector #1.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void AuthTest_Vectors(void)
+{
+    static const uint8_t aesKey[AES128_KEY_LEN] =
+    {
+        0x00u, 0x01u, 0x02u, 0x03u, 0x04u, 0x05u, 0x06u, 0x07u, 0x08u, 0x09u, 0x0Au, 0x0Bu, 0x0Cu, 0x0Du, 0x0Eu, 0x0Fu
+    };
+    static const uint8_t aesPlain[AES128_BLOCK_LEN] =
+    {
+        0x00u, 0x11u, 0x22u, 0x33u, 0x44u, 0x55u, 0x66u, 0x77u, 0x88u, 0x99u, 0xAAu, 0xBBu, 0xCCu, 0xDDu, 0xEEu, 0xFFu
+    };
+    static const uint8_t aesCipher[AES128_BLOCK_LEN] =
+    {
+        0x69u, 0xC4u, 0xE0u, 0xD8u, 0x6Au, 0x7Bu, 0x04u, 0x30u, 0xD8u, 0xCDu, 0xB7u, 0x80u, 0x70u, 0xB4u, 0xC5u, 0x5Au
+    };
+    static const uint8_t ccmKey[AES128_KEY_LEN] =
+    {
+        0xC0u, 0xC1u, 0xC2u, 0xC3u, 0xC4u, 0xC5u, 0xC6u, 0xC7u, 0xC8u, 0xC9u, 0xCAu, 0xCBu, 0xCCu, 0xCDu, 0xCEu, 0xCFu
+    };
+    static const uint8_t ccmNonce[ADVFMT_AUTH_NONCE_LEN] =
+    {
+        0x00u, 0x00u, 0x00u, 0x03u, 0x02u, 0x01u, 0x00u, 0xA0u, 0xA1u, 0xA2u, 0xA3u, 0xA4u, 0xA5u
+    };
+    static const uint8_t ccmMic[8] = { 0x17u, 0xE8u, 0xD1u, 0x2Cu, 0xFDu, 0xF9u, 0x26u, 0xE0u };
+    AES128_CTX_T ctx;
+    uint8_t block[AES128_BLOCK_LEN];
+    uint8_t aad[8];
+    uint8_t msg[23];
+    uint8_t mic[8];
+    uint8_t i;
+
+    AES128_Init(&ctx, aesKey);
+    AES128_Encrypt(&ctx, aesPlain, block);
+    AuthTest_Check(memcmp(block, aesCipher, AES128_BLOCK_LEN) == 0, "AES128 FIPS-197 C.1");
+
+    for (i = 0u; i < sizeof(aad); i++) {
+        aad[i] = i;
+    }
+    for (i = 0u; i < sizeof(msg); i++) {
+        msg[i] = (uint8_t)(sizeof(aad) + i);
+    }
+    AuthTest_Check(AdvDecode_CcmMic(ccmKey, ccmNonce, aad, sizeof(aad), msg, sizeof(msg), sizeof(mic), mic) == ADVDECODE_OK,
+                   "AdvDecode_CcmMic RFC 3610 #1 lengths");
+    AuthTest_Check(memcmp(mic, ccmMic, sizeof(mic)) == 0, "AdvDecode_CcmMic RFC 3610 #1 MIC");
+}
+
+/*******************************************************************************
+* Function Name: AuthTest_Encode
+********************************************************************************
+*
+* Summary:
+*  This routine encodes one reading with the firmware encoder and checks it
+*  with the host decoder.
+*
+* Parameters:
+*  uint16_t bootCount: Sample boot count
+*  uint16_t sequence: Sample sequence number
+*  uint8_t tamper: 1 = flip a signed byte before verifying
+*
+* Return:
+*  int: AdvDecode_VerifyAuth() result, or ADVDECODE_NOT_FOUND
+*
+*******************************************************************************/
+static int AuthTest_Encode(uint16_t bootCount, uint16_t sequence, uint8_t tamper)
+{
+    CYBLE_GAPP_DISC_DATA_T adv;
+    ADV_SAMPLE_T sample;
+    const uint8_t* data;
+    uint8_t len;
+
+    (void)memset(&sample, 0, sizeof(sample));
+    sample.temperatureX10 = -123;
+    sample.humidityX10 = 456u;
+    sample.sampleCount = sequence;
+    sample.uptimeDs = 100u;
+    sample.bootCount = bootCount;
+
+    AdvEnc_Init(&adv);
+    AdvEnc_Encode(&adv, &sample);
+    if (AdvDecode_FindManufacturerData(adv.advData, adv.advDataLen, &data, &len) != ADVDECODE_OK) {
+        return ADVDECODE_NOT_FOUND;
+    }
+    if (tamper != 0u) {
+        ((uint8_t*)data)[ADVFMT_TEMPERATURE_OFFSET] ^= 0x01u;
+    }
+    return AdvDecode_VerifyAuth(data, len, authTestKey, cyBle_deviceAddress.bdAddr);
+}
+
+/*******************************************************************************
+* Function Name: AuthTest_Device
+********************************************************************************
+*
+* Summary:
+*  This routine runs the firmware signer end to end on one engine.
+*
+* Parameters:
+*  uint8_t engine: AUTHTEST_ENGINE_x
+*  const char* name: Engine name for the report
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void AuthTest_Device(uint8_t engine, const char* name)
+{
+    char what[64];
+
+    authTestEngine = engine;
+    AdvAuth_Init();
+    AdvAuth_SetEpoch(AUTHTEST_EPOCH);
+
+    (void)snprintf(what, sizeof(what), "%s: not started is unsigned", name);
+    AuthTest_Check(AuthTest_Encode(AUTHTEST_EPOCH, 1u, 0u) == ADVDECODE_BAD_MIC, what);
+
+    if (engine == AUTHTEST_ENGINE_BROKEN) {
+        (void)snprintf(what, sizeof(what), "%s: AdvAuth_Start fails", name);
+        AuthTest_Check(AdvAuth_Start() != 0u, what);
+        (void)snprintf(what, sizeof(what), "%s: nothing signed", name);
+        AuthTest_Check(AuthTest_Encode(AUTHTEST_EPOCH, 2u, 0u) == ADVDECODE_BAD_MIC, what);
+        return;
+    }
+
+    (void)snprintf(what, sizeof(what), "%s: AdvAuth_Start", name);
+    AuthTest_Check(AdvAuth_Start() == 0u, what);
+    (void)snprintf(what, sizeof(what), "%s: signed reading verifies", name);
+    AuthTest_Check(AuthTest_Encode(AUTHTEST_EPOCH, 2u, 0u) == ADVDECODE_OK, what);
+    (void)snprintf(what, sizeof(what), "%s: sequence wrap verifies", name);
+    AuthTest_Check(AuthTest_Encode(AUTHTEST_EPOCH, 0xFFFFu, 0u) == ADVDECODE_OK, what);
+    (void)snprintf(what, sizeof(what), "%s: tampered reading fails", name);
+    AuthTest_Check(AuthTest_Encode(AUTHTEST_EPOCH, 3u, 1u) == ADVDECODE_BAD_MIC, what);
+    (void)snprintf(what, sizeof(what), "%s: boot count not in flash is unsigned", name);
+    AuthTest_Check(AuthTest_Encode(AUTHTEST_EPOCH + 1u, 4u, 0u) == ADVDECODE_BAD_MIC, what);
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+*
+* Summary:
+*  This routine runs the vectors and the end to end checks.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  int: 0 = every check passed, 1 = a failure
+*
+*******************************************************************************/
+int main(void)
+{
+    AuthTest_Vectors();
+    AuthTest_Device(AUTHTEST_ENGINE_FIPS, "FIPS order");
+    AuthTest_Device(AUTHTEST_ENGINE_REVERSED, "reversed order");
+    AuthTest_Device(AUTHTEST_ENGINE_BROKEN, "broken engine");
+
+    printf("%lu failures\n", (unsigned long)authTestFailures);
+    return (authTestFailures == 0u) ? 0 : 1;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,203 @@
+/* ========================================
+ * Filename:        fmttest.c
+ * Description:     Formatter test source file
+ *                  Checks FMT_Unsigned over every uint16 value and
+ *                  FMT_FixedX10 over every int16 value, for every padding
+ *                  width, against snprintf. Then times both paths over the
+ *                  same inputs. The timing is of the host CPU, which has a
+ *                  hardware divider; on the Cortex-M0 each / and % of the
+ *                  printf path is a call to __aeabi_uidiv, so the ratio
+ *                  there is larger, not smaller.
+ *
+ *                  cc -std=c99 -O2 -I. -I../WS_DHT22_BLE/DHT22_BLE.cydsn fmttest.c ../WS_DHT22_BLE/DHT22_BLE.cydsn/fmt.c
+ *                  ./a.out
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+
+#include "fmt.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/***************************************
+*        API Constants
+***************************************/
+#define FMTTEST_REF_LEN                             (16u)
+#define FMTTEST_BENCH_PASSES                        (20u)   /* Full input ranges per timed run */
+
+static volatile uint32_t fmtTestSink;               /* Keeps the timed loops from being optimised out */
+
+/*******************************************************************************
+* Function Name: FmtTest_Compare
+********************************************************************************
+*
+* Summary:
+*  This routine compares an unterminated formatter output with a reference
+*  string and reports a mismatch.
+*
+* Parameters:
+*  const char* what: Formatter name for the report
+*  int32_t value: Input value
+*  uint8_t pad: Padding width
+*  const char* out: Formatter output
+*  uint8_t len: Formatter output length
+*  const char* ref: Reference string
+*
+* Return:
+*  int: 0 = match, 1 = mismatch
+*
+*******************************************************************************/
+static int FmtTest_Compare(const char* what, int32_t value, uint8_t pad,
+                           const char* out, uint8_t len, const char* ref)
+{
+    if ((len == strlen(ref)) && (memcmp(out, ref, len) == 0)) {
+        return 0;
+    }
+    printf("%s(%ld, %u): got \"%.*s\", expected \"%s\"\n",
+           what, (long)value, (unsigned)pad, (int)len, out, ref);
+    return 1;
+}
+
+/*******************************************************************************
+* Function Name: FmtTest_Unsigned
+********************************************************************************
+*
+* Summary:
+*  This routine checks FMT_Unsigned for every value and padding width.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32_t: Number of mismatches
+*
+*******************************************************************************/
+static uint32_t FmtTest_Unsigned(void)
+{
+    char out[FMT_UNSIGNED_MAX_LEN];
+    char ref[FMTTEST_REF_LEN];
+    uint32_t failures = 0u;
+
+    for (uint8_t pad = 0u; pad <= FMT_UNSIGNED_MAX_LEN; pad++) {
+        for (uint32_t value = 0u; value <= UINT16_MAX; value++) {
+            uint8_t len = FMT_Unsigned(out, (uint16_t)value, pad);
+
+            (void)snprintf(ref, sizeof(ref), "%0*lu", (int)pad, (unsigned long)value);
+            failures += (uint32_t)FmtTest_Compare("FMT_Unsigned", (int32_t)value, pad, out, len, ref);
+        }
+    }
+    return failures;
+}
+
+/*******************************************************************************
+* Function Name: FmtTest_FixedX10
+********************************************************************************
+*
+* Summary:
+*  This routine checks FMT_FixedX10 for every value and integer padding
+*  width.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  uint32_t: Number of mismatches
+*
+*******************************************************************************/
+static uint32_t FmtTest_FixedX10(void)
+{
+    char out[FMT_FIXED_X10_MAX_LEN];
+    char ref[FMTTEST_REF_LEN];
+    uint32_t failures = 0u;
+
+    for (uint8_t pad = 0u; pad <= FMT_UNSIGNED_MAX_LEN; pad++) {
+        for (int32_t value = INT16_MIN; value <= INT16_MAX; value++) {
+            uint32_t magnitude = (value < 0) ? (uint32_t)(-value) : (uint32_t)value;
+            uint8_t len = FMT_FixedX10(out, (int16_t)value, pad);
+
+            (void)snprintf(ref, sizeof(ref), "%s%0*lu.%lu", (value < 0) ? "-" : "", (int)pad,
+                           (unsigned long)(magnitude / 10u), (unsigned long)(magnitude % 10u));
+            failures += (uint32_t)FmtTest_Compare("FMT_FixedX10", value, pad, out, len, ref);
+        }
+    }
+    return failures;
+}
+
+/*******************************************************************************
+* Function Name: FmtTest_Bench
+********************************************************************************
+*
+* Summary:
+*  This routine times FMT_FixedX10 against the snprintf it replaced in
+*  DynamicADVPayloadUpdate, over every int16 value.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void FmtTest_Bench(void)
+{
+    char out[FMTTEST_REF_LEN];
+    uint32_t calls = 0u;
+    clock_t start;
+    double fmtTime;
+    double printfTime;
+
+    start = clock();
+    for (uint32_t pass = 0u; pass < FMTTEST_BENCH_PASSES; pass++) {
+        for (int32_t value = INT16_MIN; value <= INT16_MAX; value++) {
+            fmtTestSink += FMT_FixedX10(out, (int16_t)value, 2u);
+            calls++;
+        }
+    }
+    fmtTime = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    for (uint32_t pass = 0u; pass < FMTTEST_BENCH_PASSES; pass++) {
+        for (int32_t value = INT16_MIN; value <= INT16_MAX; value++) {
+            uint32_t magnitude = (value < 0) ? (uint32_t)(-value) : (uint32_t)value;
+
+            fmtTestSink += (uint32_t)snprintf(out, sizeof(out), "%s%02lu.%lu", (value < 0) ? "-" : "",
+                                              (unsigned long)(magnitude / 10u),
+                                              (unsigned long)(magnitude % 10u));
+        }
+    }
+    printfTime = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    printf("FMT_FixedX10 %6.1f ns/call\n", (fmtTime * 1e9) / calls);
+    printf("snprintf     %6.1f ns/call\n", (printfTime * 1e9) / calls);
+    if (fmtTime > 0.0) {
+        printf("ratio        %6.1f x\n", printfTime / fmtTime);
+    }
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+*
+* Summary:
+*  This routine runs the exhaustive checks and the benchmark.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  int: 0 = every value matched, 1 = a mismatch
+*
+*******************************************************************************/
+int main(void)
+{
+    uint32_t failures = FmtTest_Unsigned() + FmtTest_FixedX10();
+
+    printf("%lu mismatches over %lu values\n", (unsigned long)failures,
+           (unsigned long)((FMT_UNSIGNED_MAX_LEN + 1u) * 2u * 65536u));
+    FmtTest_Bench();
+    return (failures == 0u) ? 0 : 1;
+}
+
+/* [] END OF FILE */
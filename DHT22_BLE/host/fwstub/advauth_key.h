@@ -0,0 +1,22 @@
+/* ========================================
+ * Filename:        advauth_key.h
+ * Description:     Test key for authtest.c
+ *                  Never copy this file into the firmware project.
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+
+#ifndef __ADVAUTH_KEY_H
+#define __ADVAUTH_KEY_H
+
+/***************************************
+*        API Constants
+***************************************/
+#define ADVAUTH_KEY                                 { 0xC0u, 0xC1u, 0xC2u, 0xC3u, 0xC4u, 0xC5u, 0xC6u, 0xC7u, \
+                                                      0xC8u, 0xC9u, 0xCAu, 0xCBu, 0xCCu, 0xCDu, 0xCEu, 0xCFu }
+#endif
+
+
+
+/* [] END OF FILE */
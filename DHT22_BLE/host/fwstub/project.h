@@ -0,0 +1,69 @@
+/* ========================================
+ * Filename:        project.h
+ * Description:     Host stand-in for the PSoC Creator project header
+ *                  Declares only what the firmware's advenc_mfr.c and
+ *                  advauth.c use, so authtest.c and histtest.c can run them
+ *                  on the host. The BLE stack calls are implemented in
+ *                  authtest.c.
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+#include <stdint.h>
+
+#ifndef __PROJECT_H
+#define __PROJECT_H
+
+/***************************************
+*        API Constants
+***************************************/
+typedef uint8_t     uint8;
+typedef uint16_t    uint16;
+typedef uint32_t    uint32;
+typedef uint64_t    uint64;
+typedef int8_t      int8;
+typedef int16_t     int16;
+typedef int32_t     int32;
+
+/* As in cytypes.h */
+#define LO8(x)                                      ((uint8) ((x) & 0xFFu))
+#define HI8(x)                                      ((uint8) ((uint16)(x) >> 8))
+#define LO16(x)                                     ((uint16) ((x) & 0xFFFFu))
+#define HI16(x)                                     ((uint16) ((uint32)(x) >> 16))
+
+/* As in BLE_Stack.h and BLE_StackGap.h */
+#define CYBLE_GAP_BD_ADDR_SIZE                      (0x06u)
+#define CYBLE_GAP_MAX_ADV_DATA_LEN                  31u
+
+typedef enum
+{
+    CYBLE_ERROR_OK = 0x0000u,
+    CYBLE_ERROR_INVALID_PARAMETER = 0x0001u
+} CYBLE_API_RESULT_T;
+
+typedef struct
+{
+    uint8     bdAddr[CYBLE_GAP_BD_ADDR_SIZE];
+    uint8     type;
+} CYBLE_GAP_BD_ADDR_T;
+
+typedef struct
+{
+    uint8      advData[CYBLE_GAP_MAX_ADV_DATA_LEN];
+    uint8      advDataLen;
+} CYBLE_GAPP_DISC_DATA_T;
+
+extern CYBLE_GAP_BD_ADDR_T cyBle_deviceAddress;
+extern CYBLE_GAP_BD_ADDR_T *cyBle_sflashDeviceAddress;
+
+/***************************************
+*        Function Prototypes
+***************************************/
+    uint8   CyBle_IsDeviceAddressValid(const CYBLE_GAP_BD_ADDR_T *deviceAddress);
+    CYBLE_API_RESULT_T CyBle_AesEncrypt(uint8 *plainData, uint8 *aesKey, uint8 *encryptedData);
+    uint32  CySysTickGetValue(void);
+#endif
+
+
+
+/* [] END OF FILE */
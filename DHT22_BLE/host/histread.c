@@ -0,0 +1,251 @@
+/* ========================================
+ * Filename:        histread.c
+ * Description:     Host reference reader for the history transfer source file
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+
+#include "histread.h"
+
+#define GET_LE16(p)                                 ((uint16_t)((p)[0] | ((uint16_t)(p)[1] << 8)))
+#define GET_LE32(p)                                 ((uint32_t)GET_LE16(p) | ((uint32_t)GET_LE16((p) + 2) << 16))
+
+/*******************************************************************************
+* Function Name: HistRead_Init
+********************************************************************************
+*
+* Summary:
+*  This routine resets the transfer state. A cursor older than the log is
+*  moved up by the device, which shows up as lost records.
+*
+* Parameters:
+*  HISTREAD_T* reader: Transfer state
+*  uint32_t cursor: First record wanted
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+void HistRead_Init(HISTREAD_T* reader, uint32_t cursor)
+{
+    reader->next = cursor;
+    reader->received = 0u;
+    reader->lost = 0u;
+    reader->duplicate = 0u;
+    reader->done = 0u;
+}
+
+/*******************************************************************************
+* Function Name: HistRead_Start
+********************************************************************************
+*
+* Summary:
+*  This routine builds the command that starts, or after a dropped link
+*  resumes, the transfer from the resume cursor. Write it to the control
+*  point or send it as an SDU on the channel.
+*
+* Parameters:
+*  HISTREAD_T* reader: Transfer state
+*  uint8_t* command: Destination, HISTFMT_CONTROL_WRITE_LEN bytes
+*
+* Return:
+*  uint8_t: Command length
+*
+*******************************************************************************/
+uint8_t HistRead_Start(HISTREAD_T* reader, uint8_t* command)
+{
+    reader->done = 0u;
+
+    command[0] = HISTFMT_OP_START;
+    command[1] = (uint8_t)reader->next;
+    command[2] = (uint8_t)(reader->next >> 8);
+    command[3] = (uint8_t)(reader->next >> 16);
+    command[4] = (uint8_t)(reader->next >> 24);
+    return HISTFMT_CONTROL_WRITE_LEN;
+}
+
+/*******************************************************************************
+* Function Name: HistRead_Stop
+********************************************************************************
+*
+* Summary:
+*  This routine builds the command that stops the transfer.
+*
+* Parameters:
+*  uint8_t* command: Destination, HISTFMT_CONTROL_WRITE_LEN bytes
+*
+* Return:
+*  uint8_t: Command length
+*
+*******************************************************************************/
+uint8_t HistRead_Stop(uint8_t* command)
+{
+    command[0] = HISTFMT_OP_STOP;
+    command[1] = 0u;
+    command[2] = 0u;
+    command[3] = 0u;
+    command[4] = 0u;
+    return HISTFMT_CONTROL_WRITE_LEN;
+}
+
+/*******************************************************************************
+* Function Name: HistRead_Packet
+********************************************************************************
+*
+* Summary:
+*  This routine takes one data packet. A packet starting past the resume
+*  cursor means the device skipped overwritten records, a packet starting
+*  before it repeats records already taken, e.g. one resent after a
+*  reconnect. Only records not seen before are returned, each stamped from
+*  the packet time and the record deltas.
+*
+* Parameters:
+*  HISTREAD_T* reader: Transfer state
+*  const uint8_t* packet: Notification value or SDU
+*  uint16_t len: Packet length
+*  HISTREAD_RECORD_T* records: Destination
+*  uint16_t maxRecords: Size of the destination, the largest packet holds
+*                       (len - HISTFMT_PACKET_HEADER_LEN) / HISTFMT_RECORD_LEN
+*
+* Return:
+*  int: Number of new records, HISTREAD_TRUNCATED
+*
+*******************************************************************************/
+int HistRead_Packet(HISTREAD_T* reader, const uint8_t* packet, uint16_t len,
+                    HISTREAD_RECORD_T* records, uint16_t maxRecords)
+{
+    uint32_t index;
+    uint32_t time;
+    uint16_t count;
+    uint16_t i;
+    int n = 0;
+
+    if ((len < HISTFMT_PACKET_HEADER_LEN) ||
+        (((len - HISTFMT_PACKET_HEADER_LEN) % HISTFMT_RECORD_LEN) != 0u)) {
+        return HISTREAD_TRUNCATED;
+    }
+
+    index = GET_LE32(packet);
+    time = GET_LE32(&packet[HISTFMT_PACKET_TIME_OFFSET]);
+    count = (uint16_t)((len - HISTFMT_PACKET_HEADER_LEN) / HISTFMT_RECORD_LEN);
+    packet += HISTFMT_PACKET_HEADER_LEN;
+
+    if (index > reader->next) {
+        reader->lost += index - reader->next;
+        reader->next = index;
+    }
+
+    if (count == 0u) {
+        reader->done = 1u;
+        return 0;
+    }
+
+    for (i = 0u; i < count; i++, index++, packet += HISTFMT_RECORD_LEN) {
+        HISTREAD_RECORD_T* record;
+
+        if (i != 0u) {
+            time += GET_LE16(&packet[HISTFMT_DELTA_OFFSET]);
+        }
+        if (index < reader->next) {
+            reader->duplicate++;
+            continue;
+        }
+        if ((uint16_t)n >= maxRecords) {
+            break;
+        }
+
+        record = &records[n++];
+        record->index = index;
+        record->time = time;
+        record->temperatureX10 = (int16_t)GET_LE16(&packet[HISTFMT_TEMPERATURE_OFFSET]);
+        record->humidityX10 = GET_LE16(&packet[HISTFMT_HUMIDITY_OFFSET]);
+        record->valid = (record->temperatureX10 != HISTFMT_TEMPERATURE_NO_DATA) ||
+                        (record->humidityX10 != HISTFMT_HUMIDITY_NO_DATA);
+        reader->next = index + 1u;
+    }
+
+    reader->received += (uint32_t)n;
+    return n;
+}
+
+/*******************************************************************************
+* Function Name: HistRead_Batch
+********************************************************************************
+*
+* Summary:
+*  This routine unpacks a batch notification, turning the entry deltas back
+*  into timestamps.
+*
+* Parameters:
+*  const uint8_t* packet: Notification value
+*  uint16_t len: Notification length
+*  HISTREAD_BATCH_T* entries: Destination
+*  uint16_t maxEntries: Size of the destination
+*
+* Return:
+*  int: Number of entries, HISTREAD_TRUNCATED
+*
+*******************************************************************************/
+int HistRead_Batch(const uint8_t* packet, uint16_t len,
+                   HISTREAD_BATCH_T* entries, uint16_t maxEntries)
+{
+    uint32_t time;
+    uint32_t flag;
+    uint32_t quarters = 0u;
+    uint16_t count;
+    uint16_t i;
+
+    if ((len < HISTFMT_BATCH_HEADER_LEN) ||
+        (((len - HISTFMT_BATCH_HEADER_LEN) % HISTFMT_BATCH_ENTRY_LEN) != 0u)) {
+        return HISTREAD_TRUNCATED;
+    }
+
+    time = GET_LE32(packet);
+    flag = time & HISTFMT_TIME_UNSYNCED;
+    time &= ~HISTFMT_TIME_UNSYNCED;
+    count = (uint16_t)((len - HISTFMT_BATCH_HEADER_LEN) / HISTFMT_BATCH_ENTRY_LEN);
+    packet += HISTFMT_BATCH_HEADER_LEN;
+    if (count > maxEntries) {
+        count = maxEntries;
+    }
+
+    for (i = 0u; i < count; i++, packet += HISTFMT_BATCH_ENTRY_LEN) {
+        HISTREAD_BATCH_T* entry = &entries[i];
+
+        quarters += packet[HISTFMT_BATCH_DELTA_OFFSET];
+        entry->time = (time + (quarters * HISTFMT_BATCH_TIME_UNIT_MS) / 1000u) | flag;
+        entry->timeMs = (uint16_t)((quarters * HISTFMT_BATCH_TIME_UNIT_MS) % 1000u);
+        entry->temperatureX10 = (int16_t)GET_LE16(&packet[HISTFMT_BATCH_TEMPERATURE_OFFSET]);
+        entry->humidityX10 = GET_LE16(&packet[HISTFMT_BATCH_HUMIDITY_OFFSET]);
+        entry->valid = (entry->temperatureX10 != HISTFMT_TEMPERATURE_NO_DATA) ||
+                       (entry->humidityX10 != HISTFMT_HUMIDITY_NO_DATA);
+    }
+    return (int)count;
+}
+
+/*******************************************************************************
+* Function Name: HistRead_UnixTime
+********************************************************************************
+*
+* Summary:
+*  This routine converts a timestamp to Unix time. A timestamp taken before
+*  the device clock was set only counts from the device start and has no
+*  Unix time.
+*
+* Parameters:
+*  uint32_t time: HISTFMT timestamp
+*
+* Return:
+*  uint32_t: Seconds since 1970-01-01 UTC, 0 if not synced
+*
+*******************************************************************************/
+uint32_t HistRead_UnixTime(uint32_t time)
+{
+    if ((time & HISTFMT_TIME_UNSYNCED) != 0u) {
+        return 0u;
+    }
+    return time + HISTFMT_TIME_EPOCH_UNIX;
+}
+
+/* [] END OF FILE */
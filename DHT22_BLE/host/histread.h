@@ -0,0 +1,68 @@
+/* ========================================
+ * Filename:        histread.h
+ * Description:     Host reference reader for the history transfer header file
+ *                  Portable C99, no PSoC dependencies. The reader only sees
+ *                  HISTFMT packets, so the same code takes GATT notification
+ *                  values and L2CAP channel SDUs. Build together with
+ *                  histread.c and the firmware's histfmt.h on the include path.
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+#include <stdint.h>
+#include "histfmt.h"
+
+#ifndef __HISTREAD_H
+#define __HISTREAD_H
+
+/***************************************
+*        API Constants
+***************************************/
+#define HISTREAD_TRUNCATED                          (-1)  /* Packet shorter than its header or a partial record */
+
+/* Record taken from a data packet */
+typedef struct
+{
+    uint32_t        index;                          /* Sample number since boot */
+    uint32_t        time;                           /* HISTFMT timestamp */
+    int16_t         temperatureX10;                 /* 0.1C */
+    uint16_t        humidityX10;                    /* 0.1%RH */
+    uint8_t         valid;                          /* 0 = no valid reading for this period */
+} HISTREAD_RECORD_T;
+
+/* Reading taken from a batch notification */
+typedef struct
+{
+    uint32_t        time;                           /* HISTFMT timestamp */
+    uint16_t        timeMs;                         /* Milliseconds into that second */
+    int16_t         temperatureX10;                 /* 0.1C */
+    uint16_t        humidityX10;                    /* 0.1%RH */
+    uint8_t         valid;                          /* 0 = no valid reading */
+} HISTREAD_BATCH_T;
+
+/* Transfer state, kept across connections to resume */
+typedef struct
+{
+    uint32_t        next;                           /* Next record wanted, the resume cursor */
+    uint32_t        received;                       /* Distinct records */
+    uint32_t        lost;                           /* Records overwritten before they were read */
+    uint32_t        duplicate;                      /* Records received twice */
+    uint8_t         done;                           /* 1 = end of log reached */
+} HISTREAD_T;
+
+/***************************************
+*        Function Prototypes
+***************************************/
+    void    HistRead_Init(HISTREAD_T* reader, uint32_t cursor);                                 // Start from a record index, 0 = everything held
+    uint8_t HistRead_Start(HISTREAD_T* reader, uint8_t* command);                               // Build the start command for the resume cursor
+    uint8_t HistRead_Stop(uint8_t* command);                                                    // Build the stop command
+    int     HistRead_Packet(HISTREAD_T* reader, const uint8_t* packet, uint16_t len,
+                            HISTREAD_RECORD_T* records, uint16_t maxRecords);                  // Take one data packet, returns the new records
+    int     HistRead_Batch(const uint8_t* packet, uint16_t len,
+                           HISTREAD_BATCH_T* entries, uint16_t maxEntries);                    // Unpack a batch notification, returns the entries
+    uint32_t HistRead_UnixTime(uint32_t time);                                                  // Unix time of a timestamp, 0 if the device clock was not set
+#endif
+
+
+
+/* [] END OF FILE */
@@ -0,0 +1,421 @@
+/* ========================================
+ * Filename:        histsim.c
+ * Description:     History transfer link model source file
+ *                  Runs the history transfer against a simulated device and
+ *                  link, once over GATT notifications and once over the
+ *                  L2CAP channel, and feeds every packet to the reference
+ *                  reader. The link is modelled at LL PDU level: 27-byte
+ *                  PDUs, a fixed number of PDUs per connection event and
+ *                  channel credits returned once per event. It compares
+ *                  the framing overhead of the two paths; it is not a
+ *                  measurement of the radio.
+ *
+ *                  cc -std=c99 -I. -I../WS_DHT22_BLE/DHT22_BLE.cydsn histsim.c histread.c
+ *                  ./a.out [PDUs per event] [interval x 1.25 ms] [credits]
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+
+#include "histread.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/***************************************
+*        API Constants
+***************************************/
+#define HISTSIM_LL_PAYLOAD                          (27u)    /* LL data PDU payload without DLE */
+#define HISTSIM_L2CAP_HDR_LEN                       (4u)
+#define HISTSIM_ATT_HDR_LEN                         (3u)     /* Opcode and handle of a notification */
+#define HISTSIM_SDU_LEN_LEN                         (2u)     /* SDU length field of the first frame */
+
+/* Far deeper than HISTLOG_DEPTH so the rate is not dominated by the last,
+ * partly filled connection event */
+#define HISTSIM_DEPTH                               (4096u)
+#define HISTSIM_LOGGED                              (4196u)  /* The first 100 records are already overwritten */
+#define HISTSIM_TX_QUEUE                            (16u)    /* LL PDUs the stack holds for transmission */
+#define HISTSIM_MAX_PACKET                          (262u)
+#define HISTSIM_DROP_EVENT                          (6u)     /* The link drops once, mid-transfer */
+#define HISTSIM_PERIOD_S                            (10u)    /* Sensor period of the logged records */
+
+#define HISTSIM_DEFAULT_PDUS                        (4u)
+#define HISTSIM_DEFAULT_INTERVAL                    (6u)
+#define HISTSIM_DEFAULT_CREDITS                     (10u)
+
+/* Transport under test */
+typedef struct
+{
+    const char*     name;
+    uint16_t        packetLen;                      /* ATT MTU - 3, or the SDU size */
+    uint16_t        mps;                            /* 0 = GATT notification */
+} HISTSIM_PATH_T;
+
+/* Packet in the device transmit queue */
+typedef struct
+{
+    uint8_t         data[HISTSIM_MAX_PACKET];
+    uint16_t        len;
+    uint16_t        pdus;                           /* LL PDUs still to send */
+    uint16_t        frames;                         /* K-frames, 0 for GATT */
+} HISTSIM_PACKET_T;
+
+/* Device side: the log and the transfer state of the firmware */
+typedef struct
+{
+    int16_t         temperatureX10[HISTSIM_DEPTH];
+    uint16_t        humidityX10[HISTSIM_DEPTH];
+    uint32_t        next;
+    uint32_t        cursor;
+    uint8_t         active;
+    uint16_t        credits;
+    HISTSIM_PACKET_T queue[HISTSIM_TX_QUEUE];
+    uint16_t        queued;                         /* Packets in the queue */
+    uint16_t        queuedPdus;
+} HISTSIM_DEVICE_T;
+
+/* Result of one run */
+typedef struct
+{
+    uint32_t        events;
+    uint32_t        pdus;
+    uint32_t        timeUs;
+    uint32_t        recordBytes;
+} HISTSIM_RESULT_T;
+
+static const HISTSIM_PATH_T histSimPaths[] =
+{
+    { "GATT notify, ATT MTU 23",        20u,    0u },
+    { "GATT notify, ATT MTU 131",       128u,   0u },
+    { "L2CAP CoC, SDU 131, MPS 131",    131u,   131u },
+    { "L2CAP CoC, SDU 262, MPS 131",    262u,   131u },
+};
+
+/*******************************************************************************
+* Function Name: HistSim_DeviceInit
+********************************************************************************
+*
+* Summary:
+*  This routine fills the simulated log. Every tenth period has no reading.
+*
+* Parameters:
+*  HISTSIM_DEVICE_T* device: Simulated device
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void HistSim_DeviceInit(HISTSIM_DEVICE_T* device)
+{
+    uint32_t i;
+
+    memset(device, 0, sizeof(*device));
+    for (i = 0u; i < HISTSIM_LOGGED; i++) {
+        if ((i % 10u) == 9u) {
+            device->temperatureX10[i % HISTSIM_DEPTH] = HISTFMT_TEMPERATURE_NO_DATA;
+            device->humidityX10[i % HISTSIM_DEPTH] = HISTFMT_HUMIDITY_NO_DATA;
+        } else {
+            device->temperatureX10[i % HISTSIM_DEPTH] = (int16_t)(200 + (int32_t)(i % 50u));
+            device->humidityX10[i % HISTSIM_DEPTH] = (uint16_t)(450u + (i % 100u));
+        }
+    }
+    device->next = HISTSIM_LOGGED;
+}
+
+/*******************************************************************************
+* Function Name: HistSim_ReadPacket
+********************************************************************************
+*
+* Summary:
+*  This routine builds a data packet the way HistLog_ReadPacket() does.
+*
+* Parameters:
+*  HISTSIM_DEVICE_T* device: Simulated device
+*  uint8_t* packet: Destination
+*  uint16_t packetLen: Size of the destination
+*
+* Return:
+*  uint16_t: Packet length
+*
+*******************************************************************************/
+static uint16_t HistSim_ReadPacket(HISTSIM_DEVICE_T* device, uint8_t* packet, uint16_t packetLen)
+{
+    uint32_t first = (device->next > HISTSIM_DEPTH) ? (device->next - HISTSIM_DEPTH) : 0u;
+    uint16_t len = HISTFMT_PACKET_HEADER_LEN;
+    uint32_t time;
+
+    if (device->cursor < first) {
+        device->cursor = first;
+    }
+    time = HISTFMT_TIME_UNSYNCED | (device->cursor * HISTSIM_PERIOD_S);
+
+    packet[0] = (uint8_t)device->cursor;
+    packet[1] = (uint8_t)(device->cursor >> 8);
+    packet[2] = (uint8_t)(device->cursor >> 16);
+    packet[3] = (uint8_t)(device->cursor >> 24);
+    packet[HISTFMT_PACKET_TIME_OFFSET] = (uint8_t)time;
+    packet[HISTFMT_PACKET_TIME_OFFSET + 1u] = (uint8_t)(time >> 8);
+    packet[HISTFMT_PACKET_TIME_OFFSET + 2u] = (uint8_t)(time >> 16);
+    packet[HISTFMT_PACKET_TIME_OFFSET + 3u] = (uint8_t)(time >> 24);
+
+    while ((len + HISTFMT_RECORD_LEN <= packetLen) && (device->cursor < device->next)) {
+        uint16_t t = (uint16_t)device->temperatureX10[device->cursor % HISTSIM_DEPTH];
+        uint16_t h = device->humidityX10[device->cursor % HISTSIM_DEPTH];
+
+        packet[len + HISTFMT_TEMPERATURE_OFFSET] = (uint8_t)t;
+        packet[len + HISTFMT_TEMPERATURE_OFFSET + 1u] = (uint8_t)(t >> 8);
+        packet[len + HISTFMT_HUMIDITY_OFFSET] = (uint8_t)h;
+        packet[len + HISTFMT_HUMIDITY_OFFSET + 1u] = (uint8_t)(h >> 8);
+        packet[len + HISTFMT_DELTA_OFFSET] = (device->cursor == 0u) ? 0u : HISTSIM_PERIOD_S;
+        packet[len + HISTFMT_DELTA_OFFSET + 1u] = 0u;
+        len += HISTFMT_RECORD_LEN;
+        device->cursor++;
+    }
+    return len;
+}
+
+/*******************************************************************************
+* Function Name: HistSim_Frame
+********************************************************************************
+*
+* Summary:
+*  This routine works out how a packet goes on air. A notification is one
+*  L2CAP frame with the ATT header. An SDU is split into K-frames of at most
+*  MPS bytes, the first one also carrying the SDU length. Every L2CAP frame
+*  is split into LL PDUs.
+*
+* Parameters:
+*  const HISTSIM_PATH_T* path: Transport
+*  HISTSIM_PACKET_T* packet: Packet, len set
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void HistSim_Frame(const HISTSIM_PATH_T* path, HISTSIM_PACKET_T* packet)
+{
+    uint32_t remaining;
+
+    if (path->mps == 0u) {
+        packet->frames = 0u;
+        packet->pdus = (uint16_t)((HISTSIM_L2CAP_HDR_LEN + HISTSIM_ATT_HDR_LEN + packet->len +
+                                   HISTSIM_LL_PAYLOAD - 1u) / HISTSIM_LL_PAYLOAD);
+        return;
+    }
+
+    packet->frames = 0u;
+    packet->pdus = 0u;
+    remaining = HISTSIM_SDU_LEN_LEN + packet->len;
+    while (remaining > 0u) {
+        uint32_t payload = (remaining > path->mps) ? path->mps : remaining;
+
+        packet->frames++;
+        packet->pdus += (uint16_t)((HISTSIM_L2CAP_HDR_LEN + payload + HISTSIM_LL_PAYLOAD - 1u) / HISTSIM_LL_PAYLOAD);
+        remaining -= payload;
+    }
+}
+
+/*******************************************************************************
+* Function Name: HistSim_Fill
+********************************************************************************
+*
+* Summary:
+*  This routine is the firmware main loop between two PDUs. Notifications
+*  are queued while the stack has room. The channel keeps one SDU in
+*  flight, shrunk to the frames there are credits for, as LogCoc_Process()
+*  does.
+*
+* Parameters:
+*  const HISTSIM_PATH_T* path: Transport
+*  HISTSIM_DEVICE_T* device: Simulated device
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void HistSim_Fill(const HISTSIM_PATH_T* path, HISTSIM_DEVICE_T* device)
+{
+    while ((device->active != 0u) && (device->queued < HISTSIM_TX_QUEUE)) {
+        HISTSIM_PACKET_T* packet = &device->queue[device->queued];
+        uint32_t cursor = device->cursor;
+        uint32_t packetLen = path->packetLen;
+
+        if (path->mps != 0u) {
+            if ((device->queued != 0u) || (device->credits == 0u)) {
+                return;
+            }
+            if ((uint32_t)device->credits * path->mps - HISTSIM_SDU_LEN_LEN < packetLen) {
+                packetLen = (uint32_t)device->credits * path->mps - HISTSIM_SDU_LEN_LEN;
+            }
+        }
+
+        packet->len = HistSim_ReadPacket(device, packet->data, (uint16_t)packetLen);
+        HistSim_Frame(path, packet);
+
+        if (device->queuedPdus + packet->pdus > HISTSIM_TX_QUEUE) {
+            device->cursor = cursor;
+            return;
+        }
+
+        device->credits -= packet->frames;
+        device->queuedPdus += packet->pdus;
+        device->queued++;
+        if (packet->len == HISTFMT_PACKET_HEADER_LEN) {
+            device->active = 0u;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: HistSim_Run
+********************************************************************************
+*
+* Summary:
+*  This routine runs one complete transfer, including one dropped link and
+*  a resume from the reader's cursor, and checks every record arrived once.
+*
+* Parameters:
+*  const HISTSIM_PATH_T* path: Transport
+*  uint16_t pdusPerEvent: LL PDUs the devices exchange per connection event
+*  uint16_t interval: Connection interval, 1.25 ms units
+*  uint16_t credits: Credits the reader grants for the channel
+*  HISTSIM_RESULT_T* result: Destination
+*
+* Return:
+*  int: 0 = every record held was received exactly once
+*
+*******************************************************************************/
+static int HistSim_Run(const HISTSIM_PATH_T* path, uint16_t pdusPerEvent, uint16_t interval,
+                       uint16_t credits, HISTSIM_RESULT_T* result)
+{
+    static HISTSIM_DEVICE_T device;
+    HISTREAD_T reader;
+    HISTREAD_RECORD_T records[HISTSIM_MAX_PACKET / HISTFMT_RECORD_LEN];
+    uint8_t command[HISTFMT_CONTROL_WRITE_LEN];
+    uint8_t connected = 0u;
+    uint32_t expected;
+
+    HistSim_DeviceInit(&device);
+    HistRead_Init(&reader, 0u);
+    memset(result, 0, sizeof(*result));
+
+    while (reader.done == 0u) {
+        uint16_t sent = 0u;
+        uint16_t returned = 0u;
+
+        if (connected == 0u) {
+            /* Connect and write the start command with the resume cursor */
+            (void)HistRead_Start(&reader, command);
+            device.cursor = (uint32_t)command[1] | ((uint32_t)command[2] << 8) |
+                            ((uint32_t)command[3] << 16) | ((uint32_t)command[4] << 24);
+            device.active = (command[0] == HISTFMT_OP_START) ? 1u : 0u;
+            device.credits = (path->mps != 0u) ? credits : 0u;
+            device.queued = 0u;
+            device.queuedPdus = 0u;
+            connected = 1u;
+        }
+
+        while ((sent < pdusPerEvent) && (reader.done == 0u)) {
+            HISTSIM_PACKET_T* packet = &device.queue[0];
+            int n;
+
+            HistSim_Fill(path, &device);
+            if (device.queued == 0u) {
+                break;
+            }
+
+            packet->pdus--;
+            device.queuedPdus--;
+            sent++;
+            if (packet->pdus != 0u) {
+                continue;
+            }
+
+            /* Last PDU of the packet, the reader takes it */
+            n = HistRead_Packet(&reader, packet->data, packet->len, records,
+                                (uint16_t)(sizeof(records) / sizeof(records[0])));
+            if (n < 0) {
+                return -1;
+            }
+            result->recordBytes += (uint32_t)n * HISTFMT_RECORD_LEN;
+            returned += packet->frames;
+            device.queued--;
+            memmove(&device.queue[0], &device.queue[1], device.queued * sizeof(device.queue[0]));
+        }
+
+        /* The reader hands back the credits it used once per event */
+        device.credits += returned;
+        result->events++;
+        result->pdus += sent;
+        result->timeUs += interval * 1250u;
+
+        if (result->events == HISTSIM_DROP_EVENT) {
+            /* Queued packets are lost with the link. The reconnect is left
+             * out of the time, it costs the same on both paths. */
+            connected = 0u;
+        }
+    }
+
+    expected = (HISTSIM_LOGGED > HISTSIM_DEPTH) ? HISTSIM_DEPTH : HISTSIM_LOGGED;
+    return ((reader.received == expected) && (reader.duplicate == 0u) &&
+            (reader.lost == HISTSIM_LOGGED - expected)) ? 0 : -1;
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+*
+* Summary:
+*  This routine runs the model for every transport and prints the record
+*  throughput and the record bytes carried per LL PDU.
+*
+* Parameters:
+*  int argc, char** argv: Optional PDUs per event, interval, credits
+*
+* Return:
+*  int: 0 = all transfers complete and consistent
+*
+*******************************************************************************/
+int main(int argc, char** argv)
+{
+    uint16_t pdusPerEvent = HISTSIM_DEFAULT_PDUS;
+    uint16_t interval = HISTSIM_DEFAULT_INTERVAL;
+    uint16_t credits = HISTSIM_DEFAULT_CREDITS;
+    int status = 0;
+    size_t i;
+
+    if (argc > 1) {
+        pdusPerEvent = (uint16_t)atoi(argv[1]);
+    }
+    if (argc > 2) {
+        interval = (uint16_t)atoi(argv[2]);
+    }
+    if (argc > 3) {
+        credits = (uint16_t)atoi(argv[3]);
+    }
+    if ((pdusPerEvent == 0u) || (interval == 0u) || (credits == 0u)) {
+        fprintf(stderr, "usage: %s [PDUs per event] [interval x 1.25 ms] [credits]\n", argv[0]);
+        return 2;
+    }
+
+    printf("%u PDUs/event, %u.%02u ms interval, %u credits, %u records\n\n",
+           pdusPerEvent, (interval * 125u) / 100u, (interval * 125u) % 100u, credits, HISTSIM_DEPTH);
+    printf("%-30s %7s %7s %9s %10s\n", "path", "events", "PDUs", "B/PDU", "rec B/s");
+
+    for (i = 0u; i < sizeof(histSimPaths) / sizeof(histSimPaths[0]); i++) {
+        HISTSIM_RESULT_T result;
+        int ok = HistSim_Run(&histSimPaths[i], pdusPerEvent, interval, credits, &result);
+
+        printf("%-30s %7lu %7lu %9.2f %10.0f%s\n", histSimPaths[i].name,
+               (unsigned long)result.events, (unsigned long)result.pdus,
+               (double)result.recordBytes / (double)result.pdus,
+               (double)result.recordBytes * 1000000.0 / (double)result.timeUs,
+               (ok == 0) ? "" : "  INCONSISTENT");
+        if (ok != 0) {
+            status = 1;
+        }
+    }
+    return status;
+}
+
+/* [] END OF FILE */
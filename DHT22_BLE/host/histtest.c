@@ -0,0 +1,358 @@
+/* ========================================
+ * Filename:        histtest.c
+ * Description:     ADV history reconstruction test source file
+ *                  Runs a simulated node through the firmware's advenc_mfr.c
+ *                  and feeds the payloads that survive a lossy channel to
+ *                  AdvDecode_History and AdvDecode_Track, the way a gateway
+ *                  would. The run crosses the 16-bit sequence wrap, drops
+ *                  single packets, a burst the history covers and a burst
+ *                  it does not, repeats a packet, and has failed reads. The
+ *                  rebuilt series must be gapless except for the samples
+ *                  counted as lost, and match what the node measured.
+ *
+ *                  cc -std=c99 -I. -Ifwstub -I../WS_DHT22_BLE/DHT22_BLE.cydsn \
+ *                     histtest.c advdecode.c aes128.c ../WS_DHT22_BLE/DHT22_BLE.cydsn/advenc_mfr.c
+ *                  ./a.out
+ * Author:          techdude101
+ * Version:         0.1.0
+ * ========================================
+*/
+
+#include "advdecode.h"
+#include "advenc.h"
+#include <stdio.h>
+#include <string.h>
+
+/***************************************
+*        API Constants
+***************************************/
+#define HISTTEST_SAMPLES                            (40u)
+#define HISTTEST_FIRST_SEQUENCE                     (0xFFF0u)  /* Wraps at sample 16 */
+#define HISTTEST_BOOT                               (3u)
+#define HISTTEST_DEPTH                              (5u)  /* MFR_HISTORY_DEPTH without the auth extension */
+
+/* Per sample script: delivered or not, read failed or not */
+#define HISTTEST_DROP                               (0x01u)
+#define HISTTEST_FAIL                               (0x02u)
+#define HISTTEST_REPEAT                             (0x04u)  /* Delivered twice */
+
+#define HistTest_Check(cond, what)                  HistTest_Report((cond) ? 1u : 0u, (what))
+
+/* What the node measured */
+typedef struct
+{
+    int16_t         temperatureX10;
+    uint16_t        humidityX10;
+    uint8_t         valid;
+} HISTTEST_TRUTH_T;
+
+/* What the gateway rebuilt */
+typedef struct
+{
+    int16_t         temperatureX100;
+    uint16_t        humidityX10;
+    uint8_t         valid;
+    uint8_t         stored;                         /* Number of times the gateway stored this sample */
+} HISTTEST_SERIES_T;
+
+static HISTTEST_TRUTH_T histTestTruth[HISTTEST_SAMPLES];
+static HISTTEST_SERIES_T histTestSeries[HISTTEST_SAMPLES];
+static uint32_t histTestFailures = 0u;
+
+/*******************************************************************************
+* Function Name: HistTest_Report
+********************************************************************************
+*
+* Summary:
+*  This routine counts and reports a failed check.
+*
+* Parameters:
+*  uint8_t passed: 1 = the check passed
+*  const char* what: Check description
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void HistTest_Report(uint8_t passed, const char* what)
+{
+    if (passed == 0u) {
+        printf("FAIL: %s\n", what);
+        histTestFailures++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: HistTest_Script
+********************************************************************************
+*
+* Summary:
+*  This routine returns what happens to a sample.
+*
+* Parameters:
+*  uint8_t index: Sample index since HISTTEST_FIRST_SEQUENCE
+*
+* Return:
+*  uint8_t: HISTTEST_x
+*
+*******************************************************************************/
+static uint8_t HistTest_Script(uint8_t index)
+{
+    uint8_t script = 0u;
+
+    /* One lost packet, a burst across the wrap, a burst longer than the history */
+    if ((index == 3u) || ((index >= 14u) && (index <= 18u)) || ((index >= 24u) && (index <= 31u))) {
+        script |= HISTTEST_DROP;
+    }
+    /* Failed reads delivered live, only seen in a history, and in a backfill */
+    if ((index == 5u) || (index == 15u) || (index == 16u) || (index == 28u) || (index == 29u)) {
+        script |= HISTTEST_FAIL;
+    }
+    if (index == 8u) {
+        script |= HISTTEST_REPEAT;
+    }
+    return script;
+}
+
+/*******************************************************************************
+* Function Name: HistTest_Store
+********************************************************************************
+*
+* Summary:
+*  This routine stores one rebuilt sample in the series.
+*
+* Parameters:
+*  uint16_t sequence: Sample sequence number
+*  int16_t temperatureX100: Temperature in 0.01C
+*  uint16_t humidityX10: Humidity in 0.1%RH
+*  uint8_t valid: 0 = no valid reading for this sequence
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void HistTest_Store(uint16_t sequence, int16_t temperatureX100, uint16_t humidityX10, uint8_t valid)
+{
+    uint16_t index = (uint16_t)(sequence - HISTTEST_FIRST_SEQUENCE);
+
+    if (index >= HISTTEST_SAMPLES) {
+        HistTest_Check(0, "stored sequence outside the run");
+        return;
+    }
+    histTestSeries[index].temperatureX100 = temperatureX100;
+    histTestSeries[index].humidityX10 = humidityX10;
+    histTestSeries[index].valid = valid;
+    histTestSeries[index].stored++;
+}
+
+/*******************************************************************************
+* Function Name: HistTest_Receive
+********************************************************************************
+*
+* Summary:
+*  This routine decodes one ADV payload as a gateway would: drop repeats,
+*  backfill the missed samples from the history, oldest first, then store the
+*  reading.
+*
+* Parameters:
+*  const CYBLE_GAPP_DISC_DATA_T* adv: ADV data as received
+*  ADVDECODE_TRACKER_T* tracker: Tracker of the node
+*
+* Return:
+*  int: AdvDecode_Track() result
+*
+*******************************************************************************/
+static int HistTest_Receive(const CYBLE_GAPP_DISC_DATA_T* adv, ADVDECODE_TRACKER_T* tracker)
+{
+    ADVDECODE_READING_T reading;
+    ADVDECODE_SAMPLE_T history[ADVDECODE_MAX_HISTORY];
+    const uint8_t* data;
+    uint8_t len;
+    uint16_t bootCount;
+    uint16_t sequence;
+    int count;
+    int backfill;
+
+    if ((AdvDecode_FindManufacturerData(adv->advData, adv->advDataLen, &data, &len) != ADVDECODE_OK) ||
+        (AdvDecode_Reading(data, len, &reading) != ADVDECODE_OK) ||
+        (AdvDecode_Sequence(&reading, &bootCount, &sequence) != ADVDECODE_OK)) {
+        HistTest_Check(0, "payload decodes");
+        return -1;
+    }
+
+    count = AdvDecode_History(&reading, history, ADVDECODE_MAX_HISTORY);
+    HistTest_Check(count == (int)HISTTEST_DEPTH, "history depth");
+    backfill = AdvDecode_Track(tracker, bootCount, sequence, (count > 0) ? (uint8_t)count : 0u);
+
+    for (int i = backfill - 1; i >= 0; i--) {
+        HistTest_Check(history[i].sequence == (uint16_t)(sequence - 1u - (uint16_t)i), "history sequence");
+        HistTest_Store(history[i].sequence, history[i].temperatureX100, history[i].humidityX10, history[i].valid);
+    }
+    if (backfill >= 0) {
+        HistTest_Store(sequence, reading.temperatureX100, reading.humidityX10, (reading.flags == 0u) ? 1u : 0u);
+    }
+    return backfill;
+}
+
+/*******************************************************************************
+* Function Name: HistTest_Series
+********************************************************************************
+*
+* Summary:
+*  This routine runs the scripted node and checks the rebuilt series.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void HistTest_Series(void)
+{
+    CYBLE_GAPP_DISC_DATA_T adv;
+    ADVDECODE_TRACKER_T tracker;
+    ADV_SAMPLE_T sample;
+    char what[64];
+    uint8_t i;
+
+    (void)memset(&tracker, 0, sizeof(tracker));
+    (void)memset(&sample, 0, sizeof(sample));
+    sample.bootCount = HISTTEST_BOOT;
+    AdvEnc_Init(&adv);
+
+    for (i = 0u; i < HISTTEST_SAMPLES; i++) {
+        uint8_t script = HistTest_Script(i);
+
+        /* As main.c: a failed read advertises the last valid reading */
+        sample.sampleCount = HISTTEST_FIRST_SEQUENCE + i;
+        if ((script & HISTTEST_FAIL) != 0u) {
+            sample.status = ADVFMT_FLAG_SENSOR_ERROR;
+            histTestTruth[i].valid = 0u;
+        } else {
+            sample.temperatureX10 = (int16_t)(-35 + (int16_t)((i * 7u) % 23u));
+            sample.humidityX10 = (uint16_t)(480u + (i * 13u) % 41u);
+            sample.status = 0u;
+            histTestTruth[i].temperatureX10 = sample.temperatureX10;
+            histTestTruth[i].humidityX10 = sample.humidityX10;
+            histTestTruth[i].valid = 1u;
+        }
+        AdvEnc_Encode(&adv, &sample);
+
+        if ((script & HISTTEST_DROP) == 0u) {
+            (void)snprintf(what, sizeof(what), "sample %u is new", i);
+            HistTest_Check(HistTest_Receive(&adv, &tracker) >= 0, what);
+        }
+        if ((script & HISTTEST_REPEAT) != 0u) {
+            (void)snprintf(what, sizeof(what), "sample %u repeat dropped", i);
+            HistTest_Check(HistTest_Receive(&adv, &tracker) == -1, what);
+        }
+    }
+
+    /* Samples 24 to 26 are beyond the history of sample 32 */
+    for (i = 0u; i < HISTTEST_SAMPLES; i++) {
+        const HISTTEST_SERIES_T* rebuilt = &histTestSeries[i];
+        uint8_t lost = ((i >= 24u) && (i <= 26u)) ? 1u : 0u;
+
+        (void)snprintf(what, sizeof(what), "sample %u stored once", i);
+        HistTest_Check(rebuilt->stored == ((lost != 0u) ? 0u : 1u), what);
+        if (lost != 0u) {
+            continue;
+        }
+        (void)snprintf(what, sizeof(what), "sample %u validity", i);
+        HistTest_Check(rebuilt->valid == histTestTruth[i].valid, what);
+        if (histTestTruth[i].valid != 0u) {
+            (void)snprintf(what, sizeof(what), "sample %u temperature", i);
+            HistTest_Check(rebuilt->temperatureX100 == histTestTruth[i].temperatureX10 * 10, what);
+            (void)snprintf(what, sizeof(what), "sample %u humidity", i);
+            HistTest_Check(rebuilt->humidityX10 == histTestTruth[i].humidityX10, what);
+        }
+    }
+
+    HistTest_Check(tracker.received == HISTTEST_SAMPLES - 3u, "received count");
+    HistTest_Check(tracker.lost == 3u, "lost count");
+}
+
+/*******************************************************************************
+* Function Name: HistTest_Missing
+********************************************************************************
+*
+* Summary:
+*  This routine checks the other ways a history entry is missing: a delta
+*  out of the int8 range, and every entry of a reading without data.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  None
+*
+*******************************************************************************/
+static void HistTest_Missing(void)
+{
+    CYBLE_GAPP_DISC_DATA_T adv;
+    ADV_SAMPLE_T sample;
+    ADVDECODE_READING_T reading;
+    ADVDECODE_SAMPLE_T history[ADVDECODE_MAX_HISTORY];
+    const uint8_t* data;
+    uint8_t len;
+    int count;
+
+    (void)memset(&sample, 0, sizeof(sample));
+    sample.bootCount = HISTTEST_BOOT + 1u;
+    AdvEnc_Init(&adv);
+
+    /* 12.7C is the largest step the history can carry */
+    sample.temperatureX10 = 200;
+    sample.humidityX10 = 500u;
+    sample.sampleCount = 1u;
+    AdvEnc_Encode(&adv, &sample);
+    sample.temperatureX10 = 327;
+    sample.sampleCount = 2u;
+    AdvEnc_Encode(&adv, &sample);
+    sample.temperatureX10 = 454;
+    sample.sampleCount = 3u;
+    AdvEnc_Encode(&adv, &sample);
+
+    (void)AdvDecode_FindManufacturerData(adv.advData, adv.advDataLen, &data, &len);
+    (void)AdvDecode_Reading(data, len, &reading);
+    count = AdvDecode_History(&reading, history, ADVDECODE_MAX_HISTORY);
+    HistTest_Check(count > 1, "history present");
+    HistTest_Check((history[0].valid != 0u) && (history[0].temperatureX100 == 3270), "delta of 127 kept");
+    HistTest_Check(history[1].valid == 0u, "delta of 255 missing");
+    HistTest_Check(data[ADVFMT_EXT_OFFSET + ADVFMT_EXT_HEADER_LEN + ADVFMT_EXT_SEQUENCE_LEN + ADVFMT_EXT_HEADER_LEN + 2u] ==
+                   ADVFMT_HISTORY_MISSING, "delta of 255 encoded as missing");
+
+    /* Nothing to take deltas against */
+    sample.status = ADVFMT_FLAG_NO_DATA;
+    sample.sampleCount = 4u;
+    AdvEnc_Encode(&adv, &sample);
+    (void)AdvDecode_Reading(data, len, &reading);
+    count = AdvDecode_History(&reading, history, ADVDECODE_MAX_HISTORY);
+    HistTest_Check((count > 0) && (history[0].valid == 0u) && (history[1].valid == 0u), "no data reading has no history");
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+*
+* Summary:
+*  This routine runs the checks.
+*
+* Parameters:
+*  None
+*
+* Return:
+*  int: 0 = every check passed, 1 = a failure
+*
+*******************************************************************************/
+int main(void)
+{
+    HistTest_Series();
+    HistTest_Missing();
+
+    printf("%lu failures\n", (unsigned long)histTestFailures);
+    return (histTestFailures == 0u) ? 0 : 1;
+}
+
+/* [] END OF FILE */